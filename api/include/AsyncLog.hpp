@@ -0,0 +1,199 @@
+/***************************************************************************//**
+ * @file	AsyncLog.hpp
+ * @brief	Header file of the asynchronous back-end of the log
+ *
+ * This header file contains all the required definitions and function prototypes
+ * through which UserInterface::Log hands its records to a background thread
+ *
+ * @author	Thibaud Talon
+ * @date	18/10/2026
+ *******************************************************************************/
+
+#ifndef ASYNC_LOG_H
+#define ASYNC_LOG_H
+
+#include <stdio.h>
+#include <stdarg.h>
+#include <time.h>
+#include <stdint.h>
+#include <map>
+
+namespace UserInterface {
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Parameters
+ ******************************************************************************/
+#define LOG_RING_SIZE 1024 // Records per thread (power of 2)
+#define LOG_ARGS_SIZE 208 // Bytes of packed arguments per record
+#define LOG_PERIOD_MS 20 // Period of the background thread
+#define LOG_BUFFER_SIZE 65536 // Bytes written to the file at once by the text sink
+#define LOG_MESSAGE_SIZE 4096 // Largest formatted message
+
+#define LOG_LEVEL_DEBUG 0 // Steps of the functions and success of each call
+#define LOG_LEVEL_INFO 1 // Results (printf)
+#define LOG_LEVEL_WARNING 2 // Warnings
+#define LOG_LEVEL_ERROR 3 // Errors
+#define LOG_LEVEL_NONE 4 // Nothing
+
+#ifndef LOG_COMPILED_LEVEL
+#define LOG_COMPILED_LEVEL LOG_LEVEL_DEBUG // Lowest level compiled in (make LOG_LEVEL=...)
+#endif
+
+enum Log_Kind{
+    LOG_PRINTF = 0, // Format and packed arguments
+    LOG_ERROR, // Error text (copied) and error code
+    LOG_SUCCESS, // Success code
+};
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Record of one call to the log
+ *
+ * Nothing is formatted on the calling thread: the arguments of printf are
+ * copied as they are (integers and pointers as 64 bits, floating points as
+ * double, strings by value), the format and the name are kept as pointers
+ * (they are string literals).
+ ******************************************************************************/
+struct Log_Record{
+    struct timespec time; // CLOCK_REALTIME when the record was opened (date of the line)
+    struct timespec order; // CLOCK_MONOTONIC when the record was opened (order of the records)
+    const char * name; // Name of the function (string literal)
+    const char * fmt; // Format (string literal, LOG_PRINTF only)
+    int increment; // Increment of the log of the function
+    int level; // LOG_LEVEL_*
+    int kind; // Log_Kind
+    int code; // Error code (LOG_ERROR, LOG_SUCCESS)
+    int Nbytes; // Bytes used in args
+    char args[LOG_ARGS_SIZE]; // Packed arguments (LOG_PRINTF) or error text (LOG_ERROR)
+};
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Destination of the records (called from the background thread only)
+ ******************************************************************************/
+class Log_Sink{
+public:
+    virtual ~Log_Sink(void) {}
+    virtual void write(const Log_Record * records, int N) = 0; // Write a batch of records (sorted by time)
+    virtual void writeText(const char * text) = 0; // Write text already formatted
+    virtual void flush(void) {} // Push the buffered bytes to the file
+};
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Sink writing the usual tab-separated text lines
+ *
+ * The date of a line is the CLOCK_REALTIME of its record, so a step of the
+ * wall clock (NTP, RTC or GPS setting the time) shows at once, as in
+ * printMat. The date is formatted once per second and the lines are
+ * gathered in a large buffer written with one fwrite per batch.
+ ******************************************************************************/
+class Log_TextSink : public Log_Sink{
+public:
+    Log_TextSink(FILE * file = stdout);
+    ~Log_TextSink(void);
+
+    void write(const Log_Record * records, int N);
+    void writeText(const char * text);
+    void flush(void);
+
+private:
+    void append(const Log_Record & record); // Format one line into the buffer
+
+    FILE * _file;
+    char * _buffer;
+    int _used; // Bytes in the buffer
+    time_t _second; // Second of the cached date
+    char _date[32]; // Cached date ("%F\t%T")
+};
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Binary log
+ *
+ * The file starts with a Log_BinaryHeader (magic, version, byte order and
+ * the clock anchor), followed by tagged entries:
+ *	'S' id length bytes: defines a string (name or format) on first use
+ *	'R' dt name fmt increment level kind code Nbytes args: one record
+ *	'T' length bytes: text already formatted (printMat)
+ * The integers are LEB128 varints (dt and code zigzag-encoded); dt is the
+ * CLOCK_REALTIME time since the previous record (ns, negative after the
+ * wall clock is set back). The arguments are the packed bytes of the
+ * record. LogDecode.exe turns a binary log back into the text lines.
+ * Version 1 logs stored CLOCK_MONOTONIC times, turned into dates with the
+ * clock anchor of the header.
+ ******************************************************************************/
+#define LOG_BINARY_MAGIC "AARLOGB" // 8 bytes with the final 0
+#define LOG_BINARY_VERSION 2
+#define LOG_BINARY_BYTE_ORDER 0x01020304
+
+enum Log_BinaryTag{
+    LOG_TAG_STRING = 'S',
+    LOG_TAG_RECORD = 'R',
+    LOG_TAG_TEXT = 'T',
+};
+
+struct Log_BinaryHeader{
+    char magic[8];
+    uint32_t version;
+    uint32_t byteOrder; // LOG_BINARY_BYTE_ORDER in the byte order of the writer
+    int64_t realtimeSec, realtimeNsec; // Clock anchor: same instant on
+    int64_t monotonicSec, monotonicNsec; // CLOCK_REALTIME and CLOCK_MONOTONIC
+};
+
+class Log_BinarySink : public Log_Sink{
+public:
+    Log_BinarySink(FILE * file); // Takes the file (closed by the destructor) and writes the header
+    ~Log_BinarySink(void);
+
+    void write(const Log_Record * records, int N);
+    void writeText(const char * text);
+    void flush(void);
+
+private:
+    void reserve(int Nbytes); // Empty the buffer if Nbytes do not fit
+    void putByte(int byte);
+    void putVarint(uint64_t value);
+    void putBytes(const char * bytes, int N);
+    uint32_t stringId(const char * text); // Id of a string literal (defined in the file on first use)
+
+    FILE * _file;
+    char * _buffer;
+    int _used; // Bytes in the buffer
+    int64_t _previous; // Time of the previous record (ns)
+    std::map<const char *, uint32_t> _ids; // Ids of the strings already defined
+};
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Functions
+ ******************************************************************************/
+Log_Record * openLogRecord(void); // Timestamped slot in the ring of the calling thread
+void commitLogRecord(Log_Record * record); // Hand the record to the background thread
+void flushLog(void); // Wait until every record committed so far is written
+void writeLogText(const char * text); // Write text already formatted, after the pending records
+void stopLog(void); // Write the pending records and stop the background thread (registered with atexit)
+void setLogSink(Log_Sink * sink); // Replace the sink after writing the pending records (takes the sink)
+void getLogClock(struct timespec & realtime, struct timespec & monotonic); // Clock anchor of the process
+void setLogLevel(int level); // Lowest level written at runtime (LOG_LEVEL_*)
+int getLogLevel(void); // Lowest level written at runtime
+
+int packLogArguments(const char * fmt, va_list va, char * args, int size); // Copy the arguments of a format (returns the bytes used)
+int formatLogArguments(const char * fmt, const char * args, int Nbytes, char * out, int size); // printf of a format with packed arguments (returns the length)
+
+}
+
+#endif // ASYNC_LOG_H
@@ -0,0 +1,141 @@
+/***************************************************************************//**
+ * @file	Calibration.hpp
+ * @brief	Header file to calibrate the raw frames of the cameras
+ *
+ * This header file contains all the required definitions and function prototypes
+ * through which to build, store and apply dark and flat correction maps
+ *
+ * @author	Thibaud Talon
+ * @date	18/10/2026
+ *******************************************************************************/
+
+#ifndef CALIBRATION_H
+#define CALIBRATION_H
+
+#include <opencv2/core/core.hpp>
+#include <vector>
+
+namespace Calibration{
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Parameters
+ ******************************************************************************/
+#ifndef OK
+#define OK 0
+#endif
+
+enum Calibration_Error{
+    OK_CALIBRATION = 0,
+
+    ERR_CALIBRATION_NO_FRAMES,
+    ERR_CALIBRATION_FRAME_SIZE,
+    ERR_CALIBRATION_FRAME_TYPE,
+
+    // buildMasterDark
+    ERR_DARK_FATAL,
+
+    // buildMasterFlat
+    ERR_FLAT_FATAL,
+    ERR_FLAT_DARK_SIZE,
+    ERR_FLAT_NO_SIGNAL,
+
+    // buildBadPixelMap
+    ERR_BADPIXEL_FATAL,
+    ERR_BADPIXEL_THRESHOLD,
+
+    // correctBadPixels
+    ERR_CORRECTBADPIXEL_FATAL,
+    ERR_CORRECTBADPIXEL_SIZE,
+
+    // apply
+    ERR_APPLY_FATAL,
+    ERR_APPLY_NO_IMAGE,
+    ERR_APPLY_NO_MAP,
+    ERR_APPLY_MAP_SIZE,
+
+    // save
+    ERR_SAVECAL_FATAL,
+    ERR_SAVECAL_OPEN,
+    ERR_SAVECAL_WRITE,
+    ERR_SAVECAL_MAP_SIZE,
+
+    // load
+    ERR_LOADCAL_FATAL,
+    ERR_LOADCAL_OPEN,
+    ERR_LOADCAL_FORMAT,
+    ERR_LOADCAL_READ,
+};
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Sparse list of bad pixels
+ *
+ * Each bad pixel is replaced by the median of its good 8-neighbours, whose
+ * indices are precomputed so that the correction only touches bad pixels
+ ******************************************************************************/
+#define CALIBRATION_NEIGHBOURS 8
+
+struct Calibration_BadPixels{
+    int rows; // Size of the frame
+    int cols; // Size of the frame
+    std::vector<int> index; // Index (row*cols + col) of each bad pixel
+    std::vector<int> neighbours; // CALIBRATION_NEIGHBOURS good neighbours per bad pixel (-1 = none)
+
+    Calibration_BadPixels(void) {rows = 0; cols = 0;} // Empty list
+};
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Correction maps of one camera setting
+ *
+ * A calibrated pixel is (raw - dark)*gain, with gain = mean(flat)/flat
+ ******************************************************************************/
+struct Calibration_Map{
+    int exposure_us; // Exposure at which the maps were taken
+    float gain_dB; // Gain at which the maps were taken
+    cv::Mat_<float> dark; // Master dark (ADU)
+    cv::Mat_<float> gain; // Inverse of the normalized master flat
+    Calibration_BadPixels badPixels; // Hot, dead and stuck pixels
+};
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Functions
+ ******************************************************************************/
+Calibration_Error buildMasterDark(const std::vector<cv::Mat> & frames, cv::Mat_<float> & dark); // Average a sequence of dark frames
+Calibration_Error buildMasterFlat(const std::vector<cv::Mat> & frames, const cv::Mat_<float> & dark, cv::Mat_<float> & gain); // Build the flat correction from a sequence of flat frames
+Calibration_Error buildBadPixelMap(const cv::Mat_<float> & dark, const cv::Mat_<float> & gain, float hotSigma, float gainTolerance, Calibration_BadPixels & badPixels); // Find the hot, dead and stuck pixels
+Calibration_Error buildBadPixelMap(const std::vector<cv::Mat> & darks, const std::vector<cv::Mat> & flats, float hotSigma, float gainTolerance, Calibration_BadPixels & badPixels); // Find the bad pixels from dark and flat sequences
+Calibration_Error correctBadPixels(cv::Mat & img, const Calibration_BadPixels & badPixels); // Replace the bad pixels by the median of their good neighbours
+Calibration_Error apply(const cv::Mat & raw, const Calibration_Map & map, cv::Mat & calibrated); // Dark, flat and bad pixel correction
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Set of correction maps keyed by exposure and gain
+ ******************************************************************************/
+class Calibration_Library{
+public:
+    std::vector<Calibration_Map> maps; // Correction maps
+
+    void add(const Calibration_Map & map); // Add (or replace) the maps of a setting
+    const Calibration_Map * find(int exposure_us, float gain_dB) const; // Maps of a setting (NULL if none)
+    Calibration_Error apply(const cv::Mat & raw, int exposure_us, float gain_dB, cv::Mat & calibrated) const; // Correct a frame with the maps of its setting
+
+    Calibration_Error save(const char * filename) const; // Save all the maps to a binary file
+    Calibration_Error load(const char * filename); // Load all the maps from a binary file
+};
+
+} // namespace
+
+#endif
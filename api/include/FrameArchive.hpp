@@ -0,0 +1,282 @@
+/***************************************************************************//**
+ * @file	FrameArchive.hpp
+ * @brief	Header file to record raw frames in an indexed archive
+ *
+ * This header file contains all the required definitions and function prototypes
+ * through which to append frames and their metadata to an archive file and to
+ * read any frame of it back without copy
+ *
+ * @author	Thibaud Talon
+ * @date	18/10/2026
+ *******************************************************************************/
+
+#ifndef FRAME_ARCHIVE_H
+#define FRAME_ARCHIVE_H
+
+#include <opencv2/core/core.hpp>
+#include <stdio.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <map>
+#include <string>
+#include <vector>
+#include "UserInterface.hpp"
+#include "ThreadPool.hpp"
+
+namespace FrameArchive{
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Parameters
+ ******************************************************************************/
+#ifndef OK
+#define OK 0
+#endif
+
+enum FrameArchive_Error{
+    OK_FRAMEARCHIVE = 0,
+
+    ERR_ARCHIVE_CLOSED,
+
+    // Writer::open
+    ERR_CREATE_FATAL,
+    ERR_CREATE_FILENAME,
+    ERR_CREATE_OPEN,
+    ERR_CREATE_WRITE,
+
+    // Writer::append
+    ERR_APPEND_FATAL,
+    ERR_APPEND_FRAME,
+    ERR_APPEND_WRITE,
+    ERR_APPEND_ENCODING,
+
+    // Writer::close
+    ERR_FINISH_FATAL,
+    ERR_FINISH_WRITE,
+
+    // Reader::open
+    ERR_OPEN_FATAL,
+    ERR_OPEN_FILE,
+    ERR_OPEN_FORMAT,
+
+    // Reader::read
+    ERR_READ_FATAL,
+    ERR_READ_INDEX,
+    ERR_READ_ENCODING,
+
+    // Recorder::open
+    ERR_RECORD_FATAL,
+    ERR_RECORD_SEGMENT,
+    ERR_RECORD_INDEX,
+
+    // Recorder::append
+    ERR_QUEUE_FATAL,
+    ERR_QUEUE_FULL,
+
+    // Recorder::close
+    ERR_STOP_FATAL,
+};
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Archive file
+ *
+ *	File header (FrameArchive_FileHeader, padded to FRAMEARCHIVE_ALIGNMENT)
+ *	Records, each one:
+ *		FrameArchive_RecordHeader (padded to FRAMEARCHIVE_ALIGNMENT)
+ *		Frame (Nbytes, padded to FRAMEARCHIVE_ALIGNMENT)
+ *	Index: offset of each record (uint64_t)
+ *	FrameArchive_Footer
+ *
+ * The records are only appended; the index and the footer are written by
+ * close(). A file without footer (recording interrupted) is read by
+ * scanning the records up to the last complete one.
+ ******************************************************************************/
+#define FRAMEARCHIVE_MAGIC "AARFRMA" // 8 bytes with the final 0
+#define FRAMEARCHIVE_INDEX_MAGIC "AARFIDX" // 8 bytes with the final 0
+#define FRAMEARCHIVE_RECORD_MAGIC 0x4D415246 // "FRAM"
+#define FRAMEARCHIVE_VERSION 2 // 2: statistics of the frame in the metadata
+#define FRAMEARCHIVE_BYTE_ORDER 0x01020304
+#define FRAMEARCHIVE_ALIGNMENT 64 // Alignment of the records and of the frames (bytes)
+#define FRAMEARCHIVE_BUFFER_SIZE 1048576 // Buffer of the file (bytes)
+
+enum FrameArchive_Encoding{
+    FRAMEARCHIVE_RAW = 0, // Rows of the frame as they are
+    FRAMEARCHIVE_SPOTS, // SpotCodec (lossless, CV_8UC1 and CV_16UC1)
+};
+
+struct FrameArchive_Metadata{
+    int32_t camera; // ImagingCamera_Index (-1 if unknown)
+    int32_t exposure_us; // Exposure
+    float gain_dB; // Gain
+    int32_t offsetX_px, offsetY_px; // Offset of the ROI (its size is the size of the frame)
+    int32_t saturated; // Pixels at or above the saturation level
+    int64_t timestamp_ns; // CLOCK_REALTIME when the frame was taken
+    int64_t frame; // Number of the frame in the recording
+    float min, max, mean, std; // Statistics of the frame (ImageProc::getFrameStats, all 0 if not computed)
+};
+
+struct FrameArchive_FileHeader{
+    char magic[8];
+    uint32_t version;
+    uint32_t byteOrder; // FRAMEARCHIVE_BYTE_ORDER in the byte order of the writer
+};
+
+struct FrameArchive_RecordHeader{
+    uint32_t magic; // FRAMEARCHIVE_RECORD_MAGIC
+    uint32_t encoding; // FrameArchive_Encoding
+    int32_t rows, cols, type; // Frame
+    uint32_t reserved;
+    uint64_t Nbytes; // Bytes of the frame in the file
+    FrameArchive_Metadata metadata;
+    uint64_t checksum; // Fletcher-64 of the fields above
+};
+
+struct FrameArchive_Footer{
+    uint64_t indexOffset; // Offset of the index
+    uint64_t Nframes; // Number of records
+    uint64_t checksum; // Fletcher-64 of the index
+    char magic[8]; // FRAMEARCHIVE_INDEX_MAGIC
+};
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Writer of an archive
+ *
+ * The frames are written from their own rows through a large buffer.
+ ******************************************************************************/
+class FrameArchive_Writer{
+public:
+    FrameArchive_Writer(void) : _file(NULL), _offset(0) {}
+    ~FrameArchive_Writer(void) {close();} // Write the index
+
+    FrameArchive_Error open(const char * filename); // Create the archive (truncated if it exists)
+    FrameArchive_Error append(const cv::Mat & frame, const FrameArchive_Metadata & metadata, FrameArchive_Encoding encoding = FRAMEARCHIVE_RAW); // Append a frame
+    FrameArchive_Error append(const std::vector<uchar> & data, int rows, int cols, int type, const FrameArchive_Metadata & metadata); // Append a frame already encoded by SpotCodec
+    FrameArchive_Error close(void); // Write the index and the footer
+    bool isOpened(void) const {return _file != NULL;}
+    int size(void) const {return (int)_index.size();} // Number of frames
+    uint64_t bytes(void) const {return _offset;} // Bytes written so far
+
+private:
+    FrameArchive_Error writeRecord(FrameArchive_RecordHeader & header, const cv::Mat & frame); // Header, rows and padding
+
+    FILE * _file;
+    uint64_t _offset; // End of the file
+    std::vector<uint64_t> _index; // Offsets of the records
+    std::vector<uchar> _encoded; // Encoded frame (reused)
+
+    FrameArchive_Writer(const FrameArchive_Writer &); // Not copyable
+    FrameArchive_Writer & operator=(const FrameArchive_Writer &);
+};
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Reader of an archive
+ *
+ * The file is mapped in memory: read(k) finds the record in the index and
+ * returns a frame pointing into the mapping (no copy, valid after close()).
+ * Encoded frames are decoded into a new matrix. Every record of the index
+ * is checked when the archive is opened (magic, checksum, size of the frame
+ * inside the file), so a corrupted archive cannot make read() go out of
+ * the mapping.
+ ******************************************************************************/
+class FrameArchive_Reader{
+public:
+    FrameArchive_Reader(void) : _recovered(false) {}
+
+    FrameArchive_Error open(const char * filename); // Map the archive and load (or rebuild) the index
+    FrameArchive_Error read(int k, cv::Mat & frame, FrameArchive_Metadata & metadata); // Frame k and its metadata
+    FrameArchive_Error read(int k, FrameArchive_Metadata & metadata); // Metadata of frame k
+    void close(void);
+    bool isOpened(void) const {return _file.size() > 0;}
+    int size(void) const {return (int)_index.size();} // Number of frames
+    bool recovered(void) const {return _recovered;} // Index rebuilt by scanning (no footer)
+
+private:
+    const FrameArchive_RecordHeader * record(int k) const; // Header of record k
+    bool checkRecord(uint64_t offset, uint64_t end) const; // Record at offset valid and complete before end
+    bool loadIndex(void); // Index of the footer (false if missing or corrupted)
+    void scanIndex(void); // Index of the complete records
+
+    UserInterface::UserInterface_MappedFile _file;
+    std::vector<uint64_t> _index; // Offsets of the records
+    bool _recovered;
+};
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Recorder of a video in segments
+ *
+ * The frames are cut in archives of segmentFrames frames
+ * (<basename>_0000.far, <basename>_0001.far, ...) listed in <basename>.idx
+ * (one line per closed segment: number, file, first frame, number of
+ * frames, first and last timestamps). append() takes the frame and returns
+ * at once: the frames are encoded in parallel on the workers and written in
+ * order. When the queue is full it returns ERR_QUEUE_FULL and the caller
+ * keeps the frame. An error only loses the rest of its segment: the next
+ * segment is a new file. close() returns the first error since open().
+ ******************************************************************************/
+#define FRAMEARCHIVE_SEGMENT_EXTENSION ".far"
+#define FRAMEARCHIVE_INDEX_EXTENSION ".idx"
+
+class FrameArchive_Recorder{
+public:
+    FrameArchive_Recorder(int Nthreads = 0, int maxQueued = 16); // Start the workers (0 threads = number of cores)
+    ~FrameArchive_Recorder(void); // Write the queued frames and close
+
+    FrameArchive_Error open(const char * basename, int segmentFrames, FrameArchive_Encoding encoding = FRAMEARCHIVE_SPOTS); // Start a recording
+    FrameArchive_Error append(cv::Mat & frame, const FrameArchive_Metadata & metadata); // Queue a frame (released when queued)
+    FrameArchive_Error close(void); // Write the queued frames, close the last segment and the index
+    bool isOpened(void) const {return _index != NULL;}
+    int pending(void) {return _pool.pending();} // Frames queued or being encoded
+
+private:
+    class Task; // Encoding of one frame (run on a worker)
+
+    void write(int64_t k, Task * task); // Write the frames in order (called by the workers)
+    void writeFrame(int64_t k, Task * task); // Write frame k (rollover at the first frame of a segment)
+    void closeSegment(void); // Close the archive and add it to the index
+    void failed(FrameArchive_Error error); // Record the first error
+
+    std::string _basename;
+    int _segmentFrames;
+    FrameArchive_Encoding _encoding;
+    FILE * _index; // Index of the segments
+    FrameArchive_Writer _writer; // Current segment
+    int _segment; // Number of the current segment
+    int _segmentCount; // Frames written to the current segment
+    FrameArchive_Metadata _first, _last; // First and last frames of the current segment
+    int64_t _queued; // Frames queued since open()
+    int64_t _written; // Frames written (or dropped) since open()
+    std::map<int64_t, Task *> _encoded; // Frames encoded before their turn
+    pthread_mutex_t _mutex;
+    FrameArchive_Error _error; // First error since open()
+    ThreadPool _pool; // Last member: joined before the rest is destroyed
+
+    FrameArchive_Recorder(const FrameArchive_Recorder &); // Not copyable
+    FrameArchive_Recorder & operator=(const FrameArchive_Recorder &);
+};
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Functions
+ ******************************************************************************/
+uint64_t align(uint64_t offset); // Next multiple of FRAMEARCHIVE_ALIGNMENT
+uint64_t recordChecksum(const FrameArchive_RecordHeader & header); // Checksum of a record header
+
+}
+
+#endif // FRAME_ARCHIVE_H
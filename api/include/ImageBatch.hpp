@@ -0,0 +1,188 @@
+/***************************************************************************//**
+ * @file	ImageBatch.hpp
+ * @brief	Header file to process sequences of images
+ *
+ * This header file contains all the required definitions and function prototypes
+ * through which to run a chain of ImageProc functions on every frame of a video,
+ * a directory of images or a list of images, on several cores
+ *
+ * @author	Thibaud Talon
+ * @date	18/10/2026
+ *******************************************************************************/
+
+#ifndef IMAGE_BATCH_H
+#define IMAGE_BATCH_H
+
+#include <opencv2/core/core.hpp>
+#include <opencv2/highgui/highgui.hpp> // for VideoCapture
+#include <string>
+#include <vector>
+#include "ImageProc.hpp"
+#include "FrameArchive.hpp"
+
+namespace ImageProc{
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Sources of frames
+ ******************************************************************************/
+class ImageProc_FrameSource{
+public:
+    virtual ~ImageProc_FrameSource(void) {}
+    virtual bool isOpened(void) const {return true;} // Source ready to be read
+    virtual bool read(cv::Mat & frame) = 0; // Next frame (false at the end of the sequence)
+};
+
+class ImageProc_VideoSource : public ImageProc_FrameSource{
+public:
+    ImageProc_VideoSource(const char * filename); // Open a video (frames are converted to grayscale)
+    bool isOpened(void) const {return _capture.isOpened();}
+    bool read(cv::Mat & frame);
+
+private:
+    cv::VideoCapture _capture;
+};
+
+class ImageProc_DirectorySource : public ImageProc_FrameSource{
+public:
+    ImageProc_DirectorySource(const char * directory, const char * extension = NULL); // List the images of a directory sorted by name (NULL = all the files)
+    bool isOpened(void) const {return _opened;}
+    bool read(cv::Mat & frame);
+    size_t size(void) const {return _files.size();} // Number of images
+
+private:
+    std::vector<std::string> _files;
+    size_t _next;
+    bool _opened;
+};
+
+class ImageProc_ListSource : public ImageProc_FrameSource{
+public:
+    ImageProc_ListSource(const std::vector<cv::Mat> & frames); // Frames already in memory (not copied)
+    bool read(cv::Mat & frame);
+
+private:
+    const std::vector<cv::Mat> & _frames;
+    size_t _next;
+};
+
+class ImageProc_ArchiveSource : public ImageProc_FrameSource{
+public:
+    ImageProc_ArchiveSource(const char * filename); // Open a frame archive (frames are not copied)
+    bool isOpened(void) const {return _archive.isOpened();}
+    bool read(cv::Mat & frame);
+    size_t size(void) const {return _archive.size();} // Number of frames
+
+private:
+    FrameArchive::FrameArchive_Reader _archive;
+    int _next;
+};
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Result of the chain of stages on one frame
+ ******************************************************************************/
+struct ImageProc_FrameResult{
+    int index; // Position of the frame in the sequence
+    ImageProc_Error error; // Error of the first stage that failed (OK_IMAGEPROC if none)
+    int stage; // Index of the stage that failed (-1 if none)
+    cv::Mat frame; // Frame at the end of the chain
+    ImageProc_SpotList spots; // Spots found by the chain
+    std::vector<float> values; // Scalar outputs of the chain (e.g. radius of encircled energy of each spot)
+
+    ImageProc_FrameResult(void) {index = -1; error = OK_IMAGEPROC; stage = -1;}
+};
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Stages of the chain
+ *
+ * A stage is run concurrently on different frames: run() must not modify the
+ * stage, and must not write into the input frame (assign a new matrix instead)
+ ******************************************************************************/
+class ImageProc_Stage{
+public:
+    virtual ~ImageProc_Stage(void) {}
+    virtual ImageProc_Error run(ImageProc_FrameResult & result) const = 0; // Process the frame of a result
+};
+
+class ImageProc_FilterStage : public ImageProc_Stage{
+public:
+    ImageProc_FilterStage(int threshold_value, int erode_iterations, int dilate_iterations, int order = 0);
+    ImageProc_Error run(ImageProc_FrameResult & result) const; // filter
+
+private:
+    int _threshold, _erode, _dilate, _order;
+};
+
+class ImageProc_CutStage : public ImageProc_Stage{
+public:
+    ImageProc_CutStage(int roiLeft, int roiTop, int roiWidth, int roiHeight);
+    ImageProc_Error run(ImageProc_FrameResult & result) const; // cut
+
+private:
+    int _left, _top, _width, _height;
+};
+
+class ImageProc_SpotLocStage : public ImageProc_Stage{
+public:
+    ImageProc_SpotLocStage(const std::vector<cv::Rect> & windows, ImageProc_Centroid method, float sigma = 0, int Nmax = 20);
+    ImageProc_Error run(ImageProc_FrameResult & result) const; // getSpotLoc inside each window
+
+private:
+    std::vector<cv::Rect> _windows;
+    ImageProc_Centroid _method;
+    float _sigma;
+    int _Nmax;
+};
+
+class ImageProc_SpotsLocStage : public ImageProc_Stage{
+public:
+    ImageProc_SpotsLocStage(float threshold, float minArea = 3, float maxArea = 4000000, int Nstrips = 1); // One strip: the frames already run in parallel
+    ImageProc_Error run(ImageProc_FrameResult & result) const; // getSpotsLoc with the connected-component labeling
+
+private:
+    float _threshold, _minArea, _maxArea;
+    int _Nstrips;
+};
+
+class ImageProc_EncircledEnergyStage : public ImageProc_Stage{
+public:
+    ImageProc_EncircledEnergyStage(float energy, float error, int Nmax = 100);
+    ImageProc_Error run(ImageProc_FrameResult & result) const; // getRadiusOfEncircleEnergy around each spot (appended to values)
+
+private:
+    float _energy, _error;
+    int _Nmax;
+};
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Consumer of the results (called in frame order on the calling thread)
+ ******************************************************************************/
+class ImageProc_ResultSink{
+public:
+    virtual ~ImageProc_ResultSink(void) {}
+    virtual ImageProc_Error consume(ImageProc_FrameResult & result) = 0; // Any error stops the batch
+};
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Functions
+ ******************************************************************************/
+ImageProc_Error processFrames(ImageProc_FrameSource & source, const std::vector<const ImageProc_Stage *> & stages, ImageProc_ResultSink & sink, int Nthreads = 0, int maxInFlight = 0); // Run a chain of stages on every frame of a sequence
+ImageProc_Error processFrames(ImageProc_FrameSource & source, const std::vector<const ImageProc_Stage *> & stages, std::vector<ImageProc_FrameResult> & results, bool keepFrames = false, int Nthreads = 0, int maxInFlight = 0); // Run a chain of stages and collect the results
+
+} // namespace
+
+#endif
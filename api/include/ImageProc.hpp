@@ -13,6 +13,7 @@
 #define IMAGE_PROC_H
 
 #include <opencv2/core/core.hpp>
+#include <vector>
 
 namespace ImageProc{
 
@@ -30,6 +31,7 @@ enum ImageProc_Error{
     OK_IMAGEPROC = 0,
 
     ERR_IMG_MATRIX,
+    ERR_IMG_TYPE,
 
     // preProcessImage
     ERR_FILTER_FATAL,
@@ -37,6 +39,13 @@ enum ImageProc_Error{
     ERR_FILTER_ERODE,
     ERR_FILTER_DILATE,
 
+    // adaptiveThreshold
+    ERR_ADAPTIVE_FATAL,
+    ERR_ADAPTIVE_WINDOW,
+    ERR_ADAPTIVE_METHOD,
+    ERR_ADAPTIVE_RANGE,
+    ERR_ADAPTIVE_STRIPS,
+
     // cutImage
     ERR_CUT_FATAL,
     ERR_CUT_ROI_LEFT_OOB,
@@ -44,6 +53,10 @@ enum ImageProc_Error{
 
     // getSpotLoc
     ERR_SPOTLOC_FATAL,
+    ERR_SPOTLOC_WINDOW_OOB,
+    ERR_SPOTLOC_METHOD,
+    ERR_SPOTLOC_SIGMA,
+    ERR_SPOTLOC_NO_WINDOW,
 
     // getSpotLoc
     ERR_SPOTSLOC_AREA,
@@ -51,6 +64,8 @@ enum ImageProc_Error{
     ERR_SPOTSLOC_SIZE,
     ERR_SPOTSLOC_FATAL,
     ERR_SPOTSLOC_KEYPTS_SIZE,
+    ERR_SPOTSLOC_THRESH,
+    ERR_SPOTSLOC_STRIPS,
 
     // getRadiusofEncircleEnergy
     ERR_ENCIRCLE_FATAL,
@@ -59,6 +74,241 @@ enum ImageProc_Error{
     ERR_ENCIRCLE_ENERGY_OOB,
     ERR_ENCIRCLE_ERROR_OOB,
     ERR_ENCIRCLE_ERROR_TOOMANYITERATIONS,
+
+    // getPSFMetrics
+    ERR_PSF_FATAL,
+    ERR_PSF_WINDOW_OOB,
+    ERR_PSF_NO_SIGNAL,
+
+    // getFocus
+    ERR_FOCUS_FATAL,
+    ERR_FOCUS_ROI_OOB,
+    ERR_FOCUS_NOT_STARTED,
+
+    // getFrameStats
+    ERR_STATS_FATAL,
+    ERR_STATS_BINS,
+    ERR_STATS_SATURATION,
+
+    // registration
+    ERR_REGISTER_FATAL,
+    ERR_REGISTER_NO_REFERENCE,
+    ERR_REGISTER_SIZE,
+
+    // processFrames
+    ERR_BATCH_FATAL,
+    ERR_BATCH_SOURCE,
+    ERR_BATCH_NO_STAGE,
+    ERR_BATCH_WINDOW,
+    ERR_BATCH_POOL,
+};
+
+enum ImageProc_Centroid{
+    CENTROID_COG = 0, // Center of gravity inside the window
+    CENTROID_IWCOG = 1, // Iteratively weighted center of gravity (Gaussian weight of fixed width)
+    CENTROID_GAUSSIAN = 2, // 2D Gaussian fit (adaptive Gaussian weight matched to the spot) over a constant background (median of the window border)
+};
+
+enum ImageProc_Threshold{
+    THRESHOLD_MEAN = 0, // Local mean + k
+    THRESHOLD_SAUVOLA = 1, // Local mean * (1 + k*(local std/R - 1)) (k < 0 for bright spots on a dark background)
+};
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * List of spots (structure of arrays)
+ *
+ * The spots are stored in one 4 x capacity matrix whose rows are the
+ * contiguous x, y, size and flux arrays. asMat() returns the continuous
+ * (x;y;size) matrix used by the cv::Mat_<float> API, and a list can wrap an
+ * existing (x;y) or (x;y;size) matrix without copy. Copies of a list are
+ * deep: a copy never shares the memory of the list it comes from.
+ ******************************************************************************/
+enum ImageProc_SpotField{
+    SPOT_X = 0,
+    SPOT_Y = 1,
+    SPOT_SIZE = 2,
+    SPOT_FLUX = 3,
+    SPOT_FIELDS = 4
+};
+
+class ImageProc_SpotList{
+public:
+    ImageProc_SpotList(int capacity = 0) {_size = 0; reserve(capacity);} // Empty list
+    explicit ImageProc_SpotList(const cv::Mat_<float> & positions); // Wrap a (x;y[;size[;flux]]) matrix without copy
+    ImageProc_SpotList(const ImageProc_SpotList & other) {_size = 0; *this = other;} // Deep copy
+    ImageProc_SpotList & operator=(const ImageProc_SpotList & other); // Deep copy (reuses the memory when large enough)
+
+    void reserve(int capacity); // Reserve memory for capacity spots
+    void clear(void) {_size = 0;} // Remove all the spots (keeps the memory)
+    void push_back(float x, float y, float size = 0, float flux = 0); // Add a spot
+    int size(void) const {return _size;} // Number of spots
+    int capacity(void) const {return data.cols;} // Number of spots before reallocation
+    bool has(ImageProc_SpotField field) const {return field < data.rows;} // Field present (wrapped matrices may lack size or flux)
+
+    float * x(void) {return data[SPOT_X];} // Contiguous array of x
+    float * y(void) {return data[SPOT_Y];} // Contiguous array of y
+    float * field(ImageProc_SpotField field) {return has(field) ? data[field] : NULL;} // Contiguous array of a field (NULL if absent)
+    const float * x(void) const {return data[SPOT_X];}
+    const float * y(void) const {return data[SPOT_Y];}
+    const float * field(ImageProc_SpotField field) const {return has(field) ? data[field] : NULL;}
+
+    cv::Mat_<float> asMat(int fields = 3) const; // Continuous (x;y[;size[;flux]]) matrix, one spot per column
+
+private:
+    cv::Mat_<float> data; // One row per field, one column per spot
+    int _size; // Number of spots
+};
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Statistics of the blobs found by the connected-component labeling
+ * (structure of arrays, one entry per blob)
+ ******************************************************************************/
+struct ImageProc_Blobs{
+    std::vector<int> area; // Number of pixels
+    std::vector<float> flux; // Sum of the intensity
+    std::vector<float> x; // Intensity-weighted centroid (column)
+    std::vector<float> y; // Intensity-weighted centroid (row)
+    std::vector<float> peak; // Maximum intensity
+    std::vector<int> left; // Bounding box
+    std::vector<int> top; // Bounding box
+    std::vector<int> width; // Bounding box
+    std::vector<int> height; // Bounding box
+    std::vector<float> mu20; // Intensity-weighted central second moments
+    std::vector<float> mu11; // Intensity-weighted central second moments
+    std::vector<float> mu02; // Intensity-weighted central second moments
+
+    size_t size(void) const {return area.size();} // Number of blobs
+    void clear(void); // Remove all the blobs
+    void reserve(size_t N); // Reserve memory for N blobs
+    void getSpots(ImageProc_SpotList & spots) const; // List of spots (size = diameter of the disk of same area)
+};
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Metrics of a point spread function (background subtracted, image coordinates)
+ ******************************************************************************/
+struct ImageProc_PSF{
+    float x, y; // Centroid
+    float background; // Background level subtracted from each pixel
+    float flux; // Sum of the intensity in the window
+    float peak; // Maximum intensity
+    int peakX, peakY; // Position of the maximum
+    float fwhmMajor, fwhmMinor; // FWHM along the principal axes (2.3548 sigma of a Gaussian with the same second moments)
+    float angle; // Orientation of the major axis (rad, from the x axis)
+    float ellipticity; // 1 - fwhmMinor/fwhmMajor
+    float strehl; // Peak over flux, relative to the same ratio for the diffraction-limited PSF
+    std::vector<float> encircledEnergy; // Energy (% of flux) inside the radius r+1 around the centroid
+
+    float radiusOfEnergy(float energy) const; // Radius containing an energy (%), interpolated on the curve (-1 if not reached)
+};
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Statistics of a frame (exposure control and quality gates)
+ ******************************************************************************/
+struct ImageProc_FrameStats{
+    std::vector<int> histogram; // Number of pixels per bin, bins spread over [0; saturation]
+    double saturation; // Saturation level
+    int saturated; // Number of pixels at or above the saturation level
+    double min, max; // Extreme values
+    double mean, std; // Mean and standard deviation
+};
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Focus metrics of a region of interest (higher = sharper, except mean)
+ ******************************************************************************/
+struct ImageProc_Focus{
+    double mean; // Mean intensity
+    double laplacianVariance; // Variance of the 4-neighbour Laplacian
+    double brenner; // Mean of the squared difference between pixels 2 columns apart
+    double tenengrad; // Mean of the squared Sobel gradient magnitude
+    double normalizedVariance; // Variance of the intensity over its mean
+};
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Focus metrics of a region of interest moving over one frame
+ *
+ * The metrics are sums of per-pixel terms, so when the region moves only
+ * the rows and columns that enter or leave it are read. The sums are
+ * recomputed from scratch every FOCUS_RESYNC moves to bound the rounding.
+ ******************************************************************************/
+#define FOCUS_RESYNC 64
+
+class ImageProc_FocusTracker{
+public:
+    struct Sums{
+        double I, I2, L, L2, B, T; // Sums of intensity, intensity^2, Laplacian, Laplacian^2, Brenner and Tenengrad terms
+    };
+
+    ImageProc_FocusTracker(void) {_moves = 0;}
+
+    ImageProc_Error start(cv::Mat & img, cv::Rect roi, ImageProc_Focus & focus); // Compute the metrics of a region of a new frame
+    ImageProc_Error move(cv::Rect roi, ImageProc_Focus & focus); // Move the region over the same frame
+
+private:
+    cv::Mat _img;
+    cv::Rect _roi;
+    Sums _sums;
+    int _moves;
+};
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Scratch buffers of the calling thread
+ *
+ * The temporaries of filter, getSpotsLoc and getRadiusOfEncircleEnergy live
+ * here instead of on the heap of each call: a buffer is only reallocated
+ * when the size or the type of the frames changes, so processing a stream
+ * of frames of the same format does not allocate once warmed up. Each
+ * thread has its own workspace (created on first use, freed when the
+ * thread exits), so the functions stay safe to call from several threads.
+ ******************************************************************************/
+class ImageProc_Workspace{
+public:
+    enum Buffer{
+        WS_THRESHOLD = 0, // filter: thresholded image
+        WS_MORPHOLOGY, // filter: result of the first morphological operation
+        WS_MASK, // getRadiusOfEncircleEnergy: circular mask
+        WS_8BIT, // getSpotsLoc: image scaled to 8 bits
+        WS_SUM, // adaptiveThreshold: integral image
+        WS_SQSUM, // adaptiveThreshold: integral image of the squares
+        WS_NBUFFERS
+    };
+
+    struct Keypoints; // getSpotsLoc: keypoints of the blob detector (defined in ImageProc.cpp, which includes features2d)
+
+    ImageProc_Workspace(void) : _keypoints(NULL) {}
+    ~ImageProc_Workspace(void);
+
+    cv::Mat & buffer(Buffer index, cv::Size size, int type); // Buffer with the requested size and type (reallocated only if they change)
+    Keypoints & keypoints(void); // Keypoints of the blob detector (capacity kept between calls)
+
+    static ImageProc_Workspace & local(void); // Workspace of the calling thread
+
+private:
+    cv::Mat _buffers[WS_NBUFFERS];
+    Keypoints * _keypoints; // Created on first use
+
+    ImageProc_Workspace(const ImageProc_Workspace &); // Not copyable
+    ImageProc_Workspace & operator=(const ImageProc_Workspace &);
 };
 
 /***************************************************************************//**
@@ -68,10 +318,22 @@ enum ImageProc_Error{
  * Functions
  ******************************************************************************/
 ImageProc_Error filter(cv::Mat & img, int threshold_value, int erode_iterations, int dilate_iterations, cv::Mat & filtered_img, int order); // Filter an image
+ImageProc_Error filter(cv::Mat & img, int window, ImageProc_Threshold method, float k, int erode_iterations, int dilate_iterations, cv::Mat & filtered_img, int order = 0); // Filter an image with a local threshold
+ImageProc_Error adaptiveThreshold(cv::Mat & img, cv::Mat & thresholded_img, int window, ImageProc_Threshold method = THRESHOLD_MEAN, float k = 0, float R = 0, int Nstrips = 0); // Set the pixels under a local threshold to 0
 ImageProc_Error cut(cv::Mat & img, int roiLeft, int roiTop, int roiWidth, int roiHeigh, cv::Mat & cut_img); // Cut an image
 ImageProc_Error getSpotLoc(cv::Mat & img, cv::Mat_<float> & spotsPositionArray); // Find centroid of light
-ImageProc_Error getSpotsLoc(cv::Mat & img, cv::Mat_<float> & spotsPositionArray, float minArea, float maxArea, float minInertiaRatio, float maxInertiaRatio); // Find all the spots
+ImageProc_Error getSpotLoc(cv::Mat & img, cv::Mat_<float> & spotPositionArray, ImageProc_Centroid method, cv::Rect window = cv::Rect(), float sigma = 0, int Nmax = 20); // Find centroid of light inside a window
+ImageProc_Error getSpotLoc(cv::Mat & img, ImageProc_SpotList & spots, ImageProc_Centroid method, cv::Rect window = cv::Rect(), float sigma = 0, int Nmax = 20); // Find centroid of light inside a window
+ImageProc_Error getSpotLoc(cv::Mat & img, const std::vector<cv::Rect> & windows, cv::Mat_<float> & spotsPositionArray, ImageProc_Centroid method, float sigma = 0, int Nmax = 20); // Find centroid of light inside each window
+ImageProc_Error getSpotLoc(cv::Mat & img, const std::vector<cv::Rect> & windows, ImageProc_SpotList & spots, ImageProc_Centroid method, float sigma = 0, int Nmax = 20); // Find centroid of light inside each window
+ImageProc_Error getSpotsLoc(cv::Mat & img, cv::Mat_<float> & spotsPositionArray, float minArea = 3, float maxArea = 4000000, float minCircularity = 0, float maxCircularity = 1, float maxSize = 2000); // Find all the spots
+ImageProc_Error getSpotsLoc(cv::Mat & img, ImageProc_SpotList & spots, float minArea = 3, float maxArea = 4000000, float minCircularity = 0, float maxCircularity = 1, float maxSize = 2000); // Find all the spots
+ImageProc_Error getSpotsLoc(cv::Mat & img, ImageProc_Blobs & blobs, float threshold, float minArea = 3, float maxArea = 4000000, int Nstrips = 0); // Find all the spots with the connected-component labeling
 ImageProc_Error getRadiusOfEncircleEnergy(cv::Mat & img, const cv::Mat_<float> & center, float energy, float error, float & radius, int Nmax); // Get radius of encircled energy
+ImageProc_Error getRadiusOfEncircleEnergy(cv::Mat & img, const ImageProc_SpotList & spots, int index, float energy, float error, float & radius, int Nmax); // Get radius of encircled energy around a spot of a list
+ImageProc_Error getPSFMetrics(cv::Mat & img, cv::Rect window, ImageProc_PSF & psf, float background = -1, float idealPeakFraction = 0); // Get all the metrics of a PSF in one pass over a window
+ImageProc_Error getFrameStats(const cv::Mat & img, ImageProc_FrameStats & stats, int Nbins = 256, double saturation = 0); // Get the histogram and statistics of a frame in one pass
+ImageProc_Error getFocus(cv::Mat & img, cv::Rect roi, ImageProc_Focus & focus); // Get the focus metrics of a region in one pass
 
 
 } // namespace
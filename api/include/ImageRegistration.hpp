@@ -0,0 +1,70 @@
+/***************************************************************************//**
+ * @file	ImageRegistration.hpp
+ * @brief	Header file to register images by phase correlation
+ *
+ * This header file contains all the required definitions and function prototypes
+ * through which to measure the translation between an image and a reference
+ *
+ * @author	Thibaud Talon
+ * @date	18/10/2026
+ *******************************************************************************/
+
+#ifndef IMAGE_REGISTRATION_H
+#define IMAGE_REGISTRATION_H
+
+#include <opencv2/core/core.hpp>
+#include <vector>
+#include "ImageProc.hpp"
+#include "ImageBatch.hpp"
+
+namespace ImageProc{
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Phase-correlation registration against a reference
+ *
+ * The window, the DFT size and the spectrum of the reference are computed
+ * once by setReference. registerImage only reads them, so it can be called
+ * from several threads at once.
+ ******************************************************************************/
+class ImageProc_Registration{
+public:
+    ImageProc_Registration(void) {}
+    ImageProc_Registration(const cv::Mat & reference) {setReference(reference);}
+
+    ImageProc_Error setReference(const cv::Mat & reference); // Cache the window and the spectrum of the reference
+    ImageProc_Error registerImage(const cv::Mat & img, cv::Point2f & shift, float & response) const; // Shift of an image relative to the reference (img(x) = ref(x - shift))
+    ImageProc_Error registerFrames(const std::vector<cv::Mat> & frames, std::vector<cv::Point2f> & shifts, std::vector<float> & responses, int Nthreads = 0) const; // Register a sequence on several threads
+
+    cv::Size size(void) const {return _size;} // Size of the frames
+    cv::Size dftSize(void) const {return _dftSize;} // Padded size of the transforms
+
+private:
+    ImageProc_Error spectrum(const cv::Mat & img, cv::Mat & F) const; // Windowed, padded spectrum of an image
+
+    cv::Size _size;
+    cv::Size _dftSize;
+    cv::Mat _window; // Hanning window (CV_32F)
+    cv::Mat _reference; // Spectrum of the reference (CV_32FC2)
+};
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Stage of a batch: appends (dx, dy, response) to the values of the result
+ ******************************************************************************/
+class ImageProc_RegistrationStage : public ImageProc_Stage{
+public:
+    ImageProc_RegistrationStage(const ImageProc_Registration & registration) : _registration(registration) {}
+    ImageProc_Error run(ImageProc_FrameResult & result) const;
+
+private:
+    const ImageProc_Registration & _registration;
+};
+
+} // namespace
+
+#endif
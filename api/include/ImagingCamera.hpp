@@ -15,6 +15,8 @@
 #include <m3api/xiApi.h>
 #include <opencv2/core/core.hpp>
 #include <opencv2/highgui/highgui.hpp>
+#include "ImageProc.hpp"
+#include "FrameArchive.hpp"
 
 /***************************************************************************//**
  * @author Thibaud Talon
@@ -74,7 +76,9 @@ enum ImagingCamera_Error{
     ERR_IMAGINGCAMERA_GET_EXPOSURE,
     ERR_IMAGINGCAMERA_GET_EXPOSURE_FATAL,
     ERR_IMAGINGCAMERA_GET_TELEMETRY,
-    ERR_IMAGINGCAMERA_GET_TELEMETRY_FATAL
+    ERR_IMAGINGCAMERA_GET_TELEMETRY_FATAL,
+    ERR_IMAGINGCAMERA_FRAME_STATS,
+    ERR_IMAGINGCAMERA_RECORD
 };
 
 enum ImagingCamera_Status{
@@ -194,6 +198,20 @@ struct ImagingCamera_Telemetry{
     char version_fpga1[20];
 };
 
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Consumer of the frames of a video (the frame wraps the camera buffer,
+ * which is reused by the next frame) with their statistics, computed while
+ * the frame is in cache
+ ******************************************************************************/
+class ImagingCamera_FrameSink{
+public:
+    virtual ~ImagingCamera_FrameSink(void) {}
+    virtual ImagingCamera_Error add(const cv::Mat & frame, const ImageProc::ImageProc_FrameStats & stats, int index) = 0; // Any error stops the video
+};
+
 /***************************************************************************//**
  * @author Thibaud Talon
  * @date   21/09/2017
@@ -216,7 +234,9 @@ public:
     ImagingCamera_Error reset(void); // Reset the connection to the camera
 
     ImagingCamera_Error getImage(cv::Mat & img); // Get an image from the camera
+    ImagingCamera_Error getImage(cv::Mat & img, ImageProc::ImageProc_FrameStats & stats, int Nbins = 256, double saturation = 0); // Get an image and its statistics
     ImagingCamera_Error getVideo(cv::VideoWriter & video, float fps, float duration_s); // Get an video from the camera
+    ImagingCamera_Error getVideo(FrameArchive::FrameArchive_Recorder & recorder, float fps, float duration_s); // Record a video without loss
 
     ImagingCamera_Error setTimeout(int timeout_ms); // Set capture timeout
     ImagingCamera_Error setROI(int offsetX_px, int offsetY_px, int width_px, int height_px); // Set region of interest
@@ -237,6 +257,8 @@ public:
 private:
     HANDLE handle;
     int _timeout;
+
+    ImagingCamera_Error captureVideo(ImagingCamera_FrameSink & sink, float fps, float duration_s); // Trigger the frames of a video at a fixed rate
 };
 
 
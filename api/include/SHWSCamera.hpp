@@ -14,6 +14,7 @@
 
 #include <opencv2/core/core.hpp>
 #include "bgapi2_genicam.hpp"
+#include "ImageProc.hpp"
 
 /***************************************************************************//**
  * @author Thibaud Talon
@@ -86,6 +87,8 @@ enum SHWSCamera_Error{
     ERR_SHWSCAMERA_GET_PACKET_DELAY,
 
     ERR_SHWSCAMERA_GET_TELEMETRY,
+
+    ERR_SHWSCAMERA_FRAME_STATS,
 };
 
 enum SHWSCamera_Status{
@@ -239,6 +242,7 @@ public:
     SHWSCamera_Error disconnect(SHWSCamera_Index); // Disconnect the sensor + device
     SHWSCamera_Error reset(void); // Reset the connection to the camera
     SHWSCamera_Error getImage(cv::Mat & img); // Get an image from the camera
+    SHWSCamera_Error getImage(cv::Mat & img, ImageProc::ImageProc_FrameStats & stats, int Nbins = 256, double saturation = 0); // Get an image and its statistics
 
     SHWSCamera_Error setTimeout(int timeout_ms); // Set capture timeout
     SHWSCamera_Error setRetryNumber(int retry_max); // Set number for retries when taking an image
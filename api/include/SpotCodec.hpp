@@ -0,0 +1,91 @@
+/***************************************************************************//**
+ * @file	SpotCodec.hpp
+ * @brief	Header file to compress spot images without loss
+ *
+ * This header file contains all the required definitions and function prototypes
+ * through which to encode 8-bit and 16-bit frames made of a dark background and
+ * a few bright spots (Shack-Hartmann, science camera), and to decode them
+ *
+ * @author	Thibaud Talon
+ * @date	18/10/2026
+ *******************************************************************************/
+
+#ifndef SPOT_CODEC_H
+#define SPOT_CODEC_H
+
+#include <opencv2/core/core.hpp>
+#include <stdint.h>
+#include <vector>
+
+namespace SpotCodec{
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Parameters
+ ******************************************************************************/
+#ifndef OK
+#define OK 0
+#endif
+
+enum SpotCodec_Error{
+    OK_SPOTCODEC = 0,
+
+    // encode
+    ERR_ENCODE_FATAL,
+    ERR_ENCODE_IMAGE,
+    ERR_ENCODE_TYPE,
+    ERR_ENCODE_STRIPS,
+
+    // decode
+    ERR_DECODE_FATAL,
+    ERR_DECODE_FORMAT,
+    ERR_DECODE_CORRUPTED,
+};
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Encoded frame
+ *
+ *	SpotCodec_Header
+ *	Bytes of each strip (uint32_t, Nstrips)
+ *	Strips
+ *
+ * The rows are cut in strips coded independently (in parallel). In a
+ * strip, each pixel is predicted from its neighbours (median of left, up
+ * and left + up - up-left) and the residuals are coded by blocks of
+ * SPOTCODEC_BLOCK_SIZE: a run of blocks without residual (flat
+ * background) costs a few bits, the other blocks are Rice-coded with a
+ * parameter fitted to the block (small on the background, large on the
+ * edges of the spots).
+ ******************************************************************************/
+#define SPOTCODEC_MAGIC "SPC" // 4 bytes with the final 0
+#define SPOTCODEC_VERSION 1
+#define SPOTCODEC_STRIP_ROWS 64 // Default rows per strip
+#define SPOTCODEC_BLOCK_SIZE 16 // Residuals per block
+#define SPOTCODEC_ESCAPE 24 // Longest unary prefix of a Rice code (then the residual is written as it is)
+
+struct SpotCodec_Header{
+    char magic[4];
+    uint16_t version;
+    uint8_t depth; // CV_8U or CV_16U
+    uint8_t reserved;
+    int32_t rows, cols;
+    int32_t stripRows; // Rows per strip (the last strip may be shorter)
+};
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Functions
+ ******************************************************************************/
+SpotCodec_Error encode(const cv::Mat & img, std::vector<uchar> & data, int stripRows = SPOTCODEC_STRIP_ROWS); // Compress a CV_8UC1 or CV_16UC1 frame
+SpotCodec_Error decode(const uchar * data, size_t Nbytes, cv::Mat & img); // Decompress a frame
+
+}
+
+#endif // SPOT_CODEC_H
@@ -0,0 +1,90 @@
+/***************************************************************************//**
+ * @file	ThreadPool.hpp
+ * @brief	Header file to run tasks on a pool of worker threads
+ *
+ * This header file contains all the required definitions and function prototypes
+ * through which to run tasks in the background on several cores
+ *
+ * @author	Thibaud Talon
+ * @date	18/10/2026
+ *******************************************************************************/
+
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <pthread.h>
+#include <deque>
+#include <vector>
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Parameters
+ ******************************************************************************/
+#ifndef OK
+#define OK 0
+#endif
+
+enum ThreadPool_Error{
+    OK_THREADPOOL = 0,
+    ERR_THREADPOOL_CREATE,
+    ERR_THREADPOOL_STOPPED,
+    ERR_THREADPOOL_FULL,
+    ERR_THREADPOOL_TASK,
+};
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Task to run on the pool
+ ******************************************************************************/
+class ThreadPool_Task{
+public:
+    virtual ~ThreadPool_Task(void) {}
+    virtual void run(void) = 0; // Work of the task (called on a worker thread)
+};
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Pool of worker threads with a FIFO queue of tasks
+ *
+ * The pool does not own the tasks unless they are submitted with
+ * autoDelete = true, in which case they are deleted after running.
+ ******************************************************************************/
+class ThreadPool{
+public:
+    ThreadPool(int Nthreads = 0, int maxQueued = 0); // Start the workers (0 threads = number of cores, 0 queued = unbounded)
+    ~ThreadPool(void); // Run the queued tasks and join the workers
+
+    ThreadPool_Error submit(ThreadPool_Task * task, bool autoDelete = false, bool block = true); // Queue a task
+    void wait(void); // Wait until all the submitted tasks are done
+    int size(void) const {return (int)_threads.size();} // Number of workers
+    int pending(void); // Number of tasks queued or running
+
+private:
+    struct Entry{
+        ThreadPool_Task * task;
+        bool autoDelete;
+    };
+
+    static void * worker(void * pool); // Loop of a worker thread
+
+    std::vector<pthread_t> _threads;
+    std::deque<Entry> _queue;
+    int _maxQueued;
+    int _running;
+    bool _stop;
+    pthread_mutex_t _mutex;
+    pthread_cond_t _hasTask; // Signaled when a task is queued or the pool stops
+    pthread_cond_t _hasRoom; // Signaled when a task leaves the queue
+    pthread_cond_t _idle; // Signaled when the last task is done
+
+    ThreadPool(const ThreadPool &); // Not copyable
+    ThreadPool & operator=(const ThreadPool &);
+};
+
+#endif
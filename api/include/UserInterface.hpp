@@ -16,6 +16,12 @@
 #include <opencv2/highgui/highgui.hpp>
 #include <time.h>
 #include <sys/time.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <string>
+#include "AsyncLog.hpp"
+#include "ThreadPool.hpp"
 
 namespace UserInterface {
 
@@ -29,6 +35,8 @@ namespace UserInterface {
 #define OK 0
 #endif
 
+#define CSV_BLOCK_SIZE 1048576 // Bytes of text formatted per block by saveMatAsCSV
+
 enum UserInterface_Error{
     OK_USERINTERFACE = 0,
 
@@ -40,17 +48,44 @@ enum UserInterface_Error{
     ERR_SAVECSV_FILENAME,
     ERR_SAVECSV_OPEN,
     ERR_SAVECSV_CLOSE,
+    ERR_SAVECSV_WRITE,
+    ERR_SAVECSV_STRIPS,
 
     // SaveMatAsCSV
     ERR_LOADCSV_FATAL,
     ERR_LOADCSV_FILENAME,
     ERR_LOADCSV_OPEN,
     ERR_LOADCSV_CLOSE,
+    ERR_LOADCSV_EMPTY,
+    ERR_LOADCSV_STRIPS,
+
+    // SaveMat
+    ERR_SAVEMAT_FATAL,
+    ERR_SAVEMAT_MAT,
+    ERR_SAVEMAT_FILENAME,
+    ERR_SAVEMAT_OPEN,
+    ERR_SAVEMAT_WRITE,
+    ERR_SAVEMAT_RENAME,
+
+    // LoadMat
+    ERR_LOADMAT_FATAL,
+    ERR_LOADMAT_FILENAME,
+    ERR_LOADMAT_OPEN,
+    ERR_LOADMAT_FORMAT,
+    ERR_LOADMAT_TYPE,
+    ERR_LOADMAT_CHECKSUM,
+
+    // MapFile
+    ERR_MAPFILE_FATAL,
+    ERR_MAPFILE_FILENAME,
+    ERR_MAPFILE_OPEN,
+    ERR_MAPFILE_MAP,
 
     // SaveImage
     ERR_SAVEIMG_FATAL,
     ERR_SAVEIMG_FILENAME,
     ERR_SAVEIMG_WRITE,
+    ERR_SAVEIMG_FULL,
 
     // LoadImage
     ERR_LOADIMG_FATAL,
@@ -61,6 +96,11 @@ enum UserInterface_Error{
     ERR_CREATEVIDEO_FATAL,
     ERR_CREATE_VIDEO,
 
+    // OpenBinaryLog
+    ERR_BINLOG_FATAL,
+    ERR_BINLOG_FILENAME,
+    ERR_BINLOG_OPEN,
+
 };
 
 /***************************************************************************//**
@@ -68,21 +108,105 @@ enum UserInterface_Error{
  * @date   21/09/2017
  *
  * Log class to generate log/debug files
+ *
+ * The calls only timestamp and copy their arguments into a ring of the
+ * calling thread: a background thread formats and writes the lines (see
+ * AsyncLog.hpp). name and fmt must be string literals. flush() waits until
+ * the lines logged so far are written (done at exit).
+ *
+ * Each call has a level: debug (steps, success), printf (results), warning
+ * and error. The levels under LOG_COMPILED_LEVEL compile to empty inline
+ * functions; the levels under setLevel() are dropped before their
+ * arguments are copied. The arguments of an empty function are still
+ * evaluated: LOG_DEBUG(log, ...) removes the whole call, for the steps
+ * whose arguments query a device.
  ******************************************************************************/
+#if LOG_COMPILED_LEVEL <= LOG_LEVEL_DEBUG
+#define LOG_DEBUG(log, ...) (log).debug(__VA_ARGS__)
+#else
+#define LOG_DEBUG(log, ...) ((void) 0)
+#endif
+
 class Log{
 public:
     Log(const char* name) : _name(name) {increment = 1;} // Initialize the object
+
+#if LOG_COMPILED_LEVEL <= LOG_LEVEL_DEBUG
+    void debug (const char * fmt, ...) __attribute__((format(printf, 2, 3))); // Steps of a function
+    int success(void); // Display and return success
+#else
+    void debug (const char *, ...) {}
+    int success(void) {return OK;}
+#endif
+
+#if LOG_COMPILED_LEVEL <= LOG_LEVEL_INFO
     void printMat(const char* text, cv::Mat & mat); // Display a matrix in the log
-    void printf (const char * fmt, ...); // Classic printf function but formated to log format
+    void printf (const char * fmt, ...) __attribute__((format(printf, 2, 3))); // Classic printf function but formated to log format
+#else
+    void printMat(const char*, cv::Mat &) {}
+    void printf (const char *, ...) {}
+#endif
+
+#if LOG_COMPILED_LEVEL <= LOG_LEVEL_WARNING
+    void warning (const char * fmt, ...) __attribute__((format(printf, 2, 3))); // Display a warning
+#else
+    void warning (const char *, ...) {}
+#endif
+
+#if LOG_COMPILED_LEVEL <= LOG_LEVEL_ERROR
     int error(const char* errorText, int errorInt); // Display and return errors
-    int success(void); // Display and return success
+#else
+    int error(const char*, int errorInt) {return errorInt;}
+#endif
+
+    static void setLevel(int level); // Lowest level written at runtime (LOG_LEVEL_*)
+    static void flush(void); // Wait until every line logged so far is written
 
 private:
+    void record(int level, const char * fmt, va_list va); // Copy a printf into a record
+
     const char* _name; // Name of function
     int increment; // Increment of log
-    time_t rawtime; // To save the time
-    struct timeval tv; // To save the time
-    char time_str[100]; // String to hold the time
+};
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Log file management functions
+ ******************************************************************************/
+
+UserInterface_Error openBinaryLog(const char * filename); // Write the log to a binary file (decoded by LogDecode.exe)
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * File mapped in memory
+ *
+ * The matrices built with view() point into the mapping and share it:
+ * the file stays mapped until close() and the release of the last of
+ * these matrices. The mapping is copy-on-write: writes to the matrices
+ * never reach the file.
+ ******************************************************************************/
+struct MappedMatBlock;
+
+class UserInterface_MappedFile{
+public:
+    UserInterface_MappedFile(void) : _block(NULL) {}
+    ~UserInterface_MappedFile(void) {close();}
+
+    UserInterface_Error open(const char * filename); // Map a file
+    void close(void); // Release the mapping
+    const uchar * data(void) const; // Start of the file
+    size_t size(void) const; // Bytes in the file
+    cv::Mat view(size_t offset, int rows, int cols, int type, size_t step = cv::Mat::AUTO_STEP) const; // Matrix on the mapping (no copy)
+
+private:
+    MappedMatBlock * _block; // Mapping and reference counter
+
+    UserInterface_MappedFile(const UserInterface_MappedFile &); // Not copyable
+    UserInterface_MappedFile & operator=(const UserInterface_MappedFile &);
 };
 
 /***************************************************************************//**
@@ -92,11 +216,46 @@ private:
  * CSV file management functions
  ******************************************************************************/
 
-UserInterface_Error saveMatAsCSV(cv::Mat_<float> & mat, const char * filename);
-UserInterface_Error saveMatAsCSV(cv::Mat_<int> & mat, const char * filename);
+UserInterface_Error saveMatAsCSV(cv::Mat_<float> & mat, const char * filename, int Nstrips = 0);
+UserInterface_Error saveMatAsCSV(cv::Mat_<int> & mat, const char * filename, int Nstrips = 0);
 
-UserInterface_Error loadMatFromCSV(const char * filename, cv::Mat_<float> & mat);
-UserInterface_Error loadMatFromCSV(const char * filename, cv::Mat_<int> & mat);
+UserInterface_Error loadMatFromCSV(const char * filename, cv::Mat_<float> & mat, int Nstrips = 0);
+UserInterface_Error loadMatFromCSV(const char * filename, cv::Mat_<int> & mat, int Nstrips = 0);
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Binary matrix file management functions
+ *
+ * The file starts with a Mat_BinaryHeader; the data (continuous rows)
+ * starts at MAT_BINARY_OFFSET, so that loadMat maps it in memory instead
+ * of reading it. The checksum is the Fletcher-64 of the data.
+ ******************************************************************************/
+#define MAT_BINARY_MAGIC "AARMATB" // 8 bytes with the final 0
+#define MAT_BINARY_VERSION 1
+#define MAT_BINARY_BYTE_ORDER 0x01020304
+#define MAT_BINARY_OFFSET 4096 // Offset of the data (page-aligned)
+
+struct Mat_BinaryHeader{
+    char magic[8];
+    uint32_t version;
+    uint32_t byteOrder; // MAT_BINARY_BYTE_ORDER in the byte order of the writer
+    int32_t type; // OpenCV type (CV_32FC1, CV_32SC1)
+    int32_t rows, cols;
+    uint32_t reserved;
+    uint64_t offset; // Offset of the data
+    uint64_t Nbytes; // Bytes of data
+    uint64_t checksum; // Fletcher-64 of the data
+};
+
+uint64_t fletcher64(const uint32_t * words, size_t N); // Checksum of N 32-bit words
+
+UserInterface_Error saveMat(cv::Mat_<float> & mat, const char * filename);
+UserInterface_Error saveMat(cv::Mat_<int> & mat, const char * filename);
+
+UserInterface_Error loadMat(const char * filename, cv::Mat_<float> & mat, bool verify = true);
+UserInterface_Error loadMat(const char * filename, cv::Mat_<int> & mat, bool verify = true);
 
 /***************************************************************************//**
  * @author Thibaud Talon
@@ -108,6 +267,48 @@ UserInterface_Error loadMatFromCSV(const char * filename, cv::Mat_<int> & mat);
 UserInterface_Error saveImage(cv::Mat & img, const char * filename);
 UserInterface_Error loadImage(const char * filename, cv::Mat & img);
 
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Images saved in the background
+ *
+ * save() takes the image and queues it for the workers, which encode and
+ * write it; when the queue is full it returns ERR_SAVEIMG_FULL at once and
+ * the caller keeps the image. Only refcounted data (allocated by OpenCV)
+ * is queued without copy (img is released); an image wrapping external
+ * memory, such as the buffer of a camera driver, is copied first since the
+ * next capture overwrites it. Other matrices sharing refcounted data of a
+ * queued image must not be written until flush(). flush() waits for the
+ * queued images and returns the first error since the previous flush.
+ ******************************************************************************/
+class UserInterface_ImageSaver{
+public:
+    UserInterface_ImageSaver(int Nthreads = 1, int maxQueued = 8); // Start the workers
+    ~UserInterface_ImageSaver(void); // Write the queued images
+
+    UserInterface_Error save(cv::Mat & img, const char * filename); // Queue an image (extension in filename)
+    UserInterface_Error flush(void); // Wait until the queued images are written
+    int pending(void) {return _pool.pending();} // Images queued or being written
+
+    void setJPEGQuality(int quality) {_jpegQuality = quality;} // 0 to 100 (default 95)
+    void setPNGCompression(int level) {_pngCompression = level;} // 0 to 9 (default 3)
+
+private:
+    class Task; // Save of one image (run on a worker)
+
+    void failed(UserInterface_Error error); // Record the error of a worker
+
+    int _jpegQuality;
+    int _pngCompression;
+    pthread_mutex_t _mutex;
+    UserInterface_Error _error; // First error since the previous flush
+    ThreadPool _pool; // Last member: joined before the rest is destroyed
+
+    UserInterface_ImageSaver(const UserInterface_ImageSaver &); // Not copyable
+    UserInterface_ImageSaver & operator=(const UserInterface_ImageSaver &);
+};
+
 /***************************************************************************//**
  * @author Thibaud Talon
  * @date   21/09/2017
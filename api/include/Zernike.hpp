@@ -0,0 +1,103 @@
+/***************************************************************************//**
+ * @file	Zernike.hpp
+ * @brief	Header file to decompose wavefronts on the Zernike polynomials
+ *
+ * This header file contains all the required definitions and function prototypes
+ * through which to build a Zernike basis once and project wavefronts or
+ * Shack-Hartmann slopes onto it
+ *
+ * @author	Thibaud Talon
+ * @date	18/10/2026
+ *******************************************************************************/
+
+#ifndef ZERNIKE_H
+#define ZERNIKE_H
+
+#include <opencv2/core/core.hpp>
+#include <vector>
+
+namespace Zernike{
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Parameters
+ ******************************************************************************/
+#ifndef OK
+#define OK 0
+#endif
+
+#define ZERNIKE_MAX_ORDER 20 // Largest radial order (factorials stay exact in 64-bit integers)
+
+enum Zernike_Error{
+    OK_ZERNIKE = 0,
+
+    ERR_ZERNIKE_ORDER,
+    ERR_ZERNIKE_NO_BASIS,
+
+    // buildPupil
+    ERR_PUPIL_FATAL,
+    ERR_PUPIL_SIZE,
+
+    // buildSlopes
+    ERR_SLOPES_FATAL,
+    ERR_SLOPES_POSITIONS,
+
+    // decompose
+    ERR_DECOMPOSE_FATAL,
+    ERR_DECOMPOSE_SIZE,
+
+    // reconstruct
+    ERR_RECONSTRUCT_FATAL,
+    ERR_RECONSTRUCT_SIZE,
+};
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Functions
+ ******************************************************************************/
+int numberOfModes(int order); // Number of modes up to a radial order (Noll indices 1 to N)
+void nollToNM(int j, int & n, int & m); // Radial order n and azimuthal frequency m (negative = sine) of a Noll index
+void radialCoefficients(int n, int m, std::vector<double> & c); // Coefficients of R_n^m: c[k] multiplies rho^(n-2k)
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Zernike basis cached on a pupil grid or at subaperture positions
+ *
+ * The modes are ordered by Noll index (piston first) and normalized so that
+ * their RMS over the unit disk is 1. The pseudo-inverse of the sampled basis
+ * is computed once when the basis is built, so a decomposition is a single
+ * matrix-vector product (CBLAS GEMV).
+ ******************************************************************************/
+class Zernike_Basis{
+public:
+    Zernike_Basis(void) {_order = 0; _Nmodes = 0; _size = 0; _Nsub = 0;}
+
+    Zernike_Error buildPupil(int size, int order); // Sample the modes on a size x size grid (pupil = inscribed disk)
+    Zernike_Error buildSlopes(const cv::Mat_<float> & positions, int order); // Sample the derivatives of the modes at subaperture positions (2 x N, unit pupil radius)
+
+    Zernike_Error decompose(const cv::Mat & wavefront, cv::Mat_<float> & coefficients) const; // Coefficients of a wavefront (size x size, pupil basis)
+    Zernike_Error decomposeSlopes(const cv::Mat_<float> & slopes, cv::Mat_<float> & coefficients) const; // Coefficients of slopes (2 x N, x then y, slope basis)
+    Zernike_Error reconstruct(const cv::Mat_<float> & coefficients, cv::Mat_<float> & wavefront) const; // Wavefront from coefficients (pupil basis)
+
+    int order(void) const {return _order;} // Largest radial order
+    int size(void) const {return _Nmodes;} // Number of modes
+    const cv::Mat_<float> & modes(void) const {return _basis;} // Sampled basis (one column per mode)
+
+private:
+    int _order;
+    int _Nmodes;
+    int _size; // Size of the pupil grid (0 if slope basis)
+    int _Nsub; // Number of subapertures (0 if pupil basis)
+    cv::Mat_<float> _basis; // Samples x modes (row-major, continuous)
+    cv::Mat_<float> _pinv; // Modes x samples (row-major, continuous)
+};
+
+} // namespace
+
+#endif
@@ -0,0 +1,782 @@
+/***************************************************************************//**
+ * @file	AsyncLog.cpp
+ * @brief	Source file of the asynchronous back-end of the log
+ *
+ * This file contains all the implementations for the functions defined in:
+ * api/include/AsyncLog.hpp
+ *
+ * Each thread owns a single-producer single-consumer ring of records. The
+ * calling thread only takes a timestamp and copies the arguments into the
+ * next slot; a background thread empties the rings, merges the records by
+ * time and hands them to the sink in batches.
+ *
+ * @author	Thibaud Talon
+ * @date	18/10/2026
+ *******************************************************************************/
+
+#include <stdio.h>
+#include <stdarg.h>
+#include <stdlib.h> // atexit
+#include <string.h> // memcpy, strchr, strlen
+#include <stdint.h>
+#include <stddef.h> // ptrdiff_t
+#include <time.h>
+#include <sched.h> // sched_yield
+#include <pthread.h>
+#include <new> // std::nothrow
+#include <vector>
+#include <algorithm> // std::stable_sort
+#include "AsyncLog.hpp"
+
+namespace UserInterface {
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Conversion specifications of a format
+ ******************************************************************************/
+enum Log_ArgType{
+    ARG_NONE = 0, // Invalid specification (written as it is)
+    ARG_PERCENT, // %%
+    ARG_INT, ARG_LONG, ARG_LLONG, ARG_SIZE, ARG_INTMAX, ARG_PTRDIFF,
+    ARG_DOUBLE, ARG_LDOUBLE,
+    ARG_STRING,
+    ARG_POINTER,
+    ARG_COUNT, // %n (ignored)
+};
+
+struct Log_Spec{
+    Log_ArgType type;
+    int Nstars; // Width and precision given as arguments
+    const char * begin; // '%'
+    const char * end; // After the conversion
+};
+
+static const char * parseSpec(const char * p, Log_Spec & spec){
+    spec.begin = p;
+    spec.Nstars = 0;
+    spec.type = ARG_NONE;
+    p++;
+    if ( *p == '%' ) {spec.type = ARG_PERCENT; spec.end = p + 1; return spec.end;}
+
+    // Flags, width, precision
+    while ( *p != 0 && strchr("-+ #0'", *p) != NULL ) p++;
+    if ( *p == '*' ) {spec.Nstars++; p++;}
+    else while ( *p >= '0' && *p <= '9' ) p++;
+    if ( *p == '.' ){
+        p++;
+        if ( *p == '*' ) {spec.Nstars++; p++;}
+        else while ( *p >= '0' && *p <= '9' ) p++;
+    }
+
+    // Length
+    char length = 0;
+    switch( *p ){
+    case 'h': p++; if ( *p == 'h' ) p++; length = 'h'; break;
+    case 'l': p++; if ( *p == 'l' ) {p++; length = 'q';} else length = 'l'; break;
+    case 'q': case 'z': case 'j': case 't': case 'L': length = *p; p++; break;
+    }
+
+    // Conversion
+    char conversion = *p;
+    if ( conversion != 0 ) p++;
+    switch( conversion ){
+    case 'd': case 'i': case 'u': case 'o': case 'x': case 'X':
+        switch( length ){
+        case 'l': spec.type = ARG_LONG; break;
+        case 'q': spec.type = ARG_LLONG; break;
+        case 'z': spec.type = ARG_SIZE; break;
+        case 'j': spec.type = ARG_INTMAX; break;
+        case 't': spec.type = ARG_PTRDIFF; break;
+        default: spec.type = ARG_INT; break;
+        }
+        break;
+    case 'c': spec.type = ARG_INT; break;
+    case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+        spec.type = (length == 'L') ? ARG_LDOUBLE : ARG_DOUBLE; break;
+    case 's': spec.type = ARG_STRING; break;
+    case 'p': spec.type = ARG_POINTER; break;
+    case 'n': spec.type = ARG_COUNT; break;
+    }
+    spec.end = p;
+    return p;
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Copy the arguments of a format
+ *
+ * Integers and pointers are stored as 64 bits and floating points as double,
+ * so that the records do not depend on the sizes of the platform. Strings
+ * are copied (truncated when the record is full).
+ *
+ * @param [in] fmt
+ *	Format
+ * @param [in] va
+ *	Arguments
+ * @param [out] args
+ *	Packed arguments
+ * @param [in] size
+ *	Size of args
+ ******************************************************************************/
+static bool putValue(char * args, int size, int & used, int64_t value){
+    if ( used + (int)sizeof(value) > size ) return false;
+    memcpy(args + used, &value, sizeof(value));
+    used += sizeof(value);
+    return true;
+}
+
+int packLogArguments(const char * fmt, va_list va, char * args, int size){
+    int used = 0;
+    const char * p = fmt;
+    while ( (p = strchr(p, '%')) != NULL ){
+        Log_Spec spec;
+        p = parseSpec(p, spec);
+        if ( spec.type == ARG_NONE || spec.type == ARG_PERCENT ) continue;
+
+        for(int s = 0; s < spec.Nstars; s++) if ( !putValue(args, size, used, va_arg(va, int)) ) return used;
+
+        bool ok = true;
+        switch( spec.type ){
+        case ARG_INT: ok = putValue(args, size, used, va_arg(va, int)); break;
+        case ARG_LONG: ok = putValue(args, size, used, va_arg(va, long)); break;
+        case ARG_LLONG: ok = putValue(args, size, used, va_arg(va, long long)); break;
+        case ARG_SIZE: ok = putValue(args, size, used, (int64_t) va_arg(va, size_t)); break;
+        case ARG_INTMAX: ok = putValue(args, size, used, va_arg(va, intmax_t)); break;
+        case ARG_PTRDIFF: ok = putValue(args, size, used, va_arg(va, ptrdiff_t)); break;
+        case ARG_POINTER: ok = putValue(args, size, used, (int64_t)(intptr_t) va_arg(va, void *)); break;
+        case ARG_COUNT: va_arg(va, void *); break;
+        case ARG_DOUBLE:
+        case ARG_LDOUBLE:{
+            double value = (spec.type == ARG_DOUBLE) ? va_arg(va, double) : (double) va_arg(va, long double);
+            if ( used + (int)sizeof(value) > size ) {ok = false; break;}
+            memcpy(args + used, &value, sizeof(value));
+            used += sizeof(value);
+            break;
+        }
+        case ARG_STRING:{
+            const char * s = va_arg(va, const char *);
+            if ( s == NULL ) s = "(null)";
+            int room = size - used - 1;
+            if ( room < 0 ) {ok = false; break;}
+            int length = 0;
+            while ( length < room && s[length] != 0 ) length++;
+            memcpy(args + used, s, length);
+            args[used + length] = 0;
+            used += length + 1;
+            break;
+        }
+        default: break;
+        }
+        if ( !ok ) return used;
+    }
+    return used;
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * printf of a format with packed arguments
+ *
+ * Each specification is given to snprintf on its own with the argument cast
+ * back to the type of the specification. The message ends with "..." if the
+ * arguments were truncated.
+ *
+ * @param [in] fmt
+ *	Format
+ * @param [in] args
+ *	Packed arguments (packLogArguments)
+ * @param [in] Nbytes
+ *	Bytes used in args
+ * @param [out] out
+ *	Message
+ * @param [in] size
+ *	Size of out
+ ******************************************************************************/
+template<typename T>
+static int formatValue(char * out, int size, const char * spec, int Nstars, const int * stars, T value){
+    switch( Nstars ){
+    case 0: return snprintf(out, size, spec, value);
+    case 1: return snprintf(out, size, spec, stars[0], value);
+    default: return snprintf(out, size, spec, stars[0], stars[1], value);
+    }
+}
+
+static bool takeValue(const char * args, int Nbytes, int & pos, int64_t & value){
+    if ( pos + (int)sizeof(value) > Nbytes ) return false;
+    memcpy(&value, args + pos, sizeof(value));
+    pos += sizeof(value);
+    return true;
+}
+
+static void appendText(char * out, int size, int & length, const char * text, int N){
+    if ( N > size - 1 - length ) N = size - 1 - length;
+    if ( N <= 0 ) return;
+    memcpy(out + length, text, N);
+    length += N;
+}
+
+int formatLogArguments(const char * fmt, const char * args, int Nbytes, char * out, int size){
+    int length = 0, pos = 0;
+    if ( size <= 0 ) return 0;
+    const char * p = fmt;
+    while ( *p != 0 && length < size - 1 ){
+        // Text up to the next specification
+        const char * next = strchr(p, '%');
+        if ( next == NULL ) next = p + strlen(p);
+        appendText(out, size, length, p, next - p);
+        if ( *next == 0 ) break;
+
+        Log_Spec spec;
+        p = parseSpec(next, spec);
+        if ( spec.type == ARG_PERCENT ) {appendText(out, size, length, "%", 1); continue;}
+        if ( spec.type == ARG_NONE || spec.end - spec.begin >= 32 ) {appendText(out, size, length, spec.begin, spec.end - spec.begin); continue;}
+        if ( spec.type == ARG_COUNT ) continue;
+
+        // Arguments
+        bool ok = true;
+        int stars[2] = {0, 0};
+        int64_t value = 0;
+        for(int s = 0; s < spec.Nstars && ok; s++) {ok = takeValue(args, Nbytes, pos, value); stars[s] = (int)value;}
+        char specText[32];
+        memcpy(specText, spec.begin, spec.end - spec.begin);
+        specText[spec.end - spec.begin] = 0;
+
+        int n = 0;
+        char * o = out + length;
+        int room = size - length;
+        if ( ok ){
+            switch( spec.type ){
+            case ARG_STRING:{
+                const char * s = args + pos;
+                int l = 0;
+                while ( pos + l < Nbytes && s[l] != 0 ) l++;
+                if ( pos + l >= Nbytes ) {ok = false; break;}
+                n = formatValue(o, room, specText, spec.Nstars, stars, s);
+                pos += l + 1;
+                break;
+            }
+            case ARG_DOUBLE:
+            case ARG_LDOUBLE:{
+                double d;
+                if ( pos + (int)sizeof(d) > Nbytes ) {ok = false; break;}
+                memcpy(&d, args + pos, sizeof(d));
+                pos += sizeof(d);
+                if ( spec.type == ARG_DOUBLE ) n = formatValue(o, room, specText, spec.Nstars, stars, d);
+                else n = formatValue(o, room, specText, spec.Nstars, stars, (long double)d);
+                break;
+            }
+            default:
+                if ( !takeValue(args, Nbytes, pos, value) ) {ok = false; break;}
+                switch( spec.type ){
+                case ARG_LONG: n = formatValue(o, room, specText, spec.Nstars, stars, (long)value); break;
+                case ARG_LLONG: n = formatValue(o, room, specText, spec.Nstars, stars, (long long)value); break;
+                case ARG_SIZE: n = formatValue(o, room, specText, spec.Nstars, stars, (size_t)value); break;
+                case ARG_INTMAX: n = formatValue(o, room, specText, spec.Nstars, stars, (intmax_t)value); break;
+                case ARG_PTRDIFF: n = formatValue(o, room, specText, spec.Nstars, stars, (ptrdiff_t)value); break;
+                case ARG_POINTER: n = formatValue(o, room, specText, spec.Nstars, stars, (void *)(intptr_t)value); break;
+                default: n = formatValue(o, room, specText, spec.Nstars, stars, (int)value); break;
+                }
+                break;
+            }
+        }
+        if ( !ok ) {appendText(out, size, length, "...", 3); break;}
+        if ( n > 0 ) length += std::min(n, room - 1);
+    }
+    out[length] = 0;
+    return length;
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Clock anchor of the process: same instant on CLOCK_REALTIME and
+ * CLOCK_MONOTONIC (written in the header of a binary log)
+ ******************************************************************************/
+static pthread_once_t clockOnce = PTHREAD_ONCE_INIT;
+static struct timespec anchorRealtime, anchorMonotonic;
+
+static void initClock(void){
+    clock_gettime(CLOCK_REALTIME, &anchorRealtime);
+    clock_gettime(CLOCK_MONOTONIC, &anchorMonotonic);
+}
+
+void getLogClock(struct timespec & realtime, struct timespec & monotonic){
+    pthread_once(&clockOnce, initClock);
+    realtime = anchorRealtime;
+    monotonic = anchorMonotonic;
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Sink writing the usual tab-separated text lines
+ ******************************************************************************/
+Log_TextSink::Log_TextSink(FILE * file){
+    _file = file;
+    _buffer = new char[LOG_BUFFER_SIZE];
+    _used = 0;
+    _second = -1;
+    _date[0] = 0;
+}
+
+Log_TextSink::~Log_TextSink(void){
+    flush();
+    delete [] _buffer;
+}
+
+void Log_TextSink::append(const Log_Record & record){
+    if ( _used + LOG_MESSAGE_SIZE + 512 > LOG_BUFFER_SIZE ){
+        fwrite(_buffer, 1, _used, _file);
+        _used = 0;
+    }
+
+    // The date changes once per second at most
+    const struct timespec & time = record.time;
+    if ( time.tv_sec != _second ){
+        struct tm local;
+        localtime_r(&time.tv_sec, &local);
+        strftime(_date, sizeof(_date), "%F\t%T", &local);
+        _second = time.tv_sec;
+    }
+
+    char * out = _buffer + _used;
+    int n = sprintf(out, "%s.%06ld\t%.256s\t%i\t", _date, (long)(time.tv_nsec/1000), record.name, record.increment);
+    if ( record.level == LOG_LEVEL_WARNING ) n += sprintf(out + n, "WARNING: ");
+    int m = 0;
+    switch( record.kind ){
+    case LOG_PRINTF: m = formatLogArguments(record.fmt, record.args, record.Nbytes, out + n, LOG_MESSAGE_SIZE); break;
+    case LOG_ERROR: m = snprintf(out + n, LOG_MESSAGE_SIZE, "ERROR = %s (%i)", record.args, record.code); break;
+    default: m = snprintf(out + n, LOG_MESSAGE_SIZE, "NO ERROR (%i)", record.code); break;
+    }
+    n += std::min(std::max(m, 0), LOG_MESSAGE_SIZE - 1);
+    out[n++] = '\n';
+    _used += n;
+}
+
+void Log_TextSink::write(const Log_Record * records, int N){
+    for(int II = 0; II < N; II++) append(records[II]);
+}
+
+void Log_TextSink::writeText(const char * text){
+    fwrite(_buffer, 1, _used, _file);
+    _used = 0;
+    fputs(text, _file);
+}
+
+void Log_TextSink::flush(void){
+    if ( _used > 0 ) fwrite(_buffer, 1, _used, _file);
+    _used = 0;
+    fflush(_file);
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Binary log
+ ******************************************************************************/
+Log_BinarySink::Log_BinarySink(FILE * file){
+    _file = file;
+    _buffer = new char[LOG_BUFFER_SIZE];
+    _used = 0;
+    _previous = 0;
+
+    struct timespec realtime, monotonic;
+    getLogClock(realtime, monotonic);
+    Log_BinaryHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, LOG_BINARY_MAGIC, sizeof(header.magic));
+    header.version = LOG_BINARY_VERSION;
+    header.byteOrder = LOG_BINARY_BYTE_ORDER;
+    header.realtimeSec = realtime.tv_sec;
+    header.realtimeNsec = realtime.tv_nsec;
+    header.monotonicSec = monotonic.tv_sec;
+    header.monotonicNsec = monotonic.tv_nsec;
+    putBytes((const char *) &header, sizeof(header));
+}
+
+Log_BinarySink::~Log_BinarySink(void){
+    flush();
+    fclose(_file);
+    delete [] _buffer;
+}
+
+void Log_BinarySink::reserve(int Nbytes){
+    if ( _used + Nbytes <= LOG_BUFFER_SIZE ) return;
+    fwrite(_buffer, 1, _used, _file);
+    _used = 0;
+}
+
+void Log_BinarySink::putByte(int byte){
+    _buffer[_used++] = (char) byte;
+}
+
+void Log_BinarySink::putVarint(uint64_t value){
+    while ( value >= 0x80 ){
+        _buffer[_used++] = (char)(value | 0x80);
+        value >>= 7;
+    }
+    _buffer[_used++] = (char) value;
+}
+
+void Log_BinarySink::putBytes(const char * bytes, int N){
+    memcpy(_buffer + _used, bytes, N);
+    _used += N;
+}
+
+static uint64_t zigzag(int64_t value){
+    return ((uint64_t) value << 1) ^ (uint64_t)(value >> 63);
+}
+
+uint32_t Log_BinarySink::stringId(const char * text){
+    if ( text == NULL ) return 0;
+    std::map<const char *, uint32_t>::const_iterator it = _ids.find(text);
+    if ( it != _ids.end() ) return it->second;
+
+    uint32_t id = _ids.size() + 1;
+    _ids[text] = id;
+    int length = strlen(text);
+    if ( length > LOG_MESSAGE_SIZE ) length = LOG_MESSAGE_SIZE;
+    reserve(length + 16);
+    putByte(LOG_TAG_STRING);
+    putVarint(id);
+    putVarint(length);
+    putBytes(text, length);
+    return id;
+}
+
+void Log_BinarySink::write(const Log_Record * records, int N){
+    for(int II = 0; II < N; II++){
+        const Log_Record & record = records[II];
+        uint32_t name = stringId(record.name);
+        uint32_t fmt = (record.kind == LOG_PRINTF) ? stringId(record.fmt) : 0;
+        int64_t time = (int64_t) record.time.tv_sec*1000000000LL + record.time.tv_nsec;
+
+        reserve(LOG_ARGS_SIZE + 64);
+        putByte(LOG_TAG_RECORD);
+        putVarint(zigzag(time - _previous));
+        putVarint(name);
+        putVarint(fmt);
+        putVarint((uint32_t) record.increment);
+        putByte(record.level);
+        putByte(record.kind);
+        putVarint(zigzag(record.code));
+        putVarint(record.Nbytes);
+        putBytes(record.args, record.Nbytes);
+        _previous = time;
+    }
+}
+
+void Log_BinarySink::writeText(const char * text){
+    int length = strlen(text);
+    reserve(16);
+    putByte(LOG_TAG_TEXT);
+    putVarint(length);
+    fwrite(_buffer, 1, _used, _file);
+    _used = 0;
+    fwrite(text, 1, length, _file);
+}
+
+void Log_BinarySink::flush(void){
+    if ( _used > 0 ) fwrite(_buffer, 1, _used, _file);
+    _used = 0;
+    fflush(_file);
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Ring of the records of one thread
+ *
+ * head is only written by the thread, tail only by the background thread:
+ * publishing with release stores and reading with acquire loads is enough,
+ * no lock is taken on the way in.
+ ******************************************************************************/
+struct Log_Ring{
+    Log_Record slots[LOG_RING_SIZE];
+    unsigned head; // Next slot to fill
+    unsigned tail; // Next slot to read
+    int closed; // The thread exited
+    Log_Ring * next;
+};
+
+enum Log_State{
+    LOG_IDLE = 0, // Not started yet
+    LOG_RUNNING, // Records go through the background thread
+    LOG_STOPPED, // Records are written by the calling thread
+};
+
+static pthread_once_t logOnce = PTHREAD_ONCE_INIT;
+static pthread_mutex_t logMutex = PTHREAD_MUTEX_INITIALIZER; // Protects the list of rings and the flush tickets
+static pthread_cond_t logWake = PTHREAD_COND_INITIALIZER; // Wakes the background thread
+static pthread_cond_t logFlushed = PTHREAD_COND_INITIALIZER; // Signaled after each pass of the background thread
+static pthread_mutex_t sinkMutex = PTHREAD_MUTEX_INITIALIZER; // Serializes the writes to the sink
+static pthread_key_t ringKey; // Closes the ring when its thread exits
+static pthread_t logThread;
+static int logState = LOG_IDLE;
+static int logStopping = 0;
+static unsigned flushRequested = 0, flushDone = 0;
+static Log_Ring * rings = NULL;
+static Log_Sink * sink = NULL;
+static int logLevel = LOG_COMPILED_LEVEL;
+
+static __thread Log_Ring * threadRing = NULL;
+static __thread Log_Record syncRecord; // Record of the calling thread when the background thread is not running
+
+static bool earlier(const Log_Record & a, const Log_Record & b){
+    return (a.order.tv_sec != b.order.tv_sec) ? a.order.tv_sec < b.order.tv_sec : a.order.tv_nsec < b.order.tv_nsec;
+}
+
+static void closeRing(void * ring){
+    __atomic_store_n(&((Log_Ring *) ring)->closed, 1, __ATOMIC_RELEASE);
+    threadRing = NULL;
+}
+
+static Log_Ring * registerRing(void){
+    Log_Ring * ring = new (std::nothrow) Log_Ring;
+    if ( ring == NULL ) return NULL;
+    ring->head = 0;
+    ring->tail = 0;
+    ring->closed = 0;
+    pthread_mutex_lock(&logMutex);
+    ring->next = rings;
+    rings = ring;
+    pthread_mutex_unlock(&logMutex);
+    pthread_setspecific(ringKey, ring);
+    threadRing = ring;
+    return ring;
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Move the records of every ring into a batch (rings of exited threads are freed)
+ ******************************************************************************/
+static void drainRings(std::vector<Log_Record> & batch){
+    pthread_mutex_lock(&logMutex);
+    Log_Ring ** link = &rings;
+    while ( *link != NULL ){
+        Log_Ring * ring = *link;
+        int closed = __atomic_load_n(&ring->closed, __ATOMIC_ACQUIRE);
+        unsigned head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+        unsigned tail = ring->tail;
+        for(; tail != head; tail++) batch.push_back(ring->slots[tail & (LOG_RING_SIZE - 1)]);
+        __atomic_store_n(&ring->tail, tail, __ATOMIC_RELEASE);
+        if ( closed ) {*link = ring->next; delete ring;}
+        else link = &ring->next;
+    }
+    pthread_mutex_unlock(&logMutex);
+}
+
+static void writeBatch(std::vector<Log_Record> & batch){
+    if ( batch.empty() ) return;
+    std::stable_sort(batch.begin(), batch.end(), earlier); // Each ring is already in order
+    pthread_mutex_lock(&sinkMutex);
+    sink->write(&batch[0], batch.size());
+    sink->flush();
+    pthread_mutex_unlock(&sinkMutex);
+}
+
+static void * logThreadMain(void *){
+    std::vector<Log_Record> batch;
+    batch.reserve(LOG_RING_SIZE);
+    while ( true ){
+        // 1. Sleep for a period, or until a flush is requested
+        pthread_mutex_lock(&logMutex);
+        if ( !logStopping && flushRequested == flushDone ){
+            struct timespec deadline;
+            clock_gettime(CLOCK_REALTIME, &deadline);
+            deadline.tv_nsec += LOG_PERIOD_MS*1000000L;
+            if ( deadline.tv_nsec >= 1000000000L ) {deadline.tv_sec++; deadline.tv_nsec -= 1000000000L;}
+            pthread_cond_timedwait(&logWake, &logMutex, &deadline);
+        }
+        unsigned ticket = flushRequested;
+        int stop = logStopping;
+        pthread_mutex_unlock(&logMutex);
+
+        // 2. Write everything committed so far
+        batch.clear();
+        drainRings(batch);
+        writeBatch(batch);
+
+        pthread_mutex_lock(&logMutex);
+        flushDone = ticket;
+        pthread_cond_broadcast(&logFlushed);
+        pthread_mutex_unlock(&logMutex);
+
+        if ( stop && batch.empty() ) break;
+    }
+    return NULL;
+}
+
+static void startLog(void){
+    pthread_once(&clockOnce, initClock);
+    sink = new Log_TextSink(stdout);
+    if ( pthread_key_create(&ringKey, closeRing) != 0 ) {logState = LOG_STOPPED; return;}
+    if ( pthread_create(&logThread, NULL, logThreadMain, NULL) != 0 ) {logState = LOG_STOPPED; return;}
+    __atomic_store_n(&logState, LOG_RUNNING, __ATOMIC_RELEASE);
+    atexit(stopLog);
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Timestamped slot in the ring of the calling thread
+ *
+ * Waits (yielding) if the ring is full, so no record is ever dropped.
+ ******************************************************************************/
+Log_Record * openLogRecord(void){
+    pthread_once(&logOnce, startLog);
+    Log_Record * record = &syncRecord;
+    if ( __atomic_load_n(&logState, __ATOMIC_ACQUIRE) == LOG_RUNNING ){
+        Log_Ring * ring = threadRing;
+        if ( ring == NULL ) ring = registerRing();
+        if ( ring != NULL ){
+            while ( ring->head - __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE) >= LOG_RING_SIZE && __atomic_load_n(&logState, __ATOMIC_ACQUIRE) == LOG_RUNNING ){
+                pthread_cond_signal(&logWake);
+                sched_yield();
+            }
+            if ( ring->head - ring->tail < LOG_RING_SIZE ) record = &ring->slots[ring->head & (LOG_RING_SIZE - 1)];
+        }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &record->order);
+    clock_gettime(CLOCK_REALTIME, &record->time);
+    return record;
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Hand the record to the background thread (or write it if it is not running)
+ *
+ * A slot opened before stopLog() can be committed after its last drain:
+ * the state is checked again once the record is published and the caller
+ * then writes the rings itself (each record is drained once, under
+ * logMutex).
+ ******************************************************************************/
+void commitLogRecord(Log_Record * record){
+    if ( record == &syncRecord ){
+        pthread_mutex_lock(&sinkMutex);
+        sink->write(record, 1);
+        sink->flush();
+        pthread_mutex_unlock(&sinkMutex);
+        return;
+    }
+    __atomic_store_n(&threadRing->head, threadRing->head + 1, __ATOMIC_RELEASE);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST); // Pairs with the state change of stopLog (before its drain)
+    if ( __atomic_load_n(&logState, __ATOMIC_RELAXED) == LOG_STOPPED ){
+        std::vector<Log_Record> batch;
+        drainRings(batch);
+        writeBatch(batch);
+    }
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Wait until every record committed so far is written
+ ******************************************************************************/
+void flushLog(void){
+    pthread_once(&logOnce, startLog);
+    if ( __atomic_load_n(&logState, __ATOMIC_ACQUIRE) == LOG_RUNNING ){
+        pthread_mutex_lock(&logMutex);
+        unsigned ticket = ++flushRequested;
+        pthread_cond_signal(&logWake);
+        while ( (int)(flushDone - ticket) < 0 && __atomic_load_n(&logState, __ATOMIC_ACQUIRE) == LOG_RUNNING ) pthread_cond_wait(&logFlushed, &logMutex);
+        pthread_mutex_unlock(&logMutex);
+    }
+    pthread_mutex_lock(&sinkMutex);
+    sink->flush();
+    pthread_mutex_unlock(&sinkMutex);
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Write text already formatted, after the pending records
+ ******************************************************************************/
+void writeLogText(const char * text){
+    flushLog();
+    pthread_mutex_lock(&sinkMutex);
+    sink->writeText(text);
+    sink->flush();
+    pthread_mutex_unlock(&sinkMutex);
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Replace the sink after writing the pending records
+ *
+ * @param [in] newSink
+ *	New sink (allocated with new, deleted by the log)
+ ******************************************************************************/
+void setLogSink(Log_Sink * newSink){
+    flushLog();
+    pthread_mutex_lock(&sinkMutex);
+    Log_Sink * oldSink = sink;
+    sink = newSink;
+    pthread_mutex_unlock(&sinkMutex);
+    delete oldSink;
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Lowest level written at runtime
+ *
+ * The levels under LOG_COMPILED_LEVEL are not compiled at all; the others
+ * are checked before anything is copied, so a rejected call costs one load.
+ *
+ * @param [in] level
+ *	LOG_LEVEL_DEBUG, LOG_LEVEL_INFO, LOG_LEVEL_WARNING, LOG_LEVEL_ERROR or LOG_LEVEL_NONE
+ ******************************************************************************/
+void setLogLevel(int level){
+    __atomic_store_n(&logLevel, level, __ATOMIC_RELAXED);
+}
+
+int getLogLevel(void){
+    return __atomic_load_n(&logLevel, __ATOMIC_RELAXED);
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Write the pending records and stop the background thread
+ *
+ * The records logged afterwards (static destructors, ...) are written by
+ * the calling thread.
+ ******************************************************************************/
+void stopLog(void){
+    if ( !__sync_bool_compare_and_swap(&logState, LOG_RUNNING, LOG_STOPPED) ) return; // Full barrier: see commitLogRecord
+
+    pthread_mutex_lock(&logMutex);
+    logStopping = 1;
+    pthread_cond_signal(&logWake);
+    pthread_cond_broadcast(&logFlushed);
+    pthread_mutex_unlock(&logMutex);
+    pthread_join(logThread, NULL);
+
+    // Records committed while the thread was stopping
+    std::vector<Log_Record> batch;
+    drainRings(batch);
+    writeBatch(batch);
+}
+
+}
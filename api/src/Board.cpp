@@ -36,7 +36,7 @@ GPIO_Error GPIO::connect(const char * _pin, GPIO_Direction _dir){
     dir = _dir;
 
     // 1. Export GPIO
-    log.printf("1. Export GPIO %s (%i)", pin, num);
+    log.debug("1. Export GPIO %s (%i)", pin, num);
     std::ofstream exportgpio("/sys/class/gpio/export");
 
     if (exportgpio < 0) {status = GPIO_ERROR; return (GPIO_Error) log.error("Cannot open exoprt file", ERR_GPIO_EXPORT_OPEN);}
@@ -48,7 +48,7 @@ GPIO_Error GPIO::connect(const char * _pin, GPIO_Direction _dir){
     exportgpio.close(); //close export file
 
     // 2. Set direction
-    log.printf("2. Set direction to %i", _dir);
+    log.debug("2. Set direction to %i", _dir);
 
     sprintf(buffer, "/sys/class/gpio/pio%s/direction", pin);
     std::ofstream setdirgpio(buffer);
@@ -72,7 +72,7 @@ GPIO_Error GPIO::connect(int _num, GPIO_Direction _dir){
     dir = _dir;
 
     // 1. Export GPIO
-    log.printf("1. Export GPIO %s (%i)", pin, num);
+    log.debug("1. Export GPIO %s (%i)", pin, num);
     std::ofstream exportgpio("/sys/class/gpio/export");
 
     if (exportgpio < 0) {status = GPIO_ERROR; return (GPIO_Error) log.error("Cannot open exoprt file", ERR_GPIO_EXPORT_OPEN);}
@@ -84,7 +84,7 @@ GPIO_Error GPIO::connect(int _num, GPIO_Direction _dir){
     exportgpio.close(); //close export file
 
     // 2. Set direction
-    log.printf("2. Set direction to %i", _dir);
+    log.debug("2. Set direction to %i", _dir);
     sprintf(buffer, "/sys/class/gpio/pio%s/direction", pin);
     std::ofstream setdirgpio(buffer);
 
@@ -187,7 +187,7 @@ GPIO_Error GPIO::get(int& val){
     getvalgpio >> buffer ;  //read gpio value
 
     val = atoi(buffer);
-    if (verbose) log.printf("Value of pin %s (%i) = %i", pin, num, val);
+    if (verbose) log.debug("Value of pin %s (%i) = %i", pin, num, val);
 
     getvalgpio.close(); //close the value file
 
@@ -0,0 +1,651 @@
+/***************************************************************************//**
+ * @file	Calibration.cpp
+ * @brief	Source file to calibrate the raw frames of the cameras
+ *
+ * This file contains all the implementations for the functions defined in:
+ * api/include/Calibration.hpp
+ *
+ * @author	Thibaud Talon
+ * @date	18/10/2026
+ *******************************************************************************/
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <algorithm> // nth_element
+#include <opencv2/core/core.hpp>
+#include "Calibration.hpp"
+#include "UserInterface.hpp"
+
+namespace Calibration{
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Binary file format (native endianness)
+ *
+ * Header: magic "AACL", version, number of maps
+ * Each map: exposure (int32), gain (float32), rows (int32), cols (int32),
+ *           dark (rows*cols float32), gain (rows*cols float32),
+ *           number of bad pixels (int32), index of bad pixels (int32) [version 2]
+ ******************************************************************************/
+#define CALIBRATION_MAGIC "AACL"
+#define CALIBRATION_VERSION 2
+
+struct Calibration_FileHeader{
+    char magic[4];
+    uint32_t version;
+    uint32_t count;
+};
+
+struct Calibration_MapHeader{
+    int32_t exposure_us;
+    float gain_dB;
+    int32_t rows;
+    int32_t cols;
+};
+
+#define CALIBRATION_GAIN_TOLERANCE 1e-3 // Gains closer than this are the same setting (dB)
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Same exposure and gain (add() and find() must agree)
+ ******************************************************************************/
+static bool sameSetting(const Calibration_Map & map, int exposure_us, float gain_dB){
+    return map.exposure_us == exposure_us && fabs(map.gain_dB - gain_dB) < CALIBRATION_GAIN_TOLERANCE;
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Average a sequence of dark frames
+ *
+ * @param [in] frames
+ *	Dark frames (same size, single channel)
+ * @param [out] dark
+ *	Master dark (ADU)
+ ******************************************************************************/
+Calibration_Error buildMasterDark(const std::vector<cv::Mat> & frames, cv::Mat_<float> & dark){
+    UserInterface::Log log("Calibration::buildMasterDark");
+    try{
+        // 1. Check inputs
+        log.debug("1. Check inputs");
+        if ( frames.empty() ) return (Calibration_Error) log.error("No frames", ERR_CALIBRATION_NO_FRAMES);
+        for(size_t II = 0; II < frames.size(); II++){
+            if ( frames[II].size() != frames[0].size() ) return (Calibration_Error) log.error("Frames of different sizes", ERR_CALIBRATION_FRAME_SIZE);
+            if ( frames[II].channels() != 1 ) return (Calibration_Error) log.error("Frame not single channel", ERR_CALIBRATION_FRAME_TYPE);
+        }
+        log.printf("Number of frames = %i", (int)frames.size());
+
+        // 2. Accumulate the frames
+        log.debug("2. Accumulate the frames");
+        dark = cv::Mat_<float>::zeros(frames[0].rows, frames[0].cols);
+        cv::Mat_<float> frame;
+        for(size_t II = 0; II < frames.size(); II++){
+            frames[II].convertTo(frame, CV_32F);
+            dark += frame;
+        }
+
+        // 3. Average
+        log.debug("3. Average");
+        dark *= 1./frames.size();
+
+        return (Calibration_Error) log.success();
+    }
+    catch( const std::exception& e ){
+        return (Calibration_Error) log.error(e.what(), ERR_DARK_FATAL);
+    }
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Build the flat correction from a sequence of flat frames
+ *
+ * @param [in] frames
+ *	Flat frames (same size as dark, single channel)
+ * @param [in] dark
+ *	Master dark taken with the same exposure and gain as the flats
+ * @param [out] gain
+ *	Inverse of the normalized master flat (0 where the flat has no signal)
+ ******************************************************************************/
+Calibration_Error buildMasterFlat(const std::vector<cv::Mat> & frames, const cv::Mat_<float> & dark, cv::Mat_<float> & gain){
+    UserInterface::Log log("Calibration::buildMasterFlat");
+    try{
+        // 1. Check inputs
+        log.debug("1. Check inputs");
+        if ( frames.empty() ) return (Calibration_Error) log.error("No frames", ERR_CALIBRATION_NO_FRAMES);
+        if ( frames[0].size() != dark.size() ) return (Calibration_Error) log.error("Dark and flat of different sizes", ERR_FLAT_DARK_SIZE);
+
+        // 2. Average the flats
+        log.debug("2. Average the flats");
+        cv::Mat_<float> flat;
+        Calibration_Error error = buildMasterDark(frames, flat);
+        if ( error ) return (Calibration_Error) log.error("Cannot average the flats", error);
+
+        // 3. Remove the dark and normalize
+        log.debug("3. Remove the dark and normalize");
+        flat -= dark;
+        double level = cv::mean(flat)(0);
+        log.printf("Mean flat level = %f ADU", level);
+        if ( level <= 0 ) return (Calibration_Error) log.error("No signal in the flats", ERR_FLAT_NO_SIGNAL);
+
+        // 4. Invert so that the correction is a multiplication
+        log.debug("4. Invert so that the correction is a multiplication");
+        gain.create(flat.rows, flat.cols);
+        int dead = 0;
+        for(int r = 0; r < flat.rows; r++){
+            const float * f = flat[r];
+            float * g = gain[r];
+            for(int c = 0; c < flat.cols; c++){
+                if ( f[c] > 0 ) g[c] = (float)(level/f[c]);
+                else {g[c] = 0; dead++;}
+            }
+        }
+        log.printf("Pixels without signal = %i", dead);
+
+        return (Calibration_Error) log.success();
+    }
+    catch( const std::exception& e ){
+        return (Calibration_Error) log.error(e.what(), ERR_FLAT_FATAL);
+    }
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Precompute the good 8-neighbours of each bad pixel
+ ******************************************************************************/
+static void buildNeighbours(Calibration_BadPixels & badPixels){
+    cv::Mat_<uchar> isBad = cv::Mat_<uchar>::zeros(badPixels.rows, badPixels.cols);
+    for(size_t II = 0; II < badPixels.index.size(); II++) isBad(badPixels.index[II]) = 1;
+
+    badPixels.neighbours.assign(CALIBRATION_NEIGHBOURS*badPixels.index.size(), -1);
+    for(size_t II = 0; II < badPixels.index.size(); II++){
+        int r = badPixels.index[II]/badPixels.cols;
+        int c = badPixels.index[II]%badPixels.cols;
+        int n = 0;
+        for(int dr = -1; dr <= 1; dr++){
+            for(int dc = -1; dc <= 1; dc++){
+                int rr = r + dr, cc = c + dc;
+                if ( (dr == 0 && dc == 0) || rr < 0 || cc < 0 || rr >= badPixels.rows || cc >= badPixels.cols ) continue;
+                if ( isBad(rr, cc) ) continue;
+                badPixels.neighbours[CALIBRATION_NEIGHBOURS*II + n++] = rr*badPixels.cols + cc;
+            }
+        }
+    }
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Find the hot, dead and stuck pixels
+ *
+ * @param [in] dark
+ *	Master dark
+ * @param [in] gain
+ *	Flat correction (see buildMasterFlat)
+ * @param [in] hotSigma
+ *	A pixel is hot if its dark is more than hotSigma standard deviations above the mean
+ * @param [in] gainTolerance
+ *	A pixel is dead or stuck if its flat response is outside [1-gainTolerance; 1+gainTolerance]
+ * @param [out] badPixels
+ *	Sparse list of bad pixels
+ ******************************************************************************/
+Calibration_Error buildBadPixelMap(const cv::Mat_<float> & dark, const cv::Mat_<float> & gain, float hotSigma, float gainTolerance, Calibration_BadPixels & badPixels){
+    UserInterface::Log log("Calibration::buildBadPixelMap");
+    try{
+        // 1. Check inputs
+        log.debug("1. Check inputs");
+        if ( dark.empty() || gain.empty() ) return (Calibration_Error) log.error("No maps", ERR_CALIBRATION_NO_FRAMES);
+        if ( dark.size() != gain.size() ) return (Calibration_Error) log.error("Dark and flat of different sizes", ERR_CALIBRATION_FRAME_SIZE);
+        if ( hotSigma <= 0 || gainTolerance <= 0 ) return (Calibration_Error) log.error("Thresholds out-of-bounds", ERR_BADPIXEL_THRESHOLD);
+
+        // 2. Statistics of the dark (second pass without the outliers of the first one)
+        log.debug("2. Statistics of the dark");
+        cv::Scalar mean, stddev;
+        cv::meanStdDev(dark, mean, stddev);
+        cv::Mat mask = dark < mean(0) + hotSigma*stddev(0);
+        cv::meanStdDev(dark, mean, stddev, mask);
+        float hotLevel = mean(0) + hotSigma*stddev(0);
+        log.printf("Dark = %f +/- %f ADU, hot above %f ADU", mean(0), stddev(0), hotLevel);
+
+        // 3. List the bad pixels
+        log.debug("3. List the bad pixels");
+        badPixels.rows = dark.rows;
+        badPixels.cols = dark.cols;
+        badPixels.index.clear();
+        int hot = 0, dead = 0;
+        for(int r = 0; r < dark.rows; r++){
+            const float * d = dark[r];
+            const float * g = gain[r];
+            for(int c = 0; c < dark.cols; c++){
+                // Response of the pixel relative to the mean (gain is its inverse)
+                float response = g[c] > 0 ? 1.f/g[c] : 0;
+                if ( d[c] > hotLevel ) hot++;
+                else if ( fabs(response - 1.f) > gainTolerance ) dead++;
+                else continue;
+                badPixels.index.push_back(r*dark.cols + c);
+            }
+        }
+        log.printf("Hot pixels = %i", hot);
+        log.printf("Dead or stuck pixels = %i", dead);
+
+        // 4. Precompute the neighbours
+        log.debug("4. Precompute the neighbours");
+        buildNeighbours(badPixels);
+
+        return (Calibration_Error) log.success();
+    }
+    catch( const std::exception& e ){
+        return (Calibration_Error) log.error(e.what(), ERR_BADPIXEL_FATAL);
+    }
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Find the bad pixels from dark and flat sequences
+ *
+ * @param [in] darks
+ *	Dark frames
+ * @param [in] flats
+ *	Flat frames (same exposure and gain as the darks)
+ * @param [in] hotSigma
+ *	A pixel is hot if its dark is more than hotSigma standard deviations above the mean
+ * @param [in] gainTolerance
+ *	A pixel is dead or stuck if its flat response is outside [1-gainTolerance; 1+gainTolerance]
+ * @param [out] badPixels
+ *	Sparse list of bad pixels
+ ******************************************************************************/
+Calibration_Error buildBadPixelMap(const std::vector<cv::Mat> & darks, const std::vector<cv::Mat> & flats, float hotSigma, float gainTolerance, Calibration_BadPixels & badPixels){
+    UserInterface::Log log("Calibration::buildBadPixelMap");
+    Calibration_Error error;
+    cv::Mat_<float> dark, gain;
+
+    if ( (error = buildMasterDark(darks, dark)) ) return (Calibration_Error) log.error("Cannot build dark", error);
+    if ( (error = buildMasterFlat(flats, dark, gain)) ) return (Calibration_Error) log.error("Cannot build flat", error);
+    if ( (error = buildBadPixelMap(dark, gain, hotSigma, gainTolerance, badPixels)) ) return (Calibration_Error) log.error("Cannot build bad pixel map", error);
+
+    return (Calibration_Error) log.success();
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Replace each bad pixel by the median of its good neighbours
+ ******************************************************************************/
+template<typename T>
+static void replaceBadPixels(cv::Mat & img, const Calibration_BadPixels & badPixels){
+    T * data = img.ptr<T>(0);
+    size_t step = img.step[0]/sizeof(T);
+    T values[CALIBRATION_NEIGHBOURS];
+
+    for(size_t II = 0; II < badPixels.index.size(); II++){
+        const int * neighbours = &badPixels.neighbours[CALIBRATION_NEIGHBOURS*II];
+        int n = 0;
+        for(int k = 0; k < CALIBRATION_NEIGHBOURS && neighbours[k] >= 0; k++){
+            values[n++] = data[(neighbours[k]/badPixels.cols)*step + neighbours[k]%badPixels.cols];
+        }
+        if ( n == 0 ) continue;
+        std::nth_element(values, values + n/2, values + n);
+        data[(badPixels.index[II]/badPixels.cols)*step + badPixels.index[II]%badPixels.cols] = values[n/2];
+    }
+}
+
+static bool replaceBadPixels(cv::Mat & img, const Calibration_BadPixels & badPixels){
+    switch( img.depth() ){
+    case CV_8U: replaceBadPixels<uchar>(img, badPixels); return true;
+    case CV_16U: replaceBadPixels<ushort>(img, badPixels); return true;
+    case CV_32F: replaceBadPixels<float>(img, badPixels); return true;
+    default: return false;
+    }
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Replace the bad pixels by the median of their good neighbours (in place)
+ *
+ * @param [in,out] img
+ *	Frame to correct (CV_8U, CV_16U or CV_32F)
+ * @param [in] badPixels
+ *	Sparse list of bad pixels of the sensor
+ ******************************************************************************/
+Calibration_Error correctBadPixels(cv::Mat & img, const Calibration_BadPixels & badPixels){
+    UserInterface::Log log("Calibration::correctBadPixels");
+    try{
+        // 1. Check inputs
+        log.debug("1. Check inputs");
+        if ( img.empty() ) return (Calibration_Error) log.error("No image", ERR_APPLY_NO_IMAGE);
+        if ( img.rows != badPixels.rows || img.cols != badPixels.cols ) return (Calibration_Error) log.error("Bad pixel map and frame of different sizes", ERR_CORRECTBADPIXEL_SIZE);
+        if ( img.channels() != 1 ) return (Calibration_Error) log.error("Frame not single channel", ERR_CALIBRATION_FRAME_TYPE);
+
+        // 2. Replace the bad pixels
+        log.debug("2. Replace %i bad pixels", (int)badPixels.index.size());
+        if ( !replaceBadPixels(img, badPixels) ) return (Calibration_Error) log.error("Unsupported pixel type", ERR_CALIBRATION_FRAME_TYPE);
+
+        return (Calibration_Error) log.success();
+    }
+    catch( const std::exception& e ){
+        return (Calibration_Error) log.error(e.what(), ERR_CORRECTBADPIXEL_FATAL);
+    }
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Fused dark/flat correction of one frame: out = clamp((raw - dark)*gain)
+ *
+ * One pass over the frame, straight float arithmetic on contiguous rows so
+ * that the loop is vectorized. The output keeps the pixel type of the input.
+ ******************************************************************************/
+template<typename T>
+static void correct(const cv::Mat & raw, const Calibration_Map & map, cv::Mat & out, float maxValue){
+    for(int r = 0; r < raw.rows; r++){
+        const T * p = raw.ptr<T>(r);
+        const float * d = map.dark[r];
+        const float * g = map.gain[r];
+        T * q = out.ptr<T>(r);
+        for(int c = 0; c < raw.cols; c++){
+            float v = ((float)p[c] - d[c])*g[c];
+            v = v < 0 ? 0 : v;
+            v = v > maxValue ? maxValue : v;
+            q[c] = (T)(v + 0.5f);
+        }
+    }
+}
+
+template<>
+void correct<float>(const cv::Mat & raw, const Calibration_Map & map, cv::Mat & out, float maxValue){
+    for(int r = 0; r < raw.rows; r++){
+        const float * p = raw.ptr<float>(r);
+        const float * d = map.dark[r];
+        const float * g = map.gain[r];
+        float * q = out.ptr<float>(r);
+        for(int c = 0; c < raw.cols; c++) q[c] = (p[c] - d[c])*g[c];
+    }
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Dark and flat correction in one pass, then bad pixel correction
+ *
+ * @param [in] raw
+ *	Raw frame (CV_8U, CV_16U or CV_32F)
+ * @param [in] map
+ *	Correction maps taken with the same exposure and gain as the frame
+ * @param [out] calibrated
+ *	Corrected frame (same type as raw, can be raw itself)
+ ******************************************************************************/
+Calibration_Error apply(const cv::Mat & raw, const Calibration_Map & map, cv::Mat & calibrated){
+    UserInterface::Log log("Calibration::apply");
+    try{
+        // 1. Check inputs
+        log.debug("1. Check inputs");
+        if ( raw.empty() ) return (Calibration_Error) log.error("No image", ERR_APPLY_NO_IMAGE);
+        if ( map.dark.empty() || map.gain.empty() ) return (Calibration_Error) log.error("No correction maps", ERR_APPLY_NO_MAP);
+        if ( raw.size() != map.dark.size() || raw.size() != map.gain.size() ) return (Calibration_Error) log.error("Maps and frame of different sizes", ERR_APPLY_MAP_SIZE);
+        if ( raw.channels() != 1 ) return (Calibration_Error) log.error("Frame not single channel", ERR_CALIBRATION_FRAME_TYPE);
+
+        // 2. Correct the frame
+        log.debug("2. Correct the frame");
+        calibrated.create(raw.rows, raw.cols, raw.type());
+        switch( raw.depth() ){
+        case CV_8U: correct<uchar>(raw, map, calibrated, 255.f); break;
+        case CV_16U: correct<ushort>(raw, map, calibrated, 65535.f); break;
+        case CV_32F: correct<float>(raw, map, calibrated, 0); break;
+        default: return (Calibration_Error) log.error("Unsupported pixel type", ERR_CALIBRATION_FRAME_TYPE);
+        }
+
+        // 3. Replace the bad pixels
+        if ( !map.badPixels.index.empty() ){
+            log.debug("3. Replace %i bad pixels", (int)map.badPixels.index.size());
+            if ( map.badPixels.rows != raw.rows || map.badPixels.cols != raw.cols ) return (Calibration_Error) log.error("Bad pixel map and frame of different sizes", ERR_CORRECTBADPIXEL_SIZE);
+            replaceBadPixels(calibrated, map.badPixels);
+        }
+
+        return (Calibration_Error) log.success();
+    }
+    catch( const std::exception& e ){
+        return (Calibration_Error) log.error(e.what(), ERR_APPLY_FATAL);
+    }
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Add (or replace) the maps of a setting
+ *
+ * @param [in] map
+ *	Correction maps
+ ******************************************************************************/
+void Calibration_Library::add(const Calibration_Map & map){
+    for(size_t II = 0; II < maps.size(); II++){
+        if ( sameSetting(maps[II], map.exposure_us, map.gain_dB) ){
+            maps[II] = map;
+            return;
+        }
+    }
+    maps.push_back(map);
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Maps of a setting
+ *
+ * @param [in] exposure_us
+ *	Exposure of the frame
+ * @param [in] gain_dB
+ *	Gain of the frame
+ * @return Pointer to the maps, NULL if the setting was not calibrated
+ ******************************************************************************/
+const Calibration_Map * Calibration_Library::find(int exposure_us, float gain_dB) const{
+    for(size_t II = 0; II < maps.size(); II++){
+        if ( sameSetting(maps[II], exposure_us, gain_dB) ) return &maps[II];
+    }
+    return NULL;
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Correct a frame with the maps of its setting
+ *
+ * @param [in] raw
+ *	Raw frame
+ * @param [in] exposure_us
+ *	Exposure of the frame
+ * @param [in] gain_dB
+ *	Gain of the frame
+ * @param [out] calibrated
+ *	Corrected frame
+ ******************************************************************************/
+Calibration_Error Calibration_Library::apply(const cv::Mat & raw, int exposure_us, float gain_dB, cv::Mat & calibrated) const{
+    const Calibration_Map * map = find(exposure_us, gain_dB);
+    if ( map == NULL ){
+        UserInterface::Log log("Calibration_Library::apply");
+        return (Calibration_Error) log.error("No maps for this exposure and gain", ERR_APPLY_NO_MAP);
+    }
+    return Calibration::apply(raw, *map, calibrated);
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Save all the maps to a binary file
+ *
+ * @param [in] filename
+ *	Name of the file
+ ******************************************************************************/
+Calibration_Error Calibration_Library::save(const char * filename) const{
+    UserInterface::Log log("Calibration_Library::save");
+    FILE * file = NULL;
+    try{
+        // 1. Check the maps (the size of the file comes from the dark)
+        log.debug("1. Check the maps");
+        for(size_t II = 0; II < maps.size(); II++){
+            const Calibration_Map & map = maps[II];
+            if ( map.gain.rows != map.dark.rows || map.gain.cols != map.dark.cols ) return (Calibration_Error) log.error("Gain and dark of different sizes", ERR_SAVECAL_MAP_SIZE);
+            if ( map.badPixels.index.empty() ) continue;
+            if ( map.badPixels.rows != map.dark.rows || map.badPixels.cols != map.dark.cols ) return (Calibration_Error) log.error("Bad pixels and dark of different sizes", ERR_SAVECAL_MAP_SIZE);
+            for(size_t JJ = 0; JJ < map.badPixels.index.size(); JJ++)
+                if ( map.badPixels.index[JJ] < 0 || (size_t) map.badPixels.index[JJ] >= map.dark.total() ) return (Calibration_Error) log.error("Bad pixel out of the map", ERR_SAVECAL_MAP_SIZE);
+        }
+
+        // 2. Create new file
+        log.debug("2. Create new file");
+        file = fopen(filename, "wb");
+        if ( file == NULL ) return (Calibration_Error) log.error("Cannot create file", ERR_SAVECAL_OPEN);
+
+        // 3. Write header
+        log.debug("3. Write header (%i maps)", (int)maps.size());
+        Calibration_FileHeader header;
+        memcpy(header.magic, CALIBRATION_MAGIC, 4);
+        header.version = CALIBRATION_VERSION;
+        header.count = maps.size();
+        bool ok = fwrite(&header, sizeof(header), 1, file) == 1;
+
+        // 4. Write maps
+        log.debug("4. Write maps");
+        for(size_t II = 0; II < maps.size() && ok; II++){
+            Calibration_MapHeader mapHeader;
+            mapHeader.exposure_us = maps[II].exposure_us;
+            mapHeader.gain_dB = maps[II].gain_dB;
+            mapHeader.rows = maps[II].dark.rows;
+            mapHeader.cols = maps[II].dark.cols;
+            ok = fwrite(&mapHeader, sizeof(mapHeader), 1, file) == 1;
+
+            cv::Mat_<float> dark = maps[II].dark.isContinuous() ? maps[II].dark : maps[II].dark.clone();
+            cv::Mat_<float> gain = maps[II].gain.isContinuous() ? maps[II].gain : maps[II].gain.clone();
+            size_t N = dark.total();
+            if ( ok ) ok = fwrite(dark.ptr<float>(0), sizeof(float), N, file) == N;
+            if ( ok ) ok = fwrite(gain.ptr<float>(0), sizeof(float), N, file) == N;
+
+            int32_t count = maps[II].badPixels.index.size();
+            if ( ok ) ok = fwrite(&count, sizeof(count), 1, file) == 1;
+            if ( ok && count > 0 ) ok = fwrite(&maps[II].badPixels.index[0], sizeof(int32_t), count, file) == (size_t)count;
+        }
+
+        if ( fclose(file) != 0 ) ok = false;
+        file = NULL;
+        if ( !ok ) return (Calibration_Error) log.error("Cannot write file", ERR_SAVECAL_WRITE);
+
+        return (Calibration_Error) log.success();
+    }
+    catch( const std::exception& e ){
+        if ( file != NULL ) fclose(file);
+        return (Calibration_Error) log.error(e.what(), ERR_SAVECAL_FATAL);
+    }
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Load all the maps from a binary file
+ *
+ * @param [in] filename
+ *	Name of the file
+ ******************************************************************************/
+Calibration_Error Calibration_Library::load(const char * filename){
+    UserInterface::Log log("Calibration_Library::load");
+    FILE * file = NULL;
+    try{
+        // 1. Open file
+        log.debug("1. Open file");
+        file = fopen(filename, "rb");
+        if ( file == NULL ) return (Calibration_Error) log.error("Cannot open file", ERR_LOADCAL_OPEN);
+        uint64_t remaining = 0; // Bytes left to read (bounds the sizes read from the file)
+        if ( fseek(file, 0, SEEK_END) == 0 ){
+            long size = ftell(file);
+            if ( size > 0 ) remaining = (uint64_t) size;
+        }
+        rewind(file);
+
+        // 2. Read header
+        log.debug("2. Read header");
+        Calibration_FileHeader header;
+        if ( fread(&header, sizeof(header), 1, file) != 1 || memcmp(header.magic, CALIBRATION_MAGIC, 4) != 0 || header.version < 1 || header.version > CALIBRATION_VERSION ){
+            fclose(file);
+            return (Calibration_Error) log.error("Not a calibration file", ERR_LOADCAL_FORMAT);
+        }
+        remaining -= std::min(remaining, (uint64_t) sizeof(header));
+        if ( header.count > remaining/sizeof(Calibration_MapHeader) ){
+            fclose(file);
+            return (Calibration_Error) log.error("Number of maps larger than the file", ERR_LOADCAL_FORMAT);
+        }
+        log.printf("Number of maps = %i", header.count);
+
+        // 3. Read maps
+        log.debug("3. Read maps");
+        maps.clear();
+        for(uint32_t II = 0; II < header.count; II++){
+            Calibration_MapHeader mapHeader;
+            Calibration_Map map;
+            bool ok = fread(&mapHeader, sizeof(mapHeader), 1, file) == 1 && mapHeader.rows > 0 && mapHeader.cols > 0;
+            if ( ok ){
+                remaining -= std::min(remaining, (uint64_t) sizeof(mapHeader));
+                uint64_t N = (uint64_t) mapHeader.rows*(uint64_t) mapHeader.cols;
+                ok = N <= remaining/(2*sizeof(float)); // Both maps must be in the file
+            }
+            if ( ok ){
+                map.exposure_us = mapHeader.exposure_us;
+                map.gain_dB = mapHeader.gain_dB;
+                map.dark.create(mapHeader.rows, mapHeader.cols);
+                map.gain.create(mapHeader.rows, mapHeader.cols);
+                size_t N = map.dark.total();
+                ok = fread(map.dark.ptr<float>(0), sizeof(float), N, file) == N
+                  && fread(map.gain.ptr<float>(0), sizeof(float), N, file) == N;
+                remaining -= std::min(remaining, (uint64_t) 2*N*sizeof(float));
+            }
+            if ( ok && header.version >= 2 ){
+                int32_t count = 0;
+                ok = fread(&count, sizeof(count), 1, file) == 1 && count >= 0 && (uint64_t) count <= map.dark.total();
+                if ( ok ){
+                    map.badPixels.rows = mapHeader.rows;
+                    map.badPixels.cols = mapHeader.cols;
+                    map.badPixels.index.resize(count);
+                    if ( count > 0 ) ok = fread(&map.badPixels.index[0], sizeof(int32_t), count, file) == (size_t)count;
+                    remaining -= std::min(remaining, (uint64_t) sizeof(count) + count*sizeof(int32_t));
+                    for(int32_t JJ = 0; ok && JJ < count; JJ++) ok = map.badPixels.index[JJ] >= 0 && (uint64_t) map.badPixels.index[JJ] < map.dark.total(); // Indices written to by the correction
+                    if ( ok ) buildNeighbours(map.badPixels);
+                }
+            }
+            if ( !ok ){
+                fclose(file);
+                return (Calibration_Error) log.error("Cannot read maps", ERR_LOADCAL_READ);
+            }
+            log.printf("Map #%i: exposure = %i us, gain = %f dB, size = %ix%i, bad pixels = %i", II, map.exposure_us, map.gain_dB, map.dark.cols, map.dark.rows, (int)map.badPixels.index.size());
+            maps.push_back(map);
+        }
+        fclose(file);
+
+        return (Calibration_Error) log.success();
+    }
+    catch( const std::exception& e ){
+        if ( file != NULL ) fclose(file);
+        return (Calibration_Error) log.error(e.what(), ERR_LOADCAL_FATAL);
+    }
+}
+
+} // namespace
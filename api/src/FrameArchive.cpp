@@ -0,0 +1,724 @@
+/***************************************************************************//**
+ * @file	FrameArchive.cpp
+ * @brief	Source file to record raw frames in an indexed archive
+ *
+ * This file contains all the implementations for the functions defined in:
+ * api/include/FrameArchive.hpp
+ *
+ * @author	Thibaud Talon
+ * @date	18/10/2026
+ *******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include <stddef.h> // offsetof
+#include <algorithm> // max
+#include <opencv2/core/core.hpp>
+#include "FrameArchive.hpp"
+#include "UserInterface.hpp"
+#include "SpotCodec.hpp"
+
+namespace FrameArchive{
+
+static const char padding[FRAMEARCHIVE_ALIGNMENT] = {0};
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Next multiple of FRAMEARCHIVE_ALIGNMENT
+ ******************************************************************************/
+uint64_t align(uint64_t offset){
+    return (offset + FRAMEARCHIVE_ALIGNMENT - 1)/FRAMEARCHIVE_ALIGNMENT*FRAMEARCHIVE_ALIGNMENT;
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Checksum of a record header (fields before the checksum)
+ ******************************************************************************/
+uint64_t recordChecksum(const FrameArchive_RecordHeader & header){
+    return UserInterface::fletcher64((const uint32_t *) &header, offsetof(FrameArchive_RecordHeader, checksum)/4);
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Create the archive
+ *
+ * @param [in] filename
+ *	Name of the file (truncated if it exists)
+ ******************************************************************************/
+FrameArchive_Error FrameArchive_Writer::open(const char * filename){
+    UserInterface::Log log("FrameArchive::Writer::open");
+    try{
+        // 1. Check inputs
+        log.debug("1. Check inputs");
+        close();
+        if ( filename == NULL || filename[0] == 0 ) return (FrameArchive_Error) log.error("No filename", ERR_CREATE_FILENAME);
+
+        // 2. Create the file
+        log.debug("2. Create the file");
+        _file = fopen(filename, "wb");
+        if ( _file == NULL ) return (FrameArchive_Error) log.error("Cannot create file", ERR_CREATE_OPEN);
+        setvbuf(_file, NULL, _IOFBF, FRAMEARCHIVE_BUFFER_SIZE);
+
+        // 3. File header
+        log.debug("3. File header");
+        FrameArchive_FileHeader header;
+        memset(&header, 0, sizeof(header));
+        memcpy(header.magic, FRAMEARCHIVE_MAGIC, sizeof(header.magic));
+        header.version = FRAMEARCHIVE_VERSION;
+        header.byteOrder = FRAMEARCHIVE_BYTE_ORDER;
+        _offset = align(sizeof(header));
+        if ( fwrite(&header, sizeof(header), 1, _file) != 1 || fwrite(padding, 1, _offset - sizeof(header), _file) != _offset - sizeof(header) ){
+            fclose(_file);
+            _file = NULL;
+            return (FrameArchive_Error) log.error("Cannot write file", ERR_CREATE_WRITE);
+        }
+        _index.clear();
+
+        return (FrameArchive_Error) log.success();
+    }
+    catch( const std::exception& e ){
+        return (FrameArchive_Error) log.error(e.what(), ERR_CREATE_FATAL);
+    }
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Header, rows and padding of a record
+ ******************************************************************************/
+FrameArchive_Error FrameArchive_Writer::writeRecord(FrameArchive_RecordHeader & header, const cv::Mat & frame){
+    header.magic = FRAMEARCHIVE_RECORD_MAGIC;
+    header.checksum = recordChecksum(header);
+
+    uint64_t headerSize = align(sizeof(header));
+    bool written = fwrite(&header, sizeof(header), 1, _file) == 1
+        && fwrite(padding, 1, headerSize - sizeof(header), _file) == headerSize - sizeof(header);
+    size_t rowSize = frame.cols*frame.elemSize();
+    if ( frame.isContinuous() ) written = written && fwrite(frame.data, 1, header.Nbytes, _file) == header.Nbytes;
+    else for(int II = 0; written && II < frame.rows; II++) written = fwrite(frame.ptr(II), 1, rowSize, _file) == rowSize;
+    uint64_t end = align(header.Nbytes);
+    written = written && fwrite(padding, 1, end - header.Nbytes, _file) == end - header.Nbytes;
+    if ( !written ) return ERR_APPEND_WRITE;
+
+    _index.push_back(_offset);
+    _offset += headerSize + end;
+    return OK_FRAMEARCHIVE;
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Append a frame
+ *
+ * @param [in] frame
+ *	Frame to append (any type, ROI allowed)
+ * @param [in] metadata
+ *	Camera, time and settings of the frame
+ * @param [in] encoding
+ *	FRAMEARCHIVE_RAW, or FRAMEARCHIVE_SPOTS to compress the frame without loss
+ ******************************************************************************/
+FrameArchive_Error FrameArchive_Writer::append(const cv::Mat & frame, const FrameArchive_Metadata & metadata, FrameArchive_Encoding encoding){
+    UserInterface::Log log("FrameArchive::Writer::append");
+    try{
+        // 1. Check inputs
+        log.debug("1. Check inputs");
+        if ( _file == NULL ) return (FrameArchive_Error) log.error("Archive not opened", ERR_ARCHIVE_CLOSED);
+        if ( frame.empty() || frame.dims != 2 ) return (FrameArchive_Error) log.error("No frame", ERR_APPEND_FRAME);
+
+        // 2. Encode the frame
+        log.debug("2. Encode the frame");
+        cv::Mat payload = frame;
+        if ( encoding == FRAMEARCHIVE_SPOTS ){
+            if ( SpotCodec::encode(frame, _encoded) ) return (FrameArchive_Error) log.error("Cannot encode the frame", ERR_APPEND_ENCODING);
+            payload = cv::Mat(1, (int) _encoded.size(), CV_8UC1, &_encoded[0]);
+        }
+        else if ( encoding != FRAMEARCHIVE_RAW ) return (FrameArchive_Error) log.error("Encoding not supported", ERR_APPEND_ENCODING);
+
+        // 3. Write the record
+        log.debug("3. Write the record");
+        FrameArchive_RecordHeader header;
+        memset(&header, 0, sizeof(header));
+        header.encoding = encoding;
+        header.rows = frame.rows;
+        header.cols = frame.cols;
+        header.type = frame.type();
+        header.Nbytes = (uint64_t) payload.total()*payload.elemSize();
+        header.metadata = metadata;
+        if ( writeRecord(header, payload) ) return (FrameArchive_Error) log.error("Cannot write file", ERR_APPEND_WRITE);
+
+        return (FrameArchive_Error) log.success();
+    }
+    catch( const std::exception& e ){
+        return (FrameArchive_Error) log.error(e.what(), ERR_APPEND_FATAL);
+    }
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Append a frame already encoded by SpotCodec (encoded on another thread)
+ *
+ * @param [in] data
+ *	Output of SpotCodec::encode
+ * @param [in] rows, cols, type
+ *	Frame before encoding
+ * @param [in] metadata
+ *	Camera, time and settings of the frame
+ ******************************************************************************/
+FrameArchive_Error FrameArchive_Writer::append(const std::vector<uchar> & data, int rows, int cols, int type, const FrameArchive_Metadata & metadata){
+    UserInterface::Log log("FrameArchive::Writer::append");
+    try{
+        // 1. Check inputs
+        log.debug("1. Check inputs");
+        if ( _file == NULL ) return (FrameArchive_Error) log.error("Archive not opened", ERR_ARCHIVE_CLOSED);
+        if ( data.empty() || rows <= 0 || cols <= 0 ) return (FrameArchive_Error) log.error("No frame", ERR_APPEND_FRAME);
+
+        // 2. Write the record
+        log.debug("2. Write the record");
+        FrameArchive_RecordHeader header;
+        memset(&header, 0, sizeof(header));
+        header.encoding = FRAMEARCHIVE_SPOTS;
+        header.rows = rows;
+        header.cols = cols;
+        header.type = type;
+        header.Nbytes = data.size();
+        header.metadata = metadata;
+        if ( writeRecord(header, cv::Mat(1, (int) data.size(), CV_8UC1, (void *) &data[0])) ) return (FrameArchive_Error) log.error("Cannot write file", ERR_APPEND_WRITE);
+
+        return (FrameArchive_Error) log.success();
+    }
+    catch( const std::exception& e ){
+        return (FrameArchive_Error) log.error(e.what(), ERR_APPEND_FATAL);
+    }
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Write the index and the footer, then close the file
+ ******************************************************************************/
+FrameArchive_Error FrameArchive_Writer::close(void){
+    if ( _file == NULL ) return OK_FRAMEARCHIVE;
+    UserInterface::Log log("FrameArchive::Writer::close");
+    try{
+        // 1. Index and footer
+        log.debug("1. Index and footer (%i frames)", (int)_index.size());
+        FrameArchive_Footer footer;
+        memset(&footer, 0, sizeof(footer));
+        footer.indexOffset = _offset;
+        footer.Nframes = _index.size();
+        footer.checksum = _index.empty() ? 0 : UserInterface::fletcher64((const uint32_t *) &_index[0], _index.size()*2);
+        memcpy(footer.magic, FRAMEARCHIVE_INDEX_MAGIC, sizeof(footer.magic));
+        bool written = (_index.empty() || fwrite(&_index[0], sizeof(uint64_t), _index.size(), _file) == _index.size())
+            && fwrite(&footer, sizeof(footer), 1, _file) == 1;
+
+        // 2. Close the file
+        log.debug("2. Close the file");
+        if ( fclose(_file) != 0 ) written = false;
+        _file = NULL;
+        if ( !written ) return (FrameArchive_Error) log.error("Cannot write file", ERR_FINISH_WRITE);
+        log.printf("%i frames, %llu bytes", (int)_index.size(), (unsigned long long)(_offset + _index.size()*sizeof(uint64_t) + sizeof(footer)));
+
+        return (FrameArchive_Error) log.success();
+    }
+    catch( const std::exception& e ){
+        _file = NULL;
+        return (FrameArchive_Error) log.error(e.what(), ERR_FINISH_FATAL);
+    }
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Map the archive and load its index
+ *
+ * Without a valid footer (recording interrupted), the index is rebuilt by
+ * scanning the records up to the last complete one.
+ *
+ * @param [in] filename
+ *	Name of the file
+ ******************************************************************************/
+FrameArchive_Error FrameArchive_Reader::open(const char * filename){
+    UserInterface::Log log("FrameArchive::Reader::open");
+    try{
+        // 1. Map the file
+        log.debug("1. Map the file");
+        close();
+        if ( _file.open(filename) ) return (FrameArchive_Error) log.error("Cannot map file", ERR_OPEN_FILE);
+
+        // 2. Check the header
+        log.debug("2. Check the header");
+        const FrameArchive_FileHeader * header = (const FrameArchive_FileHeader *) _file.data();
+        if ( _file.size() < align(sizeof(FrameArchive_FileHeader)) || memcmp(header->magic, FRAMEARCHIVE_MAGIC, sizeof(header->magic)) != 0 ) {close(); return (FrameArchive_Error) log.error("Not a frame archive", ERR_OPEN_FORMAT);}
+        if ( header->byteOrder != FRAMEARCHIVE_BYTE_ORDER ) {close(); return (FrameArchive_Error) log.error("Byte order not supported", ERR_OPEN_FORMAT);}
+        if ( header->version != FRAMEARCHIVE_VERSION ) {close(); return (FrameArchive_Error) log.error("Version not supported", ERR_OPEN_FORMAT);}
+
+        // 3. Load the index
+        log.debug("3. Load the index");
+        _recovered = !loadIndex();
+        if ( _recovered ){
+            log.warning("No index (recording interrupted?): scanning the records");
+            scanIndex();
+        }
+        log.printf("%i frames", (int)_index.size());
+
+        return (FrameArchive_Error) log.success();
+    }
+    catch( const std::exception& e ){
+        close();
+        return (FrameArchive_Error) log.error(e.what(), ERR_OPEN_FATAL);
+    }
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Index of the footer (false if missing or corrupted)
+ ******************************************************************************/
+bool FrameArchive_Reader::loadIndex(void){
+    size_t size = _file.size();
+    if ( size < align(sizeof(FrameArchive_FileHeader)) + sizeof(FrameArchive_Footer) ) return false;
+    const FrameArchive_Footer * footer = (const FrameArchive_Footer *)(_file.data() + size - sizeof(FrameArchive_Footer));
+    if ( memcmp(footer->magic, FRAMEARCHIVE_INDEX_MAGIC, sizeof(footer->magic)) != 0 ) return false;
+    if ( footer->indexOffset > size - sizeof(FrameArchive_Footer) ) return false;
+    uint64_t indexSize = size - sizeof(FrameArchive_Footer) - footer->indexOffset;
+    if ( indexSize % sizeof(uint64_t) != 0 || footer->Nframes != indexSize/sizeof(uint64_t) ) return false;
+
+    const uint64_t * index = (const uint64_t *)(_file.data() + footer->indexOffset);
+    if ( footer->Nframes > 0 && UserInterface::fletcher64((const uint32_t *) index, footer->Nframes*2) != footer->checksum ) return false;
+    _index.assign(index, index + footer->Nframes);
+    for(size_t II = 0; II < _index.size(); II++) if ( !checkRecord(_index[II], footer->indexOffset) ) {_index.clear(); return false;}
+    return true;
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Index of the complete records
+ ******************************************************************************/
+void FrameArchive_Reader::scanIndex(void){
+    _index.clear();
+    uint64_t size = _file.size();
+    uint64_t offset = align(sizeof(FrameArchive_FileHeader));
+    uint64_t headerSize = align(sizeof(FrameArchive_RecordHeader));
+    while ( checkRecord(offset, size) ){ // Stops at the first incomplete or corrupted record
+        const FrameArchive_RecordHeader * header = (const FrameArchive_RecordHeader *)(_file.data() + offset);
+        _index.push_back(offset);
+        offset += headerSize + align(header->Nbytes);
+    }
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Check a record before trusting its header
+ *
+ * The header must be aligned, carry the magic and a valid checksum, give a
+ * frame of positive size (of exactly Nbytes for a raw frame), and the
+ * record with its padding must end before end.
+ *
+ * @param [in] offset
+ *	Offset of the record in the file
+ * @param [in] end
+ *	End of the records (index or end of file)
+ ******************************************************************************/
+bool FrameArchive_Reader::checkRecord(uint64_t offset, uint64_t end) const{
+    uint64_t headerSize = align(sizeof(FrameArchive_RecordHeader));
+    if ( offset % FRAMEARCHIVE_ALIGNMENT != 0 || end > _file.size() || offset > end || end - offset < headerSize ) return false;
+    const FrameArchive_RecordHeader * header = (const FrameArchive_RecordHeader *)(_file.data() + offset);
+    if ( header->magic != FRAMEARCHIVE_RECORD_MAGIC || header->checksum != recordChecksum(*header) ) return false;
+    if ( header->rows <= 0 || header->cols <= 0 || header->Nbytes == 0 ) return false;
+    if ( header->Nbytes > end - offset - headerSize || align(header->Nbytes) > end - offset - headerSize ) return false;
+    if ( header->encoding == FRAMEARCHIVE_RAW ){
+        if ( (header->type & ~CV_MAT_TYPE_MASK) != 0 || CV_MAT_DEPTH(header->type) > CV_64F ) return false;
+        uint64_t elemSize = CV_ELEM_SIZE(header->type);
+        if ( header->Nbytes % elemSize != 0 || header->Nbytes/elemSize/(uint64_t) header->cols != (uint64_t) header->rows || header->Nbytes/elemSize % (uint64_t) header->cols != 0 ) return false;
+    }
+    return true;
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Header of record k (NULL if out of the archive)
+ ******************************************************************************/
+const FrameArchive_RecordHeader * FrameArchive_Reader::record(int k) const{
+    if ( k < 0 || k >= (int)_index.size() ) return NULL;
+    return (const FrameArchive_RecordHeader *)(_file.data() + _index[k]);
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Read frame k and its metadata
+ *
+ * A raw frame points into the mapping of the file (no copy); writes to it
+ * are private to the process. An encoded frame is decoded.
+ *
+ * @param [in] k
+ *	Index of the frame (0 to size()-1)
+ * @param [out] frame
+ *	Frame
+ * @param [out] metadata
+ *	Camera, time and settings of the frame
+ ******************************************************************************/
+FrameArchive_Error FrameArchive_Reader::read(int k, cv::Mat & frame, FrameArchive_Metadata & metadata){
+    UserInterface::Log log("FrameArchive::Reader::read");
+    try{
+        // 1. Find the record
+        log.debug("1. Find the record %i", k);
+        if ( !isOpened() ) return (FrameArchive_Error) log.error("Archive not opened", ERR_ARCHIVE_CLOSED);
+        const FrameArchive_RecordHeader * header = record(k);
+        if ( header == NULL ) return (FrameArchive_Error) log.error("Frame out of the archive", ERR_READ_INDEX);
+        metadata = header->metadata;
+
+        // 2. Frame on the mapping, or decoded
+        log.debug("2. Frame on the mapping, or decoded");
+        uint64_t offset = _index[k] + align(sizeof(FrameArchive_RecordHeader));
+        switch ( header->encoding ){
+        case FRAMEARCHIVE_RAW:
+            frame = _file.view(offset, header->rows, header->cols, header->type);
+            break;
+        case FRAMEARCHIVE_SPOTS:
+            frame.release(); // Never decode into a frame of the mapping
+            if ( SpotCodec::decode(_file.data() + offset, header->Nbytes, frame) ) return (FrameArchive_Error) log.error("Cannot decode the frame", ERR_READ_ENCODING);
+            break;
+        default:
+            return (FrameArchive_Error) log.error("Encoding not supported", ERR_READ_ENCODING);
+        }
+
+        return (FrameArchive_Error) log.success();
+    }
+    catch( const std::exception& e ){
+        return (FrameArchive_Error) log.error(e.what(), ERR_READ_FATAL);
+    }
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Read the metadata of frame k (the frame is not touched)
+ ******************************************************************************/
+FrameArchive_Error FrameArchive_Reader::read(int k, FrameArchive_Metadata & metadata){
+    const FrameArchive_RecordHeader * header = record(k);
+    if ( header == NULL ) return isOpened() ? ERR_READ_INDEX : ERR_ARCHIVE_CLOSED;
+    metadata = header->metadata;
+    return OK_FRAMEARCHIVE;
+}
+
+void FrameArchive_Reader::close(void){
+    _file.close();
+    _index.clear();
+    _recovered = false;
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Encoding of one frame (run on a worker of FrameArchive_Recorder)
+ *
+ * The task is handed to the recorder at the end of run() and deleted by it
+ * once the frame is written.
+ ******************************************************************************/
+class FrameArchive_Recorder::Task : public ThreadPool_Task{
+public:
+    Task(FrameArchive_Recorder * recorder, int64_t k, FrameArchive_Encoding encoding) :
+        rows(0), cols(0), type(0), error(OK_FRAMEARCHIVE), _recorder(recorder), _k(k), _encoding(encoding) {}
+    void run(void){
+        UserInterface::Log log("FrameArchive::Recorder::encode");
+        try{
+            rows = frame.rows;
+            cols = frame.cols;
+            type = frame.type();
+            if ( _encoding == FRAMEARCHIVE_SPOTS ){
+                if ( SpotCodec::encode(frame, data) ) error = (FrameArchive_Error) log.error("Cannot encode the frame", ERR_APPEND_ENCODING);
+                frame.release(); // Only the encoded frame is kept
+            }
+        }
+        catch( const std::exception& e ){
+            error = (FrameArchive_Error) log.error(e.what(), ERR_APPEND_FATAL);
+            frame.release();
+        }
+        _recorder->write(_k, this); // Last statement: the task may be deleted
+    }
+
+    cv::Mat frame; // Raw frame
+    std::vector<uchar> data; // Encoded frame
+    int rows, cols, type;
+    FrameArchive_Metadata metadata;
+    FrameArchive_Error error;
+
+private:
+    FrameArchive_Recorder * _recorder;
+    int64_t _k; // Number of the frame since open()
+    FrameArchive_Encoding _encoding;
+};
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Start the workers
+ *
+ * @param [in] Nthreads
+ *	Number of encoding threads (0 = number of cores)
+ * @param [in] maxQueued
+ *	Maximum number of frames waiting in the queue
+ ******************************************************************************/
+FrameArchive_Recorder::FrameArchive_Recorder(int Nthreads, int maxQueued) : _pool(Nthreads, std::max(1, maxQueued)) {
+    _segmentFrames = 0;
+    _encoding = FRAMEARCHIVE_SPOTS;
+    _index = NULL;
+    _segment = -1;
+    _segmentCount = 0;
+    _queued = 0;
+    _written = 0;
+    _error = OK_FRAMEARCHIVE;
+    pthread_mutex_init(&_mutex, NULL);
+}
+
+FrameArchive_Recorder::~FrameArchive_Recorder(void){
+    close();
+    pthread_mutex_destroy(&_mutex);
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Start a recording
+ *
+ * @param [in] basename
+ *	Name of the files without extension (<basename>_NNNN.far, <basename>.idx)
+ * @param [in] segmentFrames
+ *	Frames per segment (fps times the duration of a segment)
+ * @param [in] encoding
+ *	FRAMEARCHIVE_SPOTS (lossless compression) or FRAMEARCHIVE_RAW
+ ******************************************************************************/
+FrameArchive_Error FrameArchive_Recorder::open(const char * basename, int segmentFrames, FrameArchive_Encoding encoding){
+    UserInterface::Log log("FrameArchive::Recorder::open");
+    try{
+        // 1. Check inputs
+        log.debug("1. Check inputs");
+        close();
+        if ( basename == NULL || basename[0] == 0 ) return (FrameArchive_Error) log.error("No filename", ERR_CREATE_FILENAME);
+        if ( segmentFrames < 1 ) return (FrameArchive_Error) log.error("Segments must have at least one frame", ERR_RECORD_SEGMENT);
+        if ( encoding != FRAMEARCHIVE_RAW && encoding != FRAMEARCHIVE_SPOTS ) return (FrameArchive_Error) log.error("Encoding not supported", ERR_APPEND_ENCODING);
+
+        // 2. Create the index
+        log.debug("2. Create the index");
+        std::string filename = std::string(basename) + FRAMEARCHIVE_INDEX_EXTENSION;
+        _index = fopen(filename.c_str(), "w");
+        if ( _index == NULL ) return (FrameArchive_Error) log.error("Cannot create the index", ERR_RECORD_INDEX);
+        if ( fprintf(_index, "segment,filename,firstFrame,Nframes,firstTimestamp_ns,lastTimestamp_ns\n") < 0 || fflush(_index) != 0 ){
+            fclose(_index);
+            _index = NULL;
+            return (FrameArchive_Error) log.error("Cannot write the index", ERR_RECORD_INDEX);
+        }
+
+        // 3. Initialize the recording
+        log.debug("3. Initialize the recording");
+        _basename = basename;
+        _segmentFrames = segmentFrames;
+        _encoding = encoding;
+        _segment = -1;
+        _segmentCount = 0;
+        _queued = 0;
+        _written = 0;
+        _error = OK_FRAMEARCHIVE;
+
+        return (FrameArchive_Error) log.success();
+    }
+    catch( const std::exception& e ){
+        return (FrameArchive_Error) log.error(e.what(), ERR_RECORD_FATAL);
+    }
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Queue a frame
+ *
+ * Never waits: when the queue is full the frame is not taken.
+ *
+ * @param [in,out] frame
+ *	Frame to record (released when queued)
+ * @param [in] metadata
+ *	Camera, time and settings of the frame
+ ******************************************************************************/
+FrameArchive_Error FrameArchive_Recorder::append(cv::Mat & frame, const FrameArchive_Metadata & metadata){
+    UserInterface::Log log("FrameArchive::Recorder::append");
+    try{
+        // 1. Check inputs
+        log.debug("1. Check inputs");
+        if ( _index == NULL ) return (FrameArchive_Error) log.error("Recording not started", ERR_ARCHIVE_CLOSED);
+        if ( frame.empty() || frame.dims != 2 ) return (FrameArchive_Error) log.error("No frame", ERR_APPEND_FRAME);
+
+        // 2. Queue the frame
+        log.debug("2. Queue the frame");
+        Task * task = new Task(this, _queued, _encoding);
+        task->frame = frame; // Shares the data
+        task->metadata = metadata;
+        ThreadPool_Error error = _pool.submit(task, false, false);
+        if ( error != OK_THREADPOOL ){
+            delete task;
+            if ( error == ERR_THREADPOOL_FULL ) return (FrameArchive_Error) log.error("Queue full", ERR_QUEUE_FULL);
+            return (FrameArchive_Error) log.error("No worker", ERR_QUEUE_FATAL);
+        }
+        _queued++;
+        frame.release(); // The data now belongs to the task
+
+        return (FrameArchive_Error) log.success();
+    }
+    catch( const std::exception& e ){
+        return (FrameArchive_Error) log.error(e.what(), ERR_QUEUE_FATAL);
+    }
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Write the queued frames, close the last segment and the index
+ *
+ * Returns the first error since open().
+ ******************************************************************************/
+FrameArchive_Error FrameArchive_Recorder::close(void){
+    if ( _index == NULL ) return OK_FRAMEARCHIVE;
+    UserInterface::Log log("FrameArchive::Recorder::close");
+    try{
+        // 1. Wait for the queued frames
+        log.debug("1. Wait for the queued frames");
+        _pool.wait();
+
+        // 2. Close the last segment and the index
+        log.debug("2. Close the last segment and the index");
+        pthread_mutex_lock(&_mutex);
+        closeSegment();
+        if ( fclose(_index) != 0 ) failed((FrameArchive_Error) log.error("Cannot write the index", ERR_RECORD_INDEX));
+        _index = NULL;
+        FrameArchive_Error error = _error;
+        pthread_mutex_unlock(&_mutex);
+        log.printf("%lld frames in %i segments", (long long)_written, _segment + 1);
+
+        return error;
+    }
+    catch( const std::exception& e ){
+        _index = NULL;
+        return (FrameArchive_Error) log.error(e.what(), ERR_STOP_FATAL);
+    }
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Write the frames in order
+ *
+ * The frames are encoded in any order: each one waits in _encoded until
+ * the previous ones are written, and the worker that brings the next
+ * frame writes all those ready.
+ ******************************************************************************/
+void FrameArchive_Recorder::write(int64_t k, Task * task){
+    pthread_mutex_lock(&_mutex);
+    _encoded[k] = task;
+    std::map<int64_t, Task *>::iterator next;
+    while ( (next = _encoded.find(_written)) != _encoded.end() ){
+        task = next->second;
+        _encoded.erase(next);
+        try{
+            writeFrame(_written, task);
+        }
+        catch( const std::exception& e ){
+            UserInterface::Log log("FrameArchive::Recorder::write");
+            failed((FrameArchive_Error) log.error(e.what(), ERR_APPEND_FATAL));
+        }
+        delete task;
+        _written++;
+    }
+    pthread_mutex_unlock(&_mutex);
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Write frame k (called with the mutex locked)
+ *
+ * The first frame of a segment closes the previous archive and creates the
+ * next one. After an error the segment is closed and the rest of its
+ * frames are dropped.
+ ******************************************************************************/
+void FrameArchive_Recorder::writeFrame(int64_t k, Task * task){
+    FrameArchive_Error error;
+
+    // 1. Rollover
+    if ( k % _segmentFrames == 0 ){
+        closeSegment();
+        _segment = (int)(k/_segmentFrames);
+        char suffix[16];
+        snprintf(suffix, sizeof(suffix), "_%04d", _segment);
+        error = _writer.open((_basename + suffix + FRAMEARCHIVE_SEGMENT_EXTENSION).c_str());
+        if ( error ) failed(error);
+    }
+
+    // 2. Append the frame
+    if ( task->error ) {failed(task->error); return;}
+    if ( !_writer.isOpened() ) return; // Segment lost
+    if ( _encoding == FRAMEARCHIVE_SPOTS ) error = _writer.append(task->data, task->rows, task->cols, task->type, task->metadata);
+    else error = _writer.append(task->frame, task->metadata);
+    if ( error ) {failed(error); closeSegment(); return;}
+    if ( _segmentCount == 0 ) _first = task->metadata;
+    _last = task->metadata;
+    _segmentCount++;
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Close the archive of the segment and add it to the index
+ ******************************************************************************/
+void FrameArchive_Recorder::closeSegment(void){
+    if ( !_writer.isOpened() ) return;
+    FrameArchive_Error error = _writer.close();
+    if ( error ) failed(error);
+    if ( _segmentCount == 0 ) _first = _last = FrameArchive_Metadata();
+    if ( fprintf(_index, "%i,%s_%04d%s,%lld,%i,%lld,%lld\n", _segment, _basename.c_str(), _segment, FRAMEARCHIVE_SEGMENT_EXTENSION,
+            (long long)_first.frame, _segmentCount, (long long)_first.timestamp_ns, (long long)_last.timestamp_ns) < 0 || fflush(_index) != 0 ){
+        UserInterface::Log log("FrameArchive::Recorder::closeSegment");
+        failed((FrameArchive_Error) log.error("Cannot write the index", ERR_RECORD_INDEX));
+    }
+    _segmentCount = 0;
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Record the first error (called with the mutex locked)
+ ******************************************************************************/
+void FrameArchive_Recorder::failed(FrameArchive_Error error){
+    if ( _error == OK_FRAMEARCHIVE ) _error = error;
+}
+
+}
@@ -0,0 +1,377 @@
+/***************************************************************************//**
+ * @file	ImageBatch.cpp
+ * @brief	Source file to process sequences of images
+ *
+ * This file contains all the implementations for the functions defined in:
+ * api/include/ImageBatch.hpp
+ *
+ * @author	Thibaud Talon
+ * @date	18/10/2026
+ *******************************************************************************/
+
+#include <pthread.h>
+#include <dirent.h> // opendir
+#include <string.h>
+#include <algorithm> // sort
+#include <opencv2/core/core.hpp>
+#include <opencv2/imgproc/imgproc.hpp>
+#include <opencv2/highgui/highgui.hpp>
+#include "UserInterface.hpp"
+#include "ImageProc.hpp"
+#include "ImageBatch.hpp"
+#include "ThreadPool.hpp"
+
+namespace ImageProc{
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Video source
+ *
+ * @param [in] filename
+ *	Video to read
+ ******************************************************************************/
+ImageProc_VideoSource::ImageProc_VideoSource(const char * filename){
+    _capture.open(filename);
+}
+
+bool ImageProc_VideoSource::read(cv::Mat & frame){
+    cv::Mat raw;
+    if ( !_capture.read(raw) || raw.empty() ) return false;
+    if ( raw.channels() == 3 ) cv::cvtColor(raw, frame, CV_BGR2GRAY);
+    else raw.copyTo(frame); // The capture reuses its buffer
+    return true;
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Directory source
+ *
+ * @param [in] directory
+ *	Directory of the images
+ * @param [in] extension
+ *	Extension of the images to read (e.g. ".png", NULL = all the files)
+ ******************************************************************************/
+ImageProc_DirectorySource::ImageProc_DirectorySource(const char * directory, const char * extension){
+    _next = 0;
+    _opened = false;
+
+    DIR * dir = opendir(directory);
+    if ( dir == NULL ) return;
+    _opened = true;
+
+    size_t Lext = (extension == NULL) ? 0 : strlen(extension);
+    struct dirent * entry;
+    while ( (entry = readdir(dir)) != NULL ){
+        if ( entry->d_name[0] == '.' ) continue; // ., .. and hidden files
+        size_t L = strlen(entry->d_name);
+        if ( extension != NULL && (L < Lext || strcmp(entry->d_name + L - Lext, extension) != 0) ) continue;
+        _files.push_back(std::string(directory) + "/" + entry->d_name);
+    }
+    closedir(dir);
+
+    std::sort(_files.begin(), _files.end());
+}
+
+bool ImageProc_DirectorySource::read(cv::Mat & frame){
+    while ( _next < _files.size() ){
+        frame = cv::imread(_files[_next++], CV_LOAD_IMAGE_ANYDEPTH); // Grayscale, 8 or 16 bits
+        if ( !frame.empty() ) return true; // Skip the files that are not images
+    }
+    return false;
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * List source
+ *
+ * @param [in] frames
+ *	Frames to process (must outlive the source)
+ ******************************************************************************/
+ImageProc_ListSource::ImageProc_ListSource(const std::vector<cv::Mat> & frames) : _frames(frames){
+    _next = 0;
+}
+
+bool ImageProc_ListSource::read(cv::Mat & frame){
+    if ( _next >= _frames.size() ) return false;
+    frame = _frames[_next++];
+    return true;
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Frame archive source
+ *
+ * @param [in] filename
+ *	Name of the archive
+ ******************************************************************************/
+ImageProc_ArchiveSource::ImageProc_ArchiveSource(const char * filename){
+    _next = 0;
+    _archive.open(filename);
+}
+
+bool ImageProc_ArchiveSource::read(cv::Mat & frame){
+    FrameArchive::FrameArchive_Metadata metadata;
+    if ( _next >= _archive.size() ) return false;
+    return _archive.read(_next++, frame, metadata) == FrameArchive::OK_FRAMEARCHIVE;
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Stages
+ ******************************************************************************/
+ImageProc_FilterStage::ImageProc_FilterStage(int threshold_value, int erode_iterations, int dilate_iterations, int order){
+    _threshold = threshold_value;
+    _erode = erode_iterations;
+    _dilate = dilate_iterations;
+    _order = order;
+}
+
+ImageProc_Error ImageProc_FilterStage::run(ImageProc_FrameResult & result) const{
+    cv::Mat filtered;
+    ImageProc_Error error = filter(result.frame, _threshold, _erode, _dilate, filtered, _order);
+    if ( error == OK_IMAGEPROC ) result.frame = filtered;
+    return error;
+}
+
+ImageProc_CutStage::ImageProc_CutStage(int roiLeft, int roiTop, int roiWidth, int roiHeight){
+    _left = roiLeft;
+    _top = roiTop;
+    _width = roiWidth;
+    _height = roiHeight;
+}
+
+ImageProc_Error ImageProc_CutStage::run(ImageProc_FrameResult & result) const{
+    cv::Mat cut_img;
+    ImageProc_Error error = cut(result.frame, _left, _top, _width, _height, cut_img);
+    if ( error == OK_IMAGEPROC ) result.frame = cut_img;
+    return error;
+}
+
+ImageProc_SpotLocStage::ImageProc_SpotLocStage(const std::vector<cv::Rect> & windows, ImageProc_Centroid method, float sigma, int Nmax){
+    _windows = windows;
+    _method = method;
+    _sigma = sigma;
+    _Nmax = Nmax;
+}
+
+ImageProc_Error ImageProc_SpotLocStage::run(ImageProc_FrameResult & result) const{
+    return getSpotLoc(result.frame, _windows, result.spots, _method, _sigma, _Nmax);
+}
+
+ImageProc_SpotsLocStage::ImageProc_SpotsLocStage(float threshold, float minArea, float maxArea, int Nstrips){
+    _threshold = threshold;
+    _minArea = minArea;
+    _maxArea = maxArea;
+    _Nstrips = Nstrips;
+}
+
+ImageProc_Error ImageProc_SpotsLocStage::run(ImageProc_FrameResult & result) const{
+    ImageProc_Blobs blobs;
+    ImageProc_Error error = getSpotsLoc(result.frame, blobs, _threshold, _minArea, _maxArea, _Nstrips);
+    if ( error == OK_IMAGEPROC ) blobs.getSpots(result.spots);
+    return error;
+}
+
+ImageProc_EncircledEnergyStage::ImageProc_EncircledEnergyStage(float energy, float error, int Nmax){
+    _energy = energy;
+    _error = error;
+    _Nmax = Nmax;
+}
+
+ImageProc_Error ImageProc_EncircledEnergyStage::run(ImageProc_FrameResult & result) const{
+    for(int II = 0; II < result.spots.size(); II++){
+        float radius = 0;
+        ImageProc_Error error = getRadiusOfEncircleEnergy(result.frame, result.spots, II, _energy, _error, radius, _Nmax);
+        if ( error ) return error;
+        result.values.push_back(radius);
+    }
+    return OK_IMAGEPROC;
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Frame in flight: runs the chain on a worker and flags its completion
+ ******************************************************************************/
+struct BatchState{
+    pthread_mutex_t mutex;
+    pthread_cond_t done; // Signaled when a frame is done
+};
+
+class FrameTask : public ThreadPool_Task{
+public:
+    ImageProc_FrameResult result;
+    const std::vector<const ImageProc_Stage *> * stages;
+    BatchState * state;
+    bool done;
+
+    void run(void){
+        for(int II = 0; II < (int)stages->size(); II++){
+            ImageProc_Error error;
+            try{
+                error = (*stages)[II]->run(result);
+            }
+            catch( const std::exception& e ){
+                UserInterface::Log log("ImageProc::processFrames");
+                error = (ImageProc_Error) log.error(e.what(), ERR_BATCH_FATAL);
+            }
+            if ( error ) {result.error = error; result.stage = II; break;}
+        }
+        pthread_mutex_lock(&state->mutex); // Always reached: processFrames waits for done
+        done = true;
+        pthread_cond_broadcast(&state->done);
+        pthread_mutex_unlock(&state->mutex);
+    }
+};
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Run a chain of stages on every frame of a sequence
+ *
+ * The frames are read on the calling thread and processed in parallel on a
+ * pool of workers. At most maxInFlight frames are read ahead of the oldest
+ * frame not yet consumed, so the memory is bounded whatever the length of
+ * the sequence. The results are given to the sink in frame order. An error
+ * in a stage is stored in the result of its frame and does not stop the batch.
+ *
+ * @param [in] source
+ *	Frames to process
+ * @param [in] stages
+ *	Chain of stages run on each frame
+ * @param [in] sink
+ *	Consumer of the results
+ * @param [in] Nthreads
+ *	Number of workers (0 = number of cores)
+ * @param [in] maxInFlight
+ *	Maximum number of frames read and not yet consumed (0 = twice the number of workers)
+ ******************************************************************************/
+ImageProc_Error processFrames(ImageProc_FrameSource & source, const std::vector<const ImageProc_Stage *> & stages, ImageProc_ResultSink & sink, int Nthreads, int maxInFlight){
+    UserInterface::Log log("ImageProc::processFrames");
+    try
+    {
+        // 1. Check the inputs
+        log.debug("1. Check the inputs");
+        if ( !source.isOpened() ) return (ImageProc_Error) log.error("Cannot open the source", ERR_BATCH_SOURCE);
+        if ( stages.empty() ) return (ImageProc_Error) log.error("No stage", ERR_BATCH_NO_STAGE);
+        for(size_t II = 0; II < stages.size(); II++) if ( stages[II] == NULL ) return (ImageProc_Error) log.error("No stage", ERR_BATCH_NO_STAGE);
+        if ( maxInFlight < 0 ) return (ImageProc_Error) log.error("Negative number of frames in flight", ERR_BATCH_WINDOW);
+
+        // 2. Start the workers
+        ThreadPool pool(Nthreads);
+        if ( pool.size() == 0 ) return (ImageProc_Error) log.error("Cannot start the workers", ERR_BATCH_POOL);
+        if ( maxInFlight == 0 ) maxInFlight = 2*pool.size();
+        log.debug("2. Start %i workers with %i frames in flight", pool.size(), maxInFlight);
+
+        BatchState state;
+        pthread_mutex_init(&state.mutex, NULL);
+        pthread_cond_init(&state.done, NULL);
+
+        std::vector<FrameTask> slots(maxInFlight); // Frame N uses slot N % maxInFlight
+        for(int II = 0; II < maxInFlight; II++){
+            slots[II].stages = &stages;
+            slots[II].state = &state;
+            slots[II].done = false;
+        }
+
+        // 3. Process the frames
+        log.debug("3. Process the frames");
+        ImageProc_Error error = OK_IMAGEPROC;
+        int Nread = 0; // Frames read
+        int Nconsumed = 0; // Frames given to the sink
+        bool more = true;
+        while ( true ){
+            // Read ahead until the window is full
+            while ( more && Nread - Nconsumed < maxInFlight ){
+                FrameTask & task = slots[Nread % maxInFlight];
+                task.result.frame.release(); // Do not overwrite a frame kept by the sink
+                if ( !source.read(task.result.frame) ) {more = false; break;}
+                task.result.index = Nread;
+                task.result.error = OK_IMAGEPROC;
+                task.result.stage = -1;
+                task.result.spots.clear();
+                task.result.values.clear();
+                task.done = false;
+                if ( pool.submit(&task) ) {more = false; error = (ImageProc_Error) log.error("Cannot queue the frame", ERR_BATCH_POOL); break;}
+                Nread++;
+            }
+            if ( Nconsumed == Nread ) break;
+
+            // Wait for the oldest frame
+            FrameTask & task = slots[Nconsumed % maxInFlight];
+            pthread_mutex_lock(&state.mutex);
+            while ( !task.done ) pthread_cond_wait(&state.done, &state.mutex);
+            pthread_mutex_unlock(&state.mutex);
+
+            if ( error == OK_IMAGEPROC ){
+                if ( task.result.error ) log.printf("Frame %i: stage %i failed (error %i)", task.result.index, task.result.stage, task.result.error);
+                error = sink.consume(task.result);
+                if ( error ) {more = false; log.printf("Stop at frame %i: the sink failed (error %i)", task.result.index, error);}
+            }
+            Nconsumed++;
+        }
+
+        pool.wait();
+        pthread_cond_destroy(&state.done);
+        pthread_mutex_destroy(&state.mutex);
+
+        if ( error ) return (ImageProc_Error) log.error("Batch stopped", error);
+        log.printf("%i frames processed", Nconsumed);
+        return (ImageProc_Error) log.success();
+    }
+    catch(  const std::exception& e  ){
+        return (ImageProc_Error) log.error(e.what(), ERR_BATCH_FATAL);
+    }
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Sink collecting the results in a vector
+ ******************************************************************************/
+class VectorSink : public ImageProc_ResultSink{
+public:
+    VectorSink(std::vector<ImageProc_FrameResult> & results, bool keepFrames) : _results(results), _keepFrames(keepFrames) {}
+
+    ImageProc_Error consume(ImageProc_FrameResult & result){
+        _results.push_back(result); // Deep copy of the spots: the slot of the result is reused
+        if ( !_keepFrames ) _results.back().frame.release();
+        return OK_IMAGEPROC;
+    }
+
+private:
+    std::vector<ImageProc_FrameResult> & _results;
+    bool _keepFrames;
+};
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Run a chain of stages and collect the results
+ *
+ * @param [out] results
+ *	Result of each frame, in frame order
+ * @param [in] keepFrames
+ *	Keep the frame at the end of the chain in each result (memory grows with the sequence)
+ ******************************************************************************/
+ImageProc_Error processFrames(ImageProc_FrameSource & source, const std::vector<const ImageProc_Stage *> & stages, std::vector<ImageProc_FrameResult> & results, bool keepFrames, int Nthreads, int maxInFlight){
+    results.clear();
+    VectorSink sink(results, keepFrames);
+    return processFrames(source, stages, sink, Nthreads, maxInFlight);
+}
+
+} // namespace
@@ -10,6 +10,11 @@
  *******************************************************************************/
 
 #include <math.h>
+#include <float.h> // FLT_MAX
+#include <stdint.h>
+#include <string.h> // memset
+#include <pthread.h>
+#include <algorithm> // nth_element
 #include <opencv2/core/core.hpp>
 #include <opencv2/imgproc/imgproc.hpp>
 #include <opencv2/objdetect/objdetect.hpp> // for getSpotLoc
@@ -20,7 +25,89 @@
 
 namespace ImageProc{
 
-#define nchoosek(n,k) tgamma(n+1)/(tgamma(n-(k)+1)*tgamma(k+1))
+static ImageProc_Error centroidInWindow(const cv::Mat & img, const cv::Rect & window, ImageProc_Centroid method, float sigma, int Nmax, float & x, float & y, float & flux);
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Pixel types supported by the kernels (CV_8U, CV_16U and CV_32F)
+ *
+ * Each kernel is a template on the pixel type: the type is dispatched once
+ * per call with a switch on img.depth(), never inside the pixel loops.
+ ******************************************************************************/
+static bool isSupported(const cv::Mat & img){
+    return img.channels() == 1 && (img.depth() == CV_8U || img.depth() == CV_16U || img.depth() == CV_32F);
+}
+
+static double maxPixelValue(const cv::Mat & img){
+    switch(img.depth()){
+    case CV_8U: return 255;
+    case CV_16U: return 65535;
+    default: return FLT_MAX;
+    }
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Workspace of the calling thread (one per thread, kept in a pthread key)
+ ******************************************************************************/
+static pthread_key_t workspaceKey;
+static pthread_once_t workspaceOnce = PTHREAD_ONCE_INIT;
+
+static void deleteWorkspace(void * workspace){
+    delete (ImageProc_Workspace *) workspace;
+}
+
+static void createWorkspaceKey(void){
+    pthread_key_create(&workspaceKey, deleteWorkspace);
+}
+
+ImageProc_Workspace & ImageProc_Workspace::local(void){
+    pthread_once(&workspaceOnce, createWorkspaceKey);
+    ImageProc_Workspace * workspace = (ImageProc_Workspace *) pthread_getspecific(workspaceKey);
+    if ( workspace == NULL ){
+        workspace = new ImageProc_Workspace;
+        pthread_setspecific(workspaceKey, workspace);
+    }
+    return *workspace;
+}
+
+cv::Mat & ImageProc_Workspace::buffer(Buffer index, cv::Size size, int type){
+    _buffers[index].create(size, type); // No-op if the size and the type did not change
+    return _buffers[index];
+}
+
+struct ImageProc_Workspace::Keypoints{
+    std::vector<cv::KeyPoint> list;
+};
+
+ImageProc_Workspace::~ImageProc_Workspace(void){
+    delete _keypoints;
+}
+
+ImageProc_Workspace::Keypoints & ImageProc_Workspace::keypoints(void){
+    if ( _keypoints == NULL ) _keypoints = new Keypoints;
+    return *_keypoints;
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Copy an image setting the pixels under a threshold to 0 (one pass)
+ ******************************************************************************/
+template<typename T>
+static void thresholdToZero(const cv::Mat & src, cv::Mat & dst, double threshold){
+    const T t = (T)threshold;
+    for(int r = 0; r < src.rows; r++){
+        const T * s = src.ptr<T>(r);
+        T * d = dst.ptr<T>(r);
+        for(int c = 0; c < src.cols; c++) d[c] = (s[c] > t) ? s[c] : (T)0;
+    }
+}
 
 /***************************************************************************//**
  * @author Thibaud Talon
@@ -29,9 +116,9 @@ namespace ImageProc{
  * Filter an image
  *
  * @param [in] img
- *	Image to filter
+ *	Image to filter (CV_8U, CV_16U or CV_32F)
  * @param [in] threshold_value
- *	Value of threshold (0 - 255)(Pixels under the threshold are set to 0)
+ *	Value of threshold (0 - 255 for CV_8U, 0 - 65535 for CV_16U)(Pixels under the threshold are set to 0)
  * @param [in] erode_iterations
  *	Number of erosions to apply
  * @param [in] dilate_iterations
@@ -42,45 +129,277 @@ namespace ImageProc{
  *	If order = 0, erosion first then dilation, otherwise it's the inverse
  ******************************************************************************/
 ImageProc_Error filter(cv::Mat & img, int threshold_value, int erode_iterations, int dilate_iterations, cv::Mat & filtered_img, int order = 0) {
-    // this is intended for use on a Mat with 8 bit elements
     // this filters the image enough so that you can work with the detector while the lights are on
     UserInterface::Log log("ImageProc::filter");
     try
     {
         // 1. Check the inputs
-        log.printf("1. Check the inputs");
+        log.debug("1. Check the inputs");
         if ( img.empty() ) return (ImageProc_Error) log.error("No image", ERR_IMG_MATRIX);
-        if ( threshold_value < 0 ||  threshold_value > 255 )  return (ImageProc_Error) log.error("Threshold out-of-bounds", ERR_FILTER_THRESH); // invalid threshold value
+        if ( !isSupported(img) ) return (ImageProc_Error) log.error("Unsupported pixel type", ERR_IMG_TYPE);
+        if ( threshold_value < 0 ||  threshold_value > maxPixelValue(img) )  return (ImageProc_Error) log.error("Threshold out-of-bounds", ERR_FILTER_THRESH); // invalid threshold value
         if ( erode_iterations < 0  ) return (ImageProc_Error) log.error("Negative number of erosions", ERR_FILTER_ERODE); // invalid erode iterations value
         if ( dilate_iterations < 0  )  return (ImageProc_Error) log.error("Negative number of dilations", ERR_FILTER_DILATE); // invalid dilate iterations value
 
-        img.copyTo(filtered_img);
-
-        // 2. Apply threshold
-        log.printf("2. Apply threshold = %i",threshold_value);
-        cv::threshold( filtered_img, filtered_img, threshold_value, 255,cv::THRESH_TOZERO);
+        // 2. Apply threshold (copy and threshold in one pass, into the workspace)
+        log.debug("2. Apply threshold = %i",threshold_value);
+        ImageProc_Workspace & workspace = ImageProc_Workspace::local();
+        cv::Mat & thresholded = workspace.buffer(ImageProc_Workspace::WS_THRESHOLD, img.size(), img.type());
+        cv::Mat & morphology = workspace.buffer(ImageProc_Workspace::WS_MORPHOLOGY, img.size(), img.type());
+        switch(img.depth()){
+        case CV_8U: thresholdToZero<uchar>(img, thresholded, threshold_value); break;
+        case CV_16U: thresholdToZero<ushort>(img, thresholded, threshold_value); break;
+        case CV_32F: thresholdToZero<float>(img, thresholded, threshold_value); break;
+        }
 
+        // The input is not read anymore: the output can share its data (filtering in place)
+        filtered_img.create(img.size(), img.type());
 
         if(order==0){
             // 3. Apply the erosion operation
-            log.printf("3. Apply the erosion operation = %i",erode_iterations);
-            cv::erode( filtered_img, filtered_img, cv::Mat(),cv::Point(-1,-1),erode_iterations);
+            log.debug("3. Apply the erosion operation = %i",erode_iterations);
+            cv::erode( thresholded, morphology, cv::Mat(),cv::Point(-1,-1),erode_iterations);
 
             // 4. Apply the dilation operation
-            log.printf("4. Apply the dilation operation = %i",dilate_iterations);
-            cv::dilate( filtered_img, filtered_img, cv::Mat(),cv::Point(-1,-1),dilate_iterations);
+            log.debug("4. Apply the dilation operation = %i",dilate_iterations);
+            cv::dilate( morphology, filtered_img, cv::Mat(),cv::Point(-1,-1),dilate_iterations);
         }
         else{
             // 3. Apply the dilation operation
-            log.printf("3. Apply the dilation operation = %i",dilate_iterations);
-            cv::dilate( filtered_img, filtered_img, cv::Mat(),cv::Point(-1,-1),dilate_iterations);
+            log.debug("3. Apply the dilation operation = %i",dilate_iterations);
+            cv::dilate( thresholded, morphology, cv::Mat(),cv::Point(-1,-1),dilate_iterations);
 
             // 4. Apply the erosion operation
-            log.printf("4. Apply the erosion operation = %i",erode_iterations);
-            cv::erode( filtered_img, filtered_img, cv::Mat(),cv::Point(-1,-1),erode_iterations);
+            log.debug("4. Apply the erosion operation = %i",erode_iterations);
+            cv::erode( morphology, filtered_img, cv::Mat(),cv::Point(-1,-1),erode_iterations);
+
+        }
+
+
+        return (ImageProc_Error) log.success();
+    }
+    catch(  const std::exception& e  ){
+        return (ImageProc_Error) log.error(e.what(), ERR_FILTER_FATAL);
+    }
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Integral images of the pixels and of their squares ((rows+1) x (cols+1), CV_64F)
+ ******************************************************************************/
+template<typename T>
+static void integralImages(const cv::Mat & img, cv::Mat & sum, cv::Mat & sqsum){
+    const int cols = img.cols;
+    memset(sum.ptr<double>(0), 0, (cols+1)*sizeof(double));
+    memset(sqsum.ptr<double>(0), 0, (cols+1)*sizeof(double));
+    for(int r = 0; r < img.rows; r++){
+        const T * p = img.ptr<T>(r);
+        const double * s0 = sum.ptr<double>(r);
+        const double * q0 = sqsum.ptr<double>(r);
+        double * s1 = sum.ptr<double>(r+1);
+        double * q1 = sqsum.ptr<double>(r+1);
+        double rowSum = 0, rowSq = 0;
+        s1[0] = 0; q1[0] = 0;
+        for(int c = 0; c < cols; c++){
+            double v = p[c];
+            rowSum += v;
+            rowSq += v*v;
+            s1[c+1] = s0[c+1] + rowSum;
+            q1[c+1] = q0[c+1] + rowSq;
+        }
+    }
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Local threshold of a strip of rows (4 reads per integral image and per pixel)
+ *
+ * The window is clipped at the borders of the image. The output may share
+ * its data with the input: each pixel is read before being written.
+ ******************************************************************************/
+template<typename T>
+static void adaptiveThresholdRows(const cv::Mat & img, const cv::Mat & sum, const cv::Mat & sqsum, int half, ImageProc_Threshold method, float k, float R, int rowStart, int rowEnd, cv::Mat & dst){
+    for(int r = rowStart; r < rowEnd; r++){
+        const int r0 = std::max(0, r - half), r1 = std::min(img.rows, r + half + 1);
+        const double * s0 = sum.ptr<double>(r0);
+        const double * s1 = sum.ptr<double>(r1);
+        const double * q0 = sqsum.ptr<double>(r0);
+        const double * q1 = sqsum.ptr<double>(r1);
+        const T * p = img.ptr<T>(r);
+        T * d = dst.ptr<T>(r);
+        for(int c = 0; c < img.cols; c++){
+            const int c0 = std::max(0, c - half), c1 = std::min(img.cols, c + half + 1);
+            const double area = (double)(r1 - r0)*(c1 - c0);
+            const double mean = (s1[c1] - s0[c1] - s1[c0] + s0[c0])/area;
+            double threshold;
+            if ( method == THRESHOLD_MEAN ) threshold = mean + k;
+            else{
+                double var = (q1[c1] - q0[c1] - q1[c0] + q0[c0])/area - mean*mean;
+                threshold = mean*(1 + k*(sqrt(std::max(var, 0.))/R - 1));
+            }
+            d[c] = (p[c] > threshold) ? p[c] : (T)0;
+        }
+    }
+}
+
+class AdaptiveThresholdBody : public cv::ParallelLoopBody{
+public:
+    AdaptiveThresholdBody(const cv::Mat & img, const cv::Mat & sum, const cv::Mat & sqsum, int half, ImageProc_Threshold method, float k, float R, int Nstrips, cv::Mat & dst) :
+        _img(img), _sum(sum), _sqsum(sqsum), _half(half), _method(method), _k(k), _R(R), _Nstrips(Nstrips), _dst(dst) {}
+    void operator()(const cv::Range & range) const{
+        for(int k = range.start; k < range.end; k++){
+            int rowStart = (int)((long)_img.rows*k/_Nstrips);
+            int rowEnd = (int)((long)_img.rows*(k+1)/_Nstrips);
+            switch( _img.depth() ){
+            case CV_8U: adaptiveThresholdRows<uchar>(_img, _sum, _sqsum, _half, _method, _k, _R, rowStart, rowEnd, _dst); break;
+            case CV_16U: adaptiveThresholdRows<ushort>(_img, _sum, _sqsum, _half, _method, _k, _R, rowStart, rowEnd, _dst); break;
+            case CV_32F: adaptiveThresholdRows<float>(_img, _sum, _sqsum, _half, _method, _k, _R, rowStart, rowEnd, _dst); break;
+            }
+        }
+    }
+private:
+    const cv::Mat & _img;
+    const cv::Mat & _sum;
+    const cv::Mat & _sqsum;
+    int _half;
+    ImageProc_Threshold _method;
+    float _k, _R;
+    int _Nstrips;
+    cv::Mat & _dst;
+};
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Set the pixels under a local threshold to 0
+ *
+ * The local mean and standard deviation come from integral images, so the
+ * cost per pixel does not depend on the size of the window. The strips of
+ * rows are thresholded in parallel.
+ *
+ * @param [in] img
+ *	Image to threshold (CV_8U, CV_16U or CV_32F)
+ * @param [out] thresholded_img
+ *	Thresholded image (may be img)
+ * @param [in] window
+ *	Side of the square window (odd, px)
+ * @param [in] method
+ *	THRESHOLD_MEAN: local mean + k (k in pixel values)
+ *	THRESHOLD_SAUVOLA: local mean * (1 + k*(local std/R - 1))
+ * @param [in] k
+ *	Offset (mean) or sensitivity (Sauvola, k < 0 for bright spots on a dark background)
+ * @param [in] R
+ *	Dynamic range of the standard deviation (Sauvola, 0 = half the range of the pixel type, 0.5 for CV_32F)
+ * @param [in] Nstrips
+ *	Number of strips processed in parallel (0 = number of threads)
+ ******************************************************************************/
+ImageProc_Error adaptiveThreshold(cv::Mat & img, cv::Mat & thresholded_img, int window, ImageProc_Threshold method, float k, float R, int Nstrips){
+    UserInterface::Log log("ImageProc::adaptiveThreshold");
+    try
+    {
+        // 1. Check the inputs
+        log.debug("1. Check the inputs");
+        if ( img.empty() ) return (ImageProc_Error) log.error("No image", ERR_IMG_MATRIX);
+        if ( !isSupported(img) ) return (ImageProc_Error) log.error("Unsupported pixel type", ERR_IMG_TYPE);
+        if ( window < 1 || window % 2 == 0 ) return (ImageProc_Error) log.error("Window not a positive odd size", ERR_ADAPTIVE_WINDOW);
+        if ( method != THRESHOLD_MEAN && method != THRESHOLD_SAUVOLA ) return (ImageProc_Error) log.error("Unknown method", ERR_ADAPTIVE_METHOD);
+        if ( R < 0 ) return (ImageProc_Error) log.error("Negative dynamic range", ERR_ADAPTIVE_RANGE);
+        if ( R == 0 ) R = (img.depth() == CV_32F) ? 0.5f : (float)(maxPixelValue(img) + 1)/2;
+        if ( Nstrips < 0 ) return (ImageProc_Error) log.error("Negative number of strips", ERR_ADAPTIVE_STRIPS);
+        if ( Nstrips == 0 ) Nstrips = cv::getNumThreads();
+        Nstrips = std::max(1, std::min(Nstrips, img.rows));
+
+        // 2. Integral images (in the workspace)
+        log.debug("2. Integral images");
+        cv::Mat src = img; // Keeps the input alive when thresholding in place
+        ImageProc_Workspace & workspace = ImageProc_Workspace::local();
+        cv::Mat & sum = workspace.buffer(ImageProc_Workspace::WS_SUM, cv::Size(src.cols+1, src.rows+1), CV_64F);
+        cv::Mat & sqsum = workspace.buffer(ImageProc_Workspace::WS_SQSUM, cv::Size(src.cols+1, src.rows+1), CV_64F);
+        switch(src.depth()){
+        case CV_8U: integralImages<uchar>(src, sum, sqsum); break;
+        case CV_16U: integralImages<ushort>(src, sum, sqsum); break;
+        case CV_32F: integralImages<float>(src, sum, sqsum); break;
+        }
+
+        // 3. Threshold the strips in parallel
+        log.debug("3. Threshold %i strips in parallel (window = %i, k = %f)", Nstrips, window, k);
+        thresholded_img.create(src.size(), src.type());
+        cv::parallel_for_(cv::Range(0, Nstrips), AdaptiveThresholdBody(src, sum, sqsum, window/2, method, k, R, Nstrips, thresholded_img));
+
+        return (ImageProc_Error) log.success();
+    }
+    catch(  const std::exception& e  ){
+        return (ImageProc_Error) log.error(e.what(), ERR_ADAPTIVE_FATAL);
+    }
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Filter an image with a local threshold
+ *
+ * Same as filter with adaptiveThreshold instead of the global threshold,
+ * for frames with stray light or vignetting.
+ *
+ * @param [in] img
+ *	Image to filter (CV_8U, CV_16U or CV_32F)
+ * @param [in] window
+ *	Side of the square window of the local threshold (odd, px)
+ * @param [in] method
+ *	Local threshold (see adaptiveThreshold)
+ * @param [in] k
+ *	Parameter of the local threshold (see adaptiveThreshold)
+ * @param [in] erode_iterations
+ *	Number of erosions to apply
+ * @param [in] dilate_iterations
+ *	Number of dilations to apply
+ * @param [out] filtered_img
+ *	Returned filtered image
+ * @param [in] order
+ *	If order = 0, erosion first then dilation, otherwise it's the inverse
+ ******************************************************************************/
+ImageProc_Error filter(cv::Mat & img, int window, ImageProc_Threshold method, float k, int erode_iterations, int dilate_iterations, cv::Mat & filtered_img, int order) {
+    UserInterface::Log log("ImageProc::filter");
+    try
+    {
+        // 1. Check the inputs
+        log.debug("1. Check the inputs");
+        if ( erode_iterations < 0  ) return (ImageProc_Error) log.error("Negative number of erosions", ERR_FILTER_ERODE);
+        if ( dilate_iterations < 0  )  return (ImageProc_Error) log.error("Negative number of dilations", ERR_FILTER_DILATE);
+
+        // 2. Apply the local threshold (into the workspace)
+        log.debug("2. Apply local threshold (window = %i)", window);
+        ImageProc_Workspace & workspace = ImageProc_Workspace::local();
+        cv::Mat & thresholded = workspace.buffer(ImageProc_Workspace::WS_THRESHOLD, img.size(), img.type());
+        ImageProc_Error error = adaptiveThreshold(img, thresholded, window, method, k);
+        if ( error ) return (ImageProc_Error) log.error("Cannot apply the local threshold", error);
+        cv::Mat & morphology = workspace.buffer(ImageProc_Workspace::WS_MORPHOLOGY, img.size(), img.type());
+        filtered_img.create(img.size(), img.type());
 
+        if(order==0){
+            // 3. Apply the erosion operation
+            log.debug("3. Apply the erosion operation = %i",erode_iterations);
+            cv::erode( thresholded, morphology, cv::Mat(),cv::Point(-1,-1),erode_iterations);
+
+            // 4. Apply the dilation operation
+            log.debug("4. Apply the dilation operation = %i",dilate_iterations);
+            cv::dilate( morphology, filtered_img, cv::Mat(),cv::Point(-1,-1),dilate_iterations);
         }
+        else{
+            // 3. Apply the dilation operation
+            log.debug("3. Apply the dilation operation = %i",dilate_iterations);
+            cv::dilate( thresholded, morphology, cv::Mat(),cv::Point(-1,-1),dilate_iterations);
 
+            // 4. Apply the erosion operation
+            log.debug("4. Apply the erosion operation = %i",erode_iterations);
+            cv::erode( morphology, filtered_img, cv::Mat(),cv::Point(-1,-1),erode_iterations);
+        }
 
         return (ImageProc_Error) log.success();
     }
@@ -112,7 +431,7 @@ ImageProc_Error cut(cv::Mat & img, int roiLeft, int roiTop, int roiWidth, int ro
     UserInterface::Log log("ImageProc::cut");
     try{
         // 1. Check the inputs
-        log.printf("1. Check the inputs");
+        log.debug("1. Check the inputs");
         if ( img.empty() ) return (ImageProc_Error) log.error("No image", ERR_IMG_MATRIX);
         int width = img.cols;
         int height = img.rows;
@@ -125,7 +444,7 @@ ImageProc_Error cut(cv::Mat & img, int roiLeft, int roiTop, int roiWidth, int ro
         roiHeight = std::min(roiHeight,height - roiTop);
 
         // 2. Perform cut
-        log.printf("2. Perform cut");
+        log.debug("2. Perform cut");
         cut_img = img( cv::Rect(roiLeft, roiTop, roiWidth, roiHeight) );
 
         return (ImageProc_Error) log.success();
@@ -150,24 +469,19 @@ ImageProc_Error getSpotLoc(cv::Mat & img, cv::Mat_<float> & spotPositionArray){
     UserInterface::Log log("ImageProc::getSpotLoc");
     try{
         // 1. Check the inputs
-        log.printf("1. Check the inputs");
+        log.debug("1. Check the inputs");
         if ( img.empty() ) return (ImageProc_Error) log.error("No image", ERR_IMG_MATRIX);
 
-        // 2. Find the center of mass (intensity center)
-        log.printf("2. Find the center of mass (intensity center)");
-        // Get the moments
-        cv::Moments m = cv::moments(img, false);
+        if ( !isSupported(img) ) return (ImageProc_Error) log.error("Unsupported pixel type", ERR_IMG_TYPE);
 
-        // Get the center of mass // If no intensity on image, return {-1; -1}
+        // 2. Find the center of mass (intensity center)
+        log.debug("2. Find the center of mass (intensity center)");
+        // If no intensity on image, return {-1; -1}
+        float x, y, flux;
+        centroidInWindow(img, cv::Rect(0, 0, img.cols, img.rows), CENTROID_COG, 0, 0, x, y, flux);
         spotPositionArray = cv::Mat_<float>(2,1);
-        if (m.m00==0){
-            spotPositionArray(0) = -1;
-            spotPositionArray(1) = -1;
-        }
-        else {
-            spotPositionArray(0) = m.m10/m.m00;
-            spotPositionArray(1) = m.m01/m.m00;
-        }
+        spotPositionArray(0) = x;
+        spotPositionArray(1) = y;
 
         return (ImageProc_Error) log.success();
     }
@@ -178,155 +492,1010 @@ ImageProc_Error getSpotLoc(cv::Mat & img, cv::Mat_<float> & spotPositionArray){
 
 /***************************************************************************//**
  * @author Thibaud Talon
- * @date   21/09/2017
+ * @date   18/10/2026
  *
- * Get all the spots on an imgae
+ * Wrap a (x;y[;size[;flux]]) matrix without copy
  *
- * @param [in] img
- *	Image
- * @param [out] spotsPositionArray
- *	Vector returning the centroid of the light (x; y; size)
- * @param [in] minArea
- *	Minimum area of a spot
- * @param [in] maxArea
- *	Maximum area of a spot
- * @param [in] minCircularity
- *	Minimum circularity of a spot
- * @param [in] maxCircularity
- *	Maximum circularity of a spot
- * @param [in] maxSize
- *	Maximum size ("diameter") of spot
+ * @param [in] positions
+ *	Matrix with one spot per column (the list shares its memory)
  ******************************************************************************/
-ImageProc_Error getSpotsLoc(cv::Mat & img, cv::Mat_<float> & spotsPositionArray, float minArea = 3, float maxArea = 4000000, float minCircularity = 0, float maxCircularity = 1, float maxSize = 2000)
-{
-    UserInterface::Log log("ImageProc::getSpotsLoc");
-    try{
-        // 1. Check the inputs
-        log.printf("1. Check the inputs");
-        if ( img.empty() ) return (ImageProc_Error) log.error("No image", ERR_IMG_MATRIX);
-        if ( maxArea < minArea ) return (ImageProc_Error) log.error("maxArea smaller than minArea", ERR_SPOTSLOC_AREA);
-        if ( maxCircularity < minCircularity ) return (ImageProc_Error) log.error("maxCircularity smaller than minCircularity", ERR_SPOTSLOC_CIRCULARITY);
-        if ( maxSize*maxSize < minArea ) return (ImageProc_Error) log.error("maxSize smaller than minArea", ERR_SPOTSLOC_SIZE);
-
-        // 2. Set the parameters of the blob detector
-        log.printf("2. Set the parameters of the blob detector");
-        cv::SimpleBlobDetector::Params params;
+ImageProc_SpotList::ImageProc_SpotList(const cv::Mat_<float> & positions){
+    if ( positions.rows >= 2 && positions.rows <= SPOT_FIELDS ){
+        data = positions;
+        _size = positions.cols;
+    }
+    else {
+        _size = 0;
+        reserve(0);
+    }
+}
 
-        // Filter by Area
-        params.filterByArea = true;
-        params.minArea = minArea;
-        params.maxArea = maxArea;
-        log.printf("minArea = %f", params.minArea);
-        log.printf("maxArea = %f", params.maxArea);
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Reserve memory for capacity spots (the spots already in the list are kept)
+ *
+ * @param [in] capacity
+ *	Number of spots
+ ******************************************************************************/
+void ImageProc_SpotList::reserve(int capacity){
+    if ( data.rows == SPOT_FIELDS && capacity <= data.cols ) return;
 
-        // Filter by Circularity
-        params.filterByCircularity = true;
-        params.minCircularity  = minCircularity;
-        params.maxCircularity  = maxCircularity;
-        log.printf("minCircularity  = %f", params.minCircularity );
-        log.printf("maxCircularity  = %f", params.maxCircularity );
+    cv::Mat_<float> newData = cv::Mat_<float>::zeros(SPOT_FIELDS, std::max(capacity, 1));
+    if ( _size > 0 ){
+        cv::Mat_<float> spots = newData(cv::Range(0, data.rows), cv::Range(0, _size));
+        data(cv::Range::all(), cv::Range(0, _size)).copyTo(spots);
+    }
+    data = newData;
+}
 
-        // Filter by Inertia
-        params.filterByInertia = false;
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Add a spot (the capacity doubles when the list is full)
+ ******************************************************************************/
+void ImageProc_SpotList::push_back(float x, float y, float size, float flux){
+    if ( _size >= data.cols || data.rows < SPOT_FIELDS ) reserve(std::max(2*_size, 16));
+    data(SPOT_X, _size) = x;
+    data(SPOT_Y, _size) = y;
+    data(SPOT_SIZE, _size) = size;
+    data(SPOT_FLUX, _size) = flux;
+    _size++;
+}
 
-        // Filter by Color
-        params.filterByColor = false;
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Deep copy of a list (the memory of this list is reused when large enough)
+ *
+ * @param [in] other
+ *	List to copy
+ ******************************************************************************/
+ImageProc_SpotList & ImageProc_SpotList::operator=(const ImageProc_SpotList & other){
+    if ( this == &other ) return *this;
+    if ( data.rows != other.data.rows || data.cols < other._size || data.data == other.data.data ) data.create(other.data.rows, std::max(other._size, 1));
+    if ( other._size > 0 ){
+        cv::Mat_<float> spots = data(cv::Range::all(), cv::Range(0, other._size));
+        other.data(cv::Range::all(), cv::Range(0, other._size)).copyTo(spots);
+    }
+    _size = other._size;
+    return *this;
+}
 
-        // Filter by Convexity
-        params.filterByConvexity = false;
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Matrix of the list with one spot per column
+ *
+ * The matrix is continuous: a view on the list when it is full (or wraps a
+ * matrix), a copy otherwise.
+ *
+ * @param [in] fields
+ *	Number of rows: 2 = (x;y), 3 = (x;y;size), 4 = (x;y;size;flux)
+ ******************************************************************************/
+cv::Mat_<float> ImageProc_SpotList::asMat(int fields) const{
+    fields = std::max(1, std::min(fields, data.rows));
+    if ( _size == 0 ) return cv::Mat_<float>(fields, 0);
+    cv::Mat_<float> spots = data(cv::Range(0, fields), cv::Range(0, _size));
+    return spots.isContinuous() ? spots : spots.clone();
+}
 
-        // 3. Detect blobs
-        log.printf("3. Detect blobs");
-        cv::SimpleBlobDetector detector(params);
-        std::vector<cv::KeyPoint> keypoints;
-        detector.detect(img, keypoints);
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Moments of a window of an image (shared kernel of the centroid estimators)
+ *
+ * The moments are taken relative to the top-left corner of the window and
+ * each pixel is weighted by wx[col]*wy[row] (separable weight). The inner
+ * loop runs over 4 independent accumulators so that it maps onto SIMD lanes.
+ ******************************************************************************/
+struct SpotMoments{
+    double m00, m10, m01, m20, m11, m02;
+};
 
-        if ( keypoints.size() == 0 )  return (ImageProc_Error) log.error("No blob detected", ERR_SPOTSLOC_KEYPTS_SIZE);
+template<typename T>
+static void accumulateMoments(const cv::Mat & img, const cv::Rect & window, const float * wx, const float * wy, SpotMoments & m){
+    m.m00 = m.m10 = m.m01 = m.m20 = m.m11 = m.m02 = 0;
+    const int width = window.width;
 
-        // 4. Load Spots into output array
-        log.printf("4. Load Spots into output array");
-        spotsPositionArray = cv::Mat_<float>::zeros(0,3);
-        cv::Mat_<float> data = cv::Mat_<float>::zeros(1,3);
-        ImageProc_Error errorCode = OK_IMAGEPROC;
-        for (int i=0;i<keypoints.size();i++){
-            if ( 4.*keypoints.at(i).size < maxSize ){
-                data(0) = (float)keypoints.at(i).pt.x;
-                data(1) = (float)keypoints.at(i).pt.y;
-                data(2) = 4.*keypoints.at(i).size;
-                spotsPositionArray.push_back( data );
+    for(int r = 0; r < window.height; r++){
+        const T * p = img.ptr<T>(window.y + r) + window.x;
+        double s0[4] = {0,0,0,0}, s1[4] = {0,0,0,0}, s2[4] = {0,0,0,0};
 
-                if ((keypoints.at(i).pt.x - 2*keypoints.at(i).size < 1) ||
-                        (keypoints.at(i).pt.y - 2*keypoints.at(i).size < 1) ||
-                        (keypoints.at(i).pt.x + 2*keypoints.at(i).size > img.cols-1) ||
-                        (keypoints.at(i).pt.y + 2*keypoints.at(i).size > img.rows-1))
-                    log.printf("Spot #%i on the edge of the image", i);
+        int c = 0;
+        for(; c + 4 <= width; c += 4){
+            for(int k = 0; k < 4; k++){
+                float v = (float)p[c+k]*wx[c+k];
+                float x = (float)(c+k);
+                s0[k] += v;
+                s1[k] += v*x;
+                s2[k] += v*x*x;
             }
-
         }
-        spotsPositionArray = spotsPositionArray.t();
+        for(; c < width; c++){
+            float v = (float)p[c]*wx[c];
+            float x = (float)c;
+            s0[0] += v;
+            s1[0] += v*x;
+            s2[0] += v*x*x;
+        }
 
-        return (ImageProc_Error) log.success();
+        double r0 = wy[r]*(s0[0]+s0[1]+s0[2]+s0[3]);
+        double r1 = wy[r]*(s1[0]+s1[1]+s1[2]+s1[3]);
+        double r2 = wy[r]*(s2[0]+s2[1]+s2[2]+s2[3]);
+        m.m00 += r0;
+        m.m10 += r1;
+        m.m20 += r2;
+        m.m01 += r*r0;
+        m.m11 += r*r1;
+        m.m02 += (double)r*r*r0;
     }
-    catch( const std::exception& e ){
-        return (ImageProc_Error) log.error(e.what(), ERR_SPOTSLOC_FATAL);
+}
+
+static bool getMoments(const cv::Mat & img, const cv::Rect & window, const float * wx, const float * wy, SpotMoments & m){
+    switch(img.depth()){
+    case CV_8U: accumulateMoments<uchar>(img, window, wx, wy, m); return true;
+    case CV_16U: accumulateMoments<ushort>(img, window, wx, wy, m); return true;
+    case CV_32F: accumulateMoments<float>(img, window, wx, wy, m); return true;
+    default: return false;
     }
 }
 
 /***************************************************************************//**
  * @author Thibaud Talon
- * @date   21/09/2017
+ * @date   18/10/2026
  *
- * Find the radius of encircled energy
+ * Unweighted moments of a window with integer arithmetic (8 and 16-bit images)
  *
- * @param [in] img
- *	Image with one unique spot
- * @param [in] center
- *	Center of unique spot
- * @param [in] energy
- *	Percentage of energy inside the circle
- * @param [in] tol
- *	Tolerance on the energy (%)
- * @param [out] radius
- *	Radius of circle in px
- * @param [in] Nmax
- *	Maximum number of iteration
+ * Bounds for 16-bit pixels (v < 2^16), windows of at most 4096 columns and
+ * 4096 rows (c, r < 2^12) and at most 4 MP (2^22 pixels):
+ *  - row sum of v            < 2^12 * 2^16       = 2^28  -> uint32
+ *  - row sums of v*c, v*c^2  < 2^16 * 2^23, 2^16 * 2^35 -> uint64
+ *  - m00                     < 2^22 * 2^16       = 2^38
+ *  - m10, m01                < 2^22 * 2^16 * 2^12 = 2^50
+ *  - m20, m11, m02           < 2^22 * 2^16 * 2^24 = 2^62 -> uint64
+ * m00, m10 and m01 are below 2^53 and so exact in double: the centroid is
+ * bit-identical to a double-precision reference sum. The second moments are exact
+ * integers rounded once when converted to double.
  ******************************************************************************/
-ImageProc_Error getRadiusOfEncircleEnergy(cv::Mat & img, const cv::Mat_<float> & center, float energy, float tol, float & radius, int Nmax = 100)
-{
-    UserInterface::Log log("ImageProc::getRadiusOfEncircleEnergy");
-    try{
-        // 1. Check the inputs
-        log.printf("1. Check the inputs");
-        if ( img.empty() ) return (ImageProc_Error) log.error("No image", ERR_IMG_MATRIX);
-        if ( center.cols != 1) return (ImageProc_Error) log.error("Center not a vector", ERR_ENCIRCLE_CENTER_COLS_OOB);
-        if ( center.rows != 2) return (ImageProc_Error) log.error("Too many centers", ERR_ENCIRCLE_CENTER_ROWS_OOB);
-        if ( energy > 100 || energy < 0) return (ImageProc_Error) log.error("Energy target out-of-bounds", ERR_ENCIRCLE_ENERGY_OOB);
-        if ( tol <= 0 ) return (ImageProc_Error) log.error("Error on energy out-of-bounds", ERR_ENCIRCLE_ERROR_OOB);
+#define MOMENTS_INT_MAX_SIDE 4096
+#define MOMENTS_INT_MAX_PIXELS (1 << 22)
 
-        // 2. Find radius with a binary process
-        log.printf("2. Find radius with a binary process");
-        float Rmax = pow(pow(img.rows,2)+pow(img.cols,2),0.5);
-        float Rmin = 0;
-        float R = (Rmax+Rmin)/2;
-        cv::Mat mask = cv::Mat::zeros(img.size(),CV_8U);
-        int shift = 10;
-        cv::Point centerP;
-        centerP.x = center(0);
-        centerP.y = center(1);
-        cv::circle(mask, centerP, (int)(R*pow(2,shift)), cv::Scalar(255,255,255), -1, CV_AA, shift);
-        cv::Mat masked_img = img.mul(mask/255);
-        float intensity0 = cv::sum(img)(0);
-        float intensity = 100*cv::sum(masked_img)(0)/intensity0;
-        int n = 0;
+template<typename T>
+static void accumulateMomentsInt(const cv::Mat & img, const cv::Rect & window, SpotMoments & m){
+    uint64_t m00 = 0, m10 = 0, m01 = 0, m20 = 0, m11 = 0, m02 = 0;
+    const uint32_t width = window.width;
 
-        // Binary process
-        while( (fabs(intensity-energy) > tol) && n<Nmax)
-        {
-            log.printf("Error = %f", fabs(intensity-energy));
-            log.printf("Radius = %f", R);
+    for(uint32_t r = 0; r < (uint32_t)window.height; r++){
+        const T * p = img.ptr<T>(window.y + r) + window.x;
+        uint32_t s0[4] = {0,0,0,0};
+        uint64_t s1[4] = {0,0,0,0}, s2[4] = {0,0,0,0};
 
-            // Calculate new radius
-            if ( intensity > energy ) Rmax = R;
+        uint32_t c = 0;
+        for(; c + 4 <= width; c += 4){
+            for(uint32_t k = 0; k < 4; k++){
+                uint32_t v = p[c+k];
+                uint32_t vx = v*(c+k); // < 2^28
+                s0[k] += v;
+                s1[k] += vx;
+                s2[k] += (uint64_t)vx*(c+k);
+            }
+        }
+        for(; c < width; c++){
+            uint32_t v = p[c];
+            uint32_t vx = v*c;
+            s0[0] += v;
+            s1[0] += vx;
+            s2[0] += (uint64_t)vx*c;
+        }
+
+        uint64_t r0 = (uint64_t)s0[0] + s0[1] + s0[2] + s0[3];
+        uint64_t r1 = s1[0] + s1[1] + s1[2] + s1[3];
+        uint64_t r2 = s2[0] + s2[1] + s2[2] + s2[3];
+        m00 += r0;
+        m10 += r1;
+        m20 += r2;
+        m01 += r*r0;
+        m11 += r*r1;
+        m02 += (uint64_t)r*r*r0;
+    }
+
+    m.m00 = (double)m00;
+    m.m10 = (double)m10;
+    m.m01 = (double)m01;
+    m.m20 = (double)m20;
+    m.m11 = (double)m11;
+    m.m02 = (double)m02;
+}
+
+static bool getMomentsInt(const cv::Mat & img, const cv::Rect & window, SpotMoments & m){
+    if ( window.width > MOMENTS_INT_MAX_SIDE || window.height > MOMENTS_INT_MAX_SIDE || window.area() > MOMENTS_INT_MAX_PIXELS ) return false;
+    switch(img.depth()){
+    case CV_8U: accumulateMomentsInt<uchar>(img, window, m); return true;
+    case CV_16U: accumulateMomentsInt<ushort>(img, window, m); return true;
+    default: return false;
+    }
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Constant background of a window: median of the pixels of its border
+ ******************************************************************************/
+template<typename T>
+static double borderMedian(const cv::Mat & img, const cv::Rect & window){
+    std::vector<float> border;
+    border.reserve(2*(window.width + window.height));
+    for(int r = 0; r < window.height; r++){
+        const T * p = img.ptr<T>(window.y + r) + window.x;
+        if ( r == 0 || r == window.height - 1 ) for(int c = 0; c < window.width; c++) border.push_back((float)p[c]);
+        else{
+            border.push_back((float)p[0]);
+            if ( window.width > 1 ) border.push_back((float)p[window.width-1]);
+        }
+    }
+    std::nth_element(border.begin(), border.begin() + border.size()/2, border.end());
+    return border[border.size()/2];
+}
+
+static double getBackground(const cv::Mat & img, const cv::Rect & window){
+    switch(img.depth()){
+    case CV_8U: return borderMedian<uchar>(img, window);
+    case CV_16U: return borderMedian<ushort>(img, window);
+    case CV_32F: return borderMedian<float>(img, window);
+    default: return 0;
+    }
+}
+
+// Remove a constant background from weighted moments (moments of the separable weight alone)
+static void subtractBackground(const float * wx, int width, const float * wy, int height, double background, SpotMoments & m){
+    double x0 = 0, x1 = 0, x2 = 0, y0 = 0, y1 = 0, y2 = 0;
+    for(int c = 0; c < width; c++) {x0 += wx[c]; x1 += (double)c*wx[c]; x2 += (double)c*c*wx[c];}
+    for(int r = 0; r < height; r++) {y0 += wy[r]; y1 += (double)r*wy[r]; y2 += (double)r*r*wy[r];}
+    m.m00 -= background*x0*y0;
+    m.m10 -= background*x1*y0;
+    m.m01 -= background*x0*y1;
+    m.m20 -= background*x2*y0;
+    m.m11 -= background*x1*y1;
+    m.m02 -= background*x0*y2;
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Centroid of a single window (no log, called once per window by the batch)
+ *
+ * CENTROID_GAUSSIAN removes a constant background, the median of the border
+ * of the window, before weighting; a sloped background or a spot reaching
+ * the border of the window still biases the result. It stops when both the
+ * centre and the widths of the weight have converged.
+ *
+ * @param [in] img
+ *	Image (single channel)
+ * @param [in] window
+ *	Window inside the image
+ * @param [in] method
+ *	Centroid estimator (see ImageProc_Centroid)
+ * @param [in] sigma
+ *	Width of the Gaussian weight in px (0 = estimated from the spot)
+ * @param [in] Nmax
+ *	Maximum number of iterations (IWCOG and GAUSSIAN)
+ * @param [out] x, y
+ *	Centroid in image coordinates ({-1;-1} if no intensity in the window)
+ * @param [out] flux
+ *	Sum of the intensity in the window
+ ******************************************************************************/
+static ImageProc_Error centroidInWindow(const cv::Mat & img, const cv::Rect & window, ImageProc_Centroid method, float sigma, int Nmax, float & x, float & y, float & flux){
+    std::vector<float> wx(window.width, 1.f), wy(window.height, 1.f);
+    SpotMoments m;
+
+    x = -1;
+    y = -1;
+
+    // Plain center of gravity, also the starting point of the iterative methods
+    if ( !getMomentsInt(img, window, m) && !getMoments(img, window, &wx[0], &wy[0], m) ) return ERR_IMG_TYPE;
+    flux = m.m00;
+    if ( m.m00 <= 0 ) return OK_IMAGEPROC;
+    double cx = m.m10/m.m00;
+    double cy = m.m01/m.m00;
+
+    if ( method != CENTROID_COG ){
+        // Background (Gaussian fit only), removed from the starting point too
+        double background = 0;
+        if ( method == CENTROID_GAUSSIAN ){
+            background = getBackground(img, window);
+            SpotMoments s = m;
+            subtractBackground(&wx[0], window.width, &wy[0], window.height, background, s);
+            if ( s.m00 > 0 ){
+                m = s;
+                cx = m.m10/m.m00;
+                cy = m.m01/m.m00;
+            }
+        }
+
+        // Initial width of the weight: given or from the second moments of the window
+        double sx = sigma, sy = sigma;
+        if ( sigma <= 0 ){
+            sx = sqrt(std::max(m.m20/m.m00 - cx*cx, 0.25));
+            sy = sqrt(std::max(m.m02/m.m00 - cy*cy, 0.25));
+        }
+
+        for(int n = 0; n < Nmax; n++){
+            for(int c = 0; c < window.width; c++) wx[c] = exp(-0.5*(c-cx)*(c-cx)/(sx*sx));
+            for(int r = 0; r < window.height; r++) wy[r] = exp(-0.5*(r-cy)*(r-cy)/(sy*sy));
+
+            getMoments(img, window, &wx[0], &wy[0], m);
+            if ( background != 0 ) subtractBackground(&wx[0], window.width, &wy[0], window.height, background, m);
+            if ( m.m00 <= 0 ) break;
+            double nx = m.m10/m.m00;
+            double ny = m.m01/m.m00;
+
+            // Adaptive weight: at convergence the weight matches the spot, and the
+            // weighted variance is half the variance of the spot
+            double change = 0;
+            if ( method == CENTROID_GAUSSIAN ){
+                double vx = m.m20/m.m00 - nx*nx;
+                double vy = m.m02/m.m00 - ny*ny;
+                double nsx = (vx > 0) ? std::min(sqrt(2*vx), (double)window.width) : sx;
+                double nsy = (vy > 0) ? std::min(sqrt(2*vy), (double)window.height) : sy;
+                change = fabs(nsx-sx) + fabs(nsy-sy);
+                sx = nsx;
+                sy = nsy;
+            }
+
+            double shift = fabs(nx-cx) + fabs(ny-cy);
+            cx = nx;
+            cy = ny;
+            if ( shift < 1e-3 && change < 1e-3 ) break;
+        }
+    }
+
+    x = (float)(cx + window.x);
+    y = (float)(cy + window.y);
+    return OK_IMAGEPROC;
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Get centroid of light inside a window with a chosen estimator
+ *
+ * @param [in] img
+ *	Image
+ * @param [out] spots
+ *	One spot (x, y, size = 0, flux in the window) in image coordinates
+ * @param [in] method
+ *	CENTROID_COG, CENTROID_IWCOG or CENTROID_GAUSSIAN
+ * @param [in] window
+ *	Window in which to compute the centroid (empty = whole image)
+ * @param [in] sigma
+ *	Width of the Gaussian weight in px (0 = estimated from the spot)
+ * @param [in] Nmax
+ *	Maximum number of iterations
+ ******************************************************************************/
+ImageProc_Error getSpotLoc(cv::Mat & img, ImageProc_SpotList & spots, ImageProc_Centroid method, cv::Rect window, float sigma, int Nmax){
+    UserInterface::Log log("ImageProc::getSpotLoc");
+    try{
+        // 1. Check the inputs
+        log.debug("1. Check the inputs");
+        if ( img.empty() ) return (ImageProc_Error) log.error("No image", ERR_IMG_MATRIX);
+        if ( !isSupported(img) ) return (ImageProc_Error) log.error("Unsupported pixel type", ERR_IMG_TYPE);
+        if ( method < CENTROID_COG || method > CENTROID_GAUSSIAN ) return (ImageProc_Error) log.error("Unknown centroid method", ERR_SPOTLOC_METHOD);
+        if ( sigma < 0 ) return (ImageProc_Error) log.error("Negative width of weight", ERR_SPOTLOC_SIGMA);
+        if ( window.width <= 0 || window.height <= 0 ) window = cv::Rect(0, 0, img.cols, img.rows);
+        window = window & cv::Rect(0, 0, img.cols, img.rows);
+        if ( window.width <= 0 || window.height <= 0 ) return (ImageProc_Error) log.error("Window out-of-bounds", ERR_SPOTLOC_WINDOW_OOB);
+        log.printf("Window = %ix%i pixels at %ix%i", window.width, window.height, window.x, window.y);
+
+        // 2. Find the centroid
+        log.debug("2. Find the centroid (method = %i)", method);
+        float x, y, flux;
+        ImageProc_Error error = centroidInWindow(img, window, method, sigma, Nmax, x, y, flux);
+        if ( error ) return (ImageProc_Error) log.error("Unsupported pixel type", error);
+        spots.clear();
+        spots.push_back(x, y, 0, flux);
+        log.printf("Centroid = (%f;%f)", x, y);
+
+        return (ImageProc_Error) log.success();
+    }
+    catch( const std::exception& e ){
+        return (ImageProc_Error) log.error(e.what(), ERR_SPOTLOC_FATAL);
+    }
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Get centroid of light inside a window with a chosen estimator
+ *
+ * @param [in] img
+ *	Image
+ * @param [out] spotPositionArray
+ *	Vector returning the centroid of the light (x;y) in image coordinates
+ * @param [in] method
+ *	CENTROID_COG, CENTROID_IWCOG or CENTROID_GAUSSIAN
+ * @param [in] window
+ *	Window in which to compute the centroid (empty = whole image)
+ * @param [in] sigma
+ *	Width of the Gaussian weight in px (0 = estimated from the spot)
+ * @param [in] Nmax
+ *	Maximum number of iterations
+ ******************************************************************************/
+ImageProc_Error getSpotLoc(cv::Mat & img, cv::Mat_<float> & spotPositionArray, ImageProc_Centroid method, cv::Rect window, float sigma, int Nmax){
+    ImageProc_SpotList spots(1);
+    ImageProc_Error error = getSpotLoc(img, spots, method, window, sigma, Nmax);
+    if ( !error ) spotPositionArray = spots.asMat(2);
+    return error;
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Get centroid of light inside each window of a list (batch)
+ *
+ * @param [in] img
+ *	Image
+ * @param [in] windows
+ *	Windows in which to compute the centroids (clipped to the image)
+ * @param [out] spots
+ *	One spot per window (x, y, size = 0, flux in the window), {-1;-1} for an empty window
+ * @param [in] method
+ *	CENTROID_COG, CENTROID_IWCOG or CENTROID_GAUSSIAN
+ * @param [in] sigma
+ *	Width of the Gaussian weight in px (0 = estimated from each spot)
+ * @param [in] Nmax
+ *	Maximum number of iterations
+ ******************************************************************************/
+ImageProc_Error getSpotLoc(cv::Mat & img, const std::vector<cv::Rect> & windows, ImageProc_SpotList & spots, ImageProc_Centroid method, float sigma, int Nmax){
+    UserInterface::Log log("ImageProc::getSpotLoc");
+    try{
+        // 1. Check the inputs
+        log.debug("1. Check the inputs");
+        if ( img.empty() ) return (ImageProc_Error) log.error("No image", ERR_IMG_MATRIX);
+        if ( !isSupported(img) ) return (ImageProc_Error) log.error("Unsupported pixel type", ERR_IMG_TYPE);
+        if ( windows.empty() ) return (ImageProc_Error) log.error("No window", ERR_SPOTLOC_NO_WINDOW);
+        if ( method < CENTROID_COG || method > CENTROID_GAUSSIAN ) return (ImageProc_Error) log.error("Unknown centroid method", ERR_SPOTLOC_METHOD);
+        if ( sigma < 0 ) return (ImageProc_Error) log.error("Negative width of weight", ERR_SPOTLOC_SIGMA);
+
+        // 2. Find the centroid in each window
+        log.debug("2. Find the centroid in %i windows (method = %i)", (int)windows.size(), method);
+        spots.clear();
+        spots.reserve(windows.size());
+        cv::Rect frame(0, 0, img.cols, img.rows);
+        for(int II = 0; II < (int)windows.size(); II++){
+            cv::Rect window = windows[II] & frame;
+            float x = -1, y = -1, flux = 0;
+            if ( window.width <= 0 || window.height <= 0 ) log.printf("Window #%i out-of-bounds", II);
+            else {
+                ImageProc_Error error = centroidInWindow(img, window, method, sigma, Nmax, x, y, flux);
+                if ( error ) return (ImageProc_Error) log.error("Unsupported pixel type", error);
+            }
+            spots.push_back(x, y, 0, flux);
+        }
+
+        return (ImageProc_Error) log.success();
+    }
+    catch( const std::exception& e ){
+        return (ImageProc_Error) log.error(e.what(), ERR_SPOTLOC_FATAL);
+    }
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Get centroid of light inside each window of a list (batch)
+ *
+ * @param [in] img
+ *	Image
+ * @param [in] windows
+ *	Windows in which to compute the centroids (clipped to the image)
+ * @param [out] spotsPositionArray
+ *	Matrix returning one centroid per column (x;y), {-1;-1} for an empty window
+ * @param [in] method
+ *	CENTROID_COG, CENTROID_IWCOG or CENTROID_GAUSSIAN
+ * @param [in] sigma
+ *	Width of the Gaussian weight in px (0 = estimated from each spot)
+ * @param [in] Nmax
+ *	Maximum number of iterations
+ ******************************************************************************/
+ImageProc_Error getSpotLoc(cv::Mat & img, const std::vector<cv::Rect> & windows, cv::Mat_<float> & spotsPositionArray, ImageProc_Centroid method, float sigma, int Nmax){
+    ImageProc_SpotList spots;
+    ImageProc_Error error = getSpotLoc(img, windows, spots, method, sigma, Nmax);
+    if ( !error ) spotsPositionArray = spots.asMat(2);
+    return error;
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Get all the spots on an imgae
+ *
+ * @param [in] img
+ *	Image
+ * @param [out] spots
+ *	List of spots (x; y; size)
+ * @param [in] minArea
+ *	Minimum area of a spot
+ * @param [in] maxArea
+ *	Maximum area of a spot
+ * @param [in] minCircularity
+ *	Minimum circularity of a spot
+ * @param [in] maxCircularity
+ *	Maximum circularity of a spot
+ * @param [in] maxSize
+ *	Maximum size ("diameter") of spot
+ ******************************************************************************/
+ImageProc_Error getSpotsLoc(cv::Mat & img, ImageProc_SpotList & spots, float minArea, float maxArea, float minCircularity, float maxCircularity, float maxSize)
+{
+    UserInterface::Log log("ImageProc::getSpotsLoc");
+    try{
+        // 1. Check the inputs
+        log.debug("1. Check the inputs");
+        if ( img.empty() ) return (ImageProc_Error) log.error("No image", ERR_IMG_MATRIX);
+        if ( !isSupported(img) ) return (ImageProc_Error) log.error("Unsupported pixel type", ERR_IMG_TYPE);
+        if ( maxArea < minArea ) return (ImageProc_Error) log.error("maxArea smaller than minArea", ERR_SPOTSLOC_AREA);
+        if ( maxCircularity < minCircularity ) return (ImageProc_Error) log.error("maxCircularity smaller than minCircularity", ERR_SPOTSLOC_CIRCULARITY);
+        if ( maxSize*maxSize < minArea ) return (ImageProc_Error) log.error("maxSize smaller than minArea", ERR_SPOTSLOC_SIZE);
+
+        // 2. Set the parameters of the blob detector
+        log.debug("2. Set the parameters of the blob detector");
+        cv::SimpleBlobDetector::Params params;
+
+        // Filter by Area
+        params.filterByArea = true;
+        params.minArea = minArea;
+        params.maxArea = maxArea;
+        log.debug("minArea = %f", params.minArea);
+        log.debug("maxArea = %f", params.maxArea);
+
+        // Filter by Circularity
+        params.filterByCircularity = true;
+        params.minCircularity  = minCircularity;
+        params.maxCircularity  = maxCircularity;
+        log.debug("minCircularity  = %f", params.minCircularity );
+        log.debug("maxCircularity  = %f", params.maxCircularity );
+
+        // Filter by Inertia
+        params.filterByInertia = false;
+
+        // Filter by Color
+        params.filterByColor = false;
+
+        // Filter by Convexity
+        params.filterByConvexity = false;
+
+        // 3. Detect blobs (the detector only takes 8-bit images: deeper images are scaled to their maximum)
+        log.debug("3. Detect blobs");
+        ImageProc_Workspace & workspace = ImageProc_Workspace::local();
+        cv::Mat img8 = img;
+        if ( img.depth() != CV_8U ){
+            double minVal, maxVal;
+            cv::minMaxLoc(img, &minVal, &maxVal);
+            img8 = workspace.buffer(ImageProc_Workspace::WS_8BIT, img.size(), CV_8U);
+            img.convertTo(img8, CV_8U, (maxVal > 0) ? 255./maxVal : 1.);
+        }
+        cv::SimpleBlobDetector detector(params);
+        std::vector<cv::KeyPoint> & keypoints = workspace.keypoints().list;
+        keypoints.clear();
+        detector.detect(img8, keypoints);
+
+        if ( keypoints.size() == 0 )  return (ImageProc_Error) log.error("No blob detected", ERR_SPOTSLOC_KEYPTS_SIZE);
+
+        // 4. Load Spots into output list
+        log.debug("4. Load Spots into output list");
+        spots.clear();
+        spots.reserve(keypoints.size());
+        for (int i=0;i<keypoints.size();i++){
+            if ( 4.*keypoints.at(i).size < maxSize ){
+                spots.push_back(keypoints.at(i).pt.x, keypoints.at(i).pt.y, 4.*keypoints.at(i).size);
+
+                if ((keypoints.at(i).pt.x - 2*keypoints.at(i).size < 1) ||
+                        (keypoints.at(i).pt.y - 2*keypoints.at(i).size < 1) ||
+                        (keypoints.at(i).pt.x + 2*keypoints.at(i).size > img.cols-1) ||
+                        (keypoints.at(i).pt.y + 2*keypoints.at(i).size > img.rows-1))
+                    log.printf("Spot #%i on the edge of the image", i);
+            }
+
+        }
+
+        return (ImageProc_Error) log.success();
+    }
+    catch( const std::exception& e ){
+        return (ImageProc_Error) log.error(e.what(), ERR_SPOTSLOC_FATAL);
+    }
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   21/09/2017
+ *
+ * Get all the spots on an imgae
+ *
+ * @param [in] img
+ *	Image
+ * @param [out] spotsPositionArray
+ *	Vector returning the centroid of the light (x; y; size)
+ * @param [in] minArea
+ *	Minimum area of a spot
+ * @param [in] maxArea
+ *	Maximum area of a spot
+ * @param [in] minCircularity
+ *	Minimum circularity of a spot
+ * @param [in] maxCircularity
+ *	Maximum circularity of a spot
+ * @param [in] maxSize
+ *	Maximum size ("diameter") of spot
+ ******************************************************************************/
+ImageProc_Error getSpotsLoc(cv::Mat & img, cv::Mat_<float> & spotsPositionArray, float minArea, float maxArea, float minCircularity, float maxCircularity, float maxSize){
+    ImageProc_SpotList spots;
+    ImageProc_Error error = getSpotsLoc(img, spots, minArea, maxArea, minCircularity, maxCircularity, maxSize);
+    if ( !error ) spotsPositionArray = spots.asMat();
+    return error;
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Remove all the blobs
+ ******************************************************************************/
+void ImageProc_Blobs::clear(void){
+    area.clear(); flux.clear(); x.clear(); y.clear(); peak.clear();
+    left.clear(); top.clear(); width.clear(); height.clear();
+    mu20.clear(); mu11.clear(); mu02.clear();
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Reserve memory for N blobs
+ ******************************************************************************/
+void ImageProc_Blobs::reserve(size_t N){
+    area.reserve(N); flux.reserve(N); x.reserve(N); y.reserve(N); peak.reserve(N);
+    left.reserve(N); top.reserve(N); width.reserve(N); height.reserve(N);
+    mu20.reserve(N); mu11.reserve(N); mu02.reserve(N);
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * List of spots (size = diameter of the disk of same area)
+ *
+ * @param [out] spots
+ *	List of spots
+ ******************************************************************************/
+void ImageProc_Blobs::getSpots(ImageProc_SpotList & spots) const{
+    spots.clear();
+    spots.reserve(size());
+    for(size_t II = 0; II < size(); II++) spots.push_back(x[II], y[II], 2*sqrt(area[II]/M_PI), flux[II]);
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Connected-component labeling (8-connectivity) with union-find
+ *
+ * The image is cut in horizontal strips labeled in parallel. Each strip
+ * accumulates the statistics of its provisional labels during its single
+ * sweep and only keeps the labels of its first and last rows. The strips are
+ * then merged along their boundaries and the statistics folded into the
+ * root of each set, so the pixels are read only once.
+ ******************************************************************************/
+struct BlobAccumulator{
+    double m00, m10, m01, m20, m11, m02;
+    int area;
+    float peak;
+    int x0, y0, x1, y1;
+};
+
+struct LabelStrip{
+    int row0, row1; // Rows of the strip [row0; row1[
+    std::vector<int> parent; // Union-find of the provisional labels (0 = background)
+    std::vector<BlobAccumulator> acc; // Statistics of the provisional labels
+    std::vector<int> firstRow; // Labels of the first row (padded by one on each side)
+    std::vector<int> lastRow; // Labels of the last row (padded by one on each side)
+};
+
+static int findRoot(std::vector<int> & parent, int a){
+    int root = a;
+    while ( parent[root] != root ) root = parent[root];
+    while ( parent[a] != root ) {int next = parent[a]; parent[a] = root; a = next;}
+    return root;
+}
+
+static int unite(std::vector<int> & parent, int a, int b){
+    a = findRoot(parent, a);
+    b = findRoot(parent, b);
+    if ( a < b ) {parent[b] = a; return a;}
+    parent[a] = b;
+    return b;
+}
+
+static void mergeAccumulator(BlobAccumulator & a, const BlobAccumulator & b){
+    a.m00 += b.m00; a.m10 += b.m10; a.m01 += b.m01;
+    a.m20 += b.m20; a.m11 += b.m11; a.m02 += b.m02;
+    a.area += b.area;
+    a.peak = std::max(a.peak, b.peak);
+    a.x0 = std::min(a.x0, b.x0); a.y0 = std::min(a.y0, b.y0);
+    a.x1 = std::max(a.x1, b.x1); a.y1 = std::max(a.y1, b.y1);
+}
+
+template<typename T>
+static void labelStrip(const cv::Mat & img, float threshold, LabelStrip & strip){
+    const int cols = img.cols;
+    std::vector<int> prev(cols+2, 0), cur(cols+2, 0);
+
+    strip.parent.assign(1, 0);
+    strip.acc.assign(1, BlobAccumulator());
+
+    for(int r = strip.row0; r < strip.row1; r++){
+        const T * p = img.ptr<T>(r);
+        for(int c = 0; c < cols; c++){
+            float v = (float)p[c];
+            if ( v <= threshold ) {cur[c+1] = 0; continue;}
+
+            // Neighbours already visited: W, NW, N, NE
+            int label;
+            int n = prev[c+1], ne = prev[c+2], nw = prev[c], w = cur[c];
+            if ( n ) label = n;
+            else if ( ne ){
+                label = ne;
+                if ( nw ) label = unite(strip.parent, ne, nw);
+                else if ( w ) label = unite(strip.parent, ne, w);
+            }
+            else if ( nw ) label = nw;
+            else if ( w ) label = w;
+            else{
+                label = strip.parent.size();
+                strip.parent.push_back(label);
+                BlobAccumulator a = {0, 0, 0, 0, 0, 0, 0, v, c, r, c, r};
+                strip.acc.push_back(a);
+            }
+            cur[c+1] = label;
+
+            BlobAccumulator & a = strip.acc[label];
+            a.m00 += v; a.m10 += (double)v*c; a.m01 += (double)v*r;
+            a.m20 += (double)v*c*c; a.m11 += (double)v*c*r; a.m02 += (double)v*r*r;
+            a.area++;
+            if ( v > a.peak ) a.peak = v;
+            if ( c < a.x0 ) a.x0 = c;
+            if ( c > a.x1 ) a.x1 = c;
+            a.y1 = r;
+        }
+        if ( r == strip.row0 ) strip.firstRow = cur;
+        prev.swap(cur);
+    }
+    strip.lastRow = prev;
+}
+
+class LabelStripsBody : public cv::ParallelLoopBody{
+public:
+    LabelStripsBody(const cv::Mat & img, float threshold, std::vector<LabelStrip> & strips) : _img(img), _threshold(threshold), _strips(strips) {}
+    void operator()(const cv::Range & range) const{
+        for(int k = range.start; k < range.end; k++){
+            switch( _img.depth() ){
+            case CV_8U: labelStrip<uchar>(_img, _threshold, _strips[k]); break;
+            case CV_16U: labelStrip<ushort>(_img, _threshold, _strips[k]); break;
+            case CV_32F: labelStrip<float>(_img, _threshold, _strips[k]); break;
+            }
+        }
+    }
+private:
+    const cv::Mat & _img;
+    float _threshold;
+    std::vector<LabelStrip> & _strips;
+};
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Get all the spots on an image with the connected-component labeling
+ *
+ * @param [in] img
+ *	Image (CV_8U, CV_16U or CV_32F)
+ * @param [out] blobs
+ *	Statistics of each spot (structure of arrays)
+ * @param [in] threshold
+ *	Pixels above the threshold belong to a spot
+ * @param [in] minArea
+ *	Minimum area of a spot in px
+ * @param [in] maxArea
+ *	Maximum area of a spot in px
+ * @param [in] Nstrips
+ *	Number of strips labeled in parallel (0 = number of threads)
+ ******************************************************************************/
+ImageProc_Error getSpotsLoc(cv::Mat & img, ImageProc_Blobs & blobs, float threshold, float minArea, float maxArea, int Nstrips){
+    UserInterface::Log log("ImageProc::getSpotsLoc");
+    try{
+        // 1. Check the inputs
+        log.debug("1. Check the inputs");
+        if ( img.empty() ) return (ImageProc_Error) log.error("No image", ERR_IMG_MATRIX);
+        if ( !isSupported(img) ) return (ImageProc_Error) log.error("Unsupported pixel type", ERR_IMG_TYPE);
+        if ( threshold < 0 ) return (ImageProc_Error) log.error("Negative threshold", ERR_SPOTSLOC_THRESH);
+        if ( maxArea < minArea ) return (ImageProc_Error) log.error("maxArea smaller than minArea", ERR_SPOTSLOC_AREA);
+        if ( Nstrips < 0 ) return (ImageProc_Error) log.error("Negative number of strips", ERR_SPOTSLOC_STRIPS);
+        if ( Nstrips == 0 ) Nstrips = cv::getNumThreads();
+        Nstrips = std::max(1, std::min(Nstrips, img.rows));
+
+        // 2. Label the strips in parallel
+        log.debug("2. Label %i strips in parallel (threshold = %f)", Nstrips, threshold);
+        std::vector<LabelStrip> strips(Nstrips);
+        for(int k = 0; k < Nstrips; k++){
+            strips[k].row0 = (int)((long)img.rows*k/Nstrips);
+            strips[k].row1 = (int)((long)img.rows*(k+1)/Nstrips);
+        }
+        cv::parallel_for_(cv::Range(0, Nstrips), LabelStripsBody(img, threshold, strips));
+
+        // 3. Gather the labels of all the strips
+        log.debug("3. Gather the labels of all the strips");
+        std::vector<int> offset(Nstrips, 0);
+        int Nlabels = 1;
+        for(int k = 0; k < Nstrips; k++){
+            offset[k] = Nlabels - 1;
+            Nlabels += strips[k].parent.size() - 1;
+        }
+        std::vector<int> parent(Nlabels);
+        std::vector<BlobAccumulator> acc(Nlabels);
+        parent[0] = 0;
+        for(int k = 0; k < Nstrips; k++){
+            for(size_t l = 1; l < strips[k].parent.size(); l++){
+                parent[offset[k] + l] = offset[k] + findRoot(strips[k].parent, l);
+                acc[offset[k] + l] = strips[k].acc[l];
+            }
+        }
+
+        // 4. Merge the labels across the strip boundaries
+        log.debug("4. Merge the labels across the strip boundaries");
+        for(int k = 1; k < Nstrips; k++){
+            const std::vector<int> & above = strips[k-1].lastRow;
+            const std::vector<int> & below = strips[k].firstRow;
+            for(int c = 1; c <= img.cols; c++){
+                if ( !below[c] ) continue;
+                for(int d = -1; d <= 1; d++){
+                    if ( above[c+d] ) unite(parent, offset[k] + below[c], offset[k-1] + above[c+d]);
+                }
+            }
+        }
+
+        // 5. Fold the statistics into the root of each blob
+        log.debug("5. Fold the statistics into the root of each blob");
+        for(int l = 1; l < Nlabels; l++){
+            int root = findRoot(parent, l);
+            if ( root != l ) mergeAccumulator(acc[root], acc[l]);
+        }
+
+        // 6. Load the blobs into the output arrays
+        log.debug("6. Load the blobs into the output arrays");
+        blobs.clear();
+        for(int l = 1; l < Nlabels; l++){
+            const BlobAccumulator & a = acc[l];
+            if ( parent[l] != l || a.area < minArea || a.area > maxArea || a.m00 <= 0 ) continue;
+            double cx = a.m10/a.m00, cy = a.m01/a.m00;
+            blobs.area.push_back(a.area);
+            blobs.flux.push_back(a.m00);
+            blobs.x.push_back(cx);
+            blobs.y.push_back(cy);
+            blobs.peak.push_back(a.peak);
+            blobs.left.push_back(a.x0);
+            blobs.top.push_back(a.y0);
+            blobs.width.push_back(a.x1 - a.x0 + 1);
+            blobs.height.push_back(a.y1 - a.y0 + 1);
+            blobs.mu20.push_back(a.m20/a.m00 - cx*cx);
+            blobs.mu11.push_back(a.m11/a.m00 - cx*cy);
+            blobs.mu02.push_back(a.m02/a.m00 - cy*cy);
+        }
+        log.printf("Number of blobs = %i", (int)blobs.size());
+
+        if ( blobs.size() == 0 ) return (ImageProc_Error) log.error("No blob detected", ERR_SPOTSLOC_KEYPTS_SIZE);
+
+        return (ImageProc_Error) log.success();
+    }
+    catch( const std::exception& e ){
+        return (ImageProc_Error) log.error(e.what(), ERR_SPOTSLOC_FATAL);
+    }
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Sum of the pixels of an image inside a mask (mask >= 128), over a range of rows
+ ******************************************************************************/
+template<typename T>
+static double sumInMask(const cv::Mat & img, const cv::Mat & mask, int rowStart, int rowEnd){
+    double sum = 0;
+    for(int r = rowStart; r < rowEnd; r++){
+        const T * p = img.ptr<T>(r);
+        const uchar * m = mask.ptr<uchar>(r);
+        double rowSum = 0;
+        for(int c = 0; c < img.cols; c++) if ( m[c] >= 128 ) rowSum += p[c];
+        sum += rowSum;
+    }
+    return sum;
+}
+
+static double sumInCircle(const cv::Mat & img, const cv::Mat & mask, float cy, float R){
+    int rowStart = std::max(0, (int)floor(cy - R) - 1);
+    int rowEnd = std::min(img.rows, (int)ceil(cy + R) + 2);
+    switch(img.depth()){
+    case CV_8U: return sumInMask<uchar>(img, mask, rowStart, rowEnd);
+    case CV_16U: return sumInMask<ushort>(img, mask, rowStart, rowEnd);
+    default: return sumInMask<float>(img, mask, rowStart, rowEnd);
+    }
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   21/09/2017
+ *
+ * Find the radius of encircled energy
+ *
+ * @param [in] img
+ *	Image with one unique spot
+ * @param [in] center
+ *	Center of unique spot
+ * @param [in] energy
+ *	Percentage of energy inside the circle
+ * @param [in] tol
+ *	Tolerance on the energy (%)
+ * @param [out] radius
+ *	Radius of circle in px
+ * @param [in] Nmax
+ *	Maximum number of iteration
+ ******************************************************************************/
+ImageProc_Error getRadiusOfEncircleEnergy(cv::Mat & img, const cv::Mat_<float> & center, float energy, float tol, float & radius, int Nmax = 100)
+{
+    UserInterface::Log log("ImageProc::getRadiusOfEncircleEnergy");
+    try{
+        // 1. Check the inputs
+        log.debug("1. Check the inputs");
+        if ( img.empty() ) return (ImageProc_Error) log.error("No image", ERR_IMG_MATRIX);
+        if ( !isSupported(img) ) return (ImageProc_Error) log.error("Unsupported pixel type", ERR_IMG_TYPE);
+        if ( center.cols != 1) return (ImageProc_Error) log.error("Center not a vector", ERR_ENCIRCLE_CENTER_COLS_OOB);
+        if ( center.rows != 2) return (ImageProc_Error) log.error("Too many centers", ERR_ENCIRCLE_CENTER_ROWS_OOB);
+        if ( energy > 100 || energy < 0) return (ImageProc_Error) log.error("Energy target out-of-bounds", ERR_ENCIRCLE_ENERGY_OOB);
+        if ( tol <= 0 ) return (ImageProc_Error) log.error("Error on energy out-of-bounds", ERR_ENCIRCLE_ERROR_OOB);
+
+        // 2. Find radius with a binary process
+        log.debug("2. Find radius with a binary process");
+        float Rmax = pow(pow(img.rows,2)+pow(img.cols,2),0.5);
+        float Rmin = 0;
+        float R = (Rmax+Rmin)/2;
+        cv::Mat & mask = ImageProc_Workspace::local().buffer(ImageProc_Workspace::WS_MASK, img.size(), CV_8U);
+        mask.setTo(cv::Scalar(0));
+        int shift = 10;
+        cv::Point centerP;
+        centerP.x = center(0);
+        centerP.y = center(1);
+        cv::circle(mask, centerP, (int)(R*pow(2,shift)), cv::Scalar(255,255,255), -1, CV_AA, shift);
+        float intensity0 = cv::sum(img)(0);
+        float intensity = 100*sumInCircle(img, mask, center(1), R)/intensity0;
+        int n = 0;
+
+        // Binary process
+        while( (fabs(intensity-energy) > tol) && n<Nmax)
+        {
+            log.debug("Error = %f", fabs(intensity-energy));
+            log.debug("Radius = %f", R);
+
+            // Calculate new radius
+            if ( intensity > energy ) Rmax = R;
             else Rmin = R;
 
             R = (Rmin+Rmax)/2;
@@ -334,10 +1503,9 @@ ImageProc_Error getRadiusOfEncircleEnergy(cv::Mat & img, const cv::Mat_<float> &
             // Create new mask
             mask.setTo(cv::Scalar(0,0,0));
             cv::circle(mask, centerP, (int)(R*pow(2,shift)), cv::Scalar(255,255,255), -1, CV_AA, shift);
-            masked_img = img.mul(mask/255);
 
             // Calculate new intensity
-            intensity = 100*cv::sum(masked_img)(0)/intensity0;
+            intensity = 100*sumInCircle(img, mask, center(1), R)/intensity0;
             n += 1;
         }
 
@@ -353,4 +1521,567 @@ ImageProc_Error getRadiusOfEncircleEnergy(cv::Mat & img, const cv::Mat_<float> &
 }
 
 
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Find the radius of encircled energy around a spot of a list
+ *
+ * @param [in] img
+ *	Image with one unique spot
+ * @param [in] spots
+ *	List of spots
+ * @param [in] index
+ *	Index of the spot in the list
+ * @param [in] energy
+ *	Percentage of energy inside the circle
+ * @param [in] tol
+ *	Tolerance on the energy (%)
+ * @param [out] radius
+ *	Radius of circle in px
+ * @param [in] Nmax
+ *	Maximum number of iteration
+ ******************************************************************************/
+ImageProc_Error getRadiusOfEncircleEnergy(cv::Mat & img, const ImageProc_SpotList & spots, int index, float energy, float tol, float & radius, int Nmax)
+{
+    if ( index < 0 || index >= spots.size() ){
+        UserInterface::Log log("ImageProc::getRadiusOfEncircleEnergy");
+        return (ImageProc_Error) log.error("Spot index out-of-bounds", ERR_ENCIRCLE_CENTER_COLS_OOB);
+    }
+    float xy[2] = {spots.x()[index], spots.y()[index]};
+    cv::Mat_<float> center(2, 1, xy); // Header on the stack, no allocation
+    return getRadiusOfEncircleEnergy(img, center, energy, tol, radius, Nmax);
+}
+
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Radius containing an energy, interpolated on the encircled energy curve
+ *
+ * @param [in] energy
+ *	Energy (% of flux)
+ ******************************************************************************/
+float ImageProc_PSF::radiusOfEnergy(float energy) const{
+    float previous = 0;
+    for(size_t II = 0; II < encircledEnergy.size(); II++){
+        if ( encircledEnergy[II] >= energy ){
+            float step = encircledEnergy[II] - previous;
+            return (step > 0) ? II + (energy - previous)/step : II;
+        }
+        previous = encircledEnergy[II];
+    }
+    return -1;
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Single pass over a window: copy to float, raw moments, peak and border sum
+ ******************************************************************************/
+struct PSFPass{
+    double s0, sx, sy, sxx, sxy, syy; // Raw moments (window coordinates)
+    double border; // Sum of the pixels on the border of the window
+    int Nborder;
+    float peak;
+    int peakX, peakY;
+};
+
+template<typename T>
+static void psfPass(const cv::Mat & img, const cv::Rect & window, cv::Mat_<float> & crop, PSFPass & p){
+    const int w = window.width, h = window.height;
+    p.s0 = p.sx = p.sy = p.sxx = p.sxy = p.syy = 0;
+    p.border = 0;
+    p.Nborder = 0;
+    p.peak = (float)img.ptr<T>(window.y)[window.x];
+    p.peakX = p.peakY = 0;
+
+    for(int r = 0; r < h; r++){
+        const T * src = img.ptr<T>(window.y + r) + window.x;
+        float * dst = crop[r];
+        double r0 = 0, r1 = 0, r2 = 0;
+        float rowPeak = (float)src[0];
+        int rowPeakX = 0;
+
+        for(int c = 0; c < w; c++){
+            float v = (float)src[c];
+            dst[c] = v;
+            r0 += v;
+            r1 += v*c;
+            r2 += (double)v*c*c;
+            if ( v > rowPeak ) {rowPeak = v; rowPeakX = c;}
+        }
+
+        p.s0 += r0;
+        p.sx += r1;
+        p.sxx += r2;
+        p.sy += r*r0;
+        p.sxy += r*r1;
+        p.syy += (double)r*r*r0;
+        if ( rowPeak > p.peak ) {p.peak = rowPeak; p.peakX = rowPeakX; p.peakY = r;}
+
+        if ( r == 0 || r == h-1 ) {p.border += r0; p.Nborder += w;}
+        else if ( w > 1 ) {p.border += dst[0] + dst[w-1]; p.Nborder += 2;}
+        else {p.border += dst[0]; p.Nborder += 1;}
+    }
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Get all the metrics of a PSF in one pass over a window
+ *
+ * The image is read once: the window is copied to float while its moments,
+ * peak and border level are accumulated. The encircled energy curve is then
+ * binned from the copy (1 px bins around the centroid, up to the largest
+ * circle inside the window). The moments are corrected for the background
+ * analytically, so the background needs not be known before the pass.
+ *
+ * @param [in] img
+ *	Image (single channel, 8U, 16U or 32F)
+ * @param [in] window
+ *	Window around the PSF (empty = whole image)
+ * @param [out] psf
+ *	Metrics of the PSF
+ * @param [in] background
+ *	Background level (negative = mean of the border of the window)
+ * @param [in] idealPeakFraction
+ *	Peak over flux of the diffraction-limited PSF at the same sampling (0 = Strehl proxy is peak/flux)
+ ******************************************************************************/
+ImageProc_Error getPSFMetrics(cv::Mat & img, cv::Rect window, ImageProc_PSF & psf, float background, float idealPeakFraction){
+    UserInterface::Log log("ImageProc::getPSFMetrics");
+    try
+    {
+        // 1. Check the inputs
+        log.debug("1. Check the inputs");
+        if ( img.empty() ) return (ImageProc_Error) log.error("No image", ERR_IMG_MATRIX);
+        if ( !isSupported(img) ) return (ImageProc_Error) log.error("Unsupported pixel type", ERR_IMG_TYPE);
+        if ( window.area() == 0 ) window = cv::Rect(0, 0, img.cols, img.rows);
+        if ( (window & cv::Rect(0, 0, img.cols, img.rows)) != window ) return (ImageProc_Error) log.error("Window out-of-bounds", ERR_PSF_WINDOW_OOB);
+
+        // 2. Read the window
+        log.debug("2. Read the window %ix%i at %ix%i", window.width, window.height, window.x, window.y);
+        cv::Mat_<float> crop(window.height, window.width);
+        PSFPass p;
+        switch(img.depth()){
+        case CV_8U: psfPass<uchar>(img, window, crop, p); break;
+        case CV_16U: psfPass<ushort>(img, window, crop, p); break;
+        case CV_32F: psfPass<float>(img, window, crop, p); break;
+        default: return (ImageProc_Error) log.error("Image type not supported", ERR_IMG_TYPE);
+        }
+
+        // 3. Subtract the background from the moments
+        const double w = window.width, h = window.height;
+        const double b = (background < 0) ? p.border/p.Nborder : background;
+        const double Sc = w*(w-1)/2, Scc = (w-1)*w*(2*w-1)/6; // Sums of c and c^2 over a row
+        const double Sr = h*(h-1)/2, Srr = (h-1)*h*(2*h-1)/6; // Sums of r and r^2 over a column
+        double m00 = p.s0 - b*w*h;
+        double m10 = p.sx - b*h*Sc;
+        double m01 = p.sy - b*w*Sr;
+        double m20 = p.sxx - b*h*Scc;
+        double m02 = p.syy - b*w*Srr;
+        double m11 = p.sxy - b*Sc*Sr;
+        log.debug("3. Background = %f, flux = %f", b, m00);
+        if ( m00 <= 0 ) return (ImageProc_Error) log.error("No signal above the background", ERR_PSF_NO_SIGNAL);
+
+        // 4. Centroid, peak and shape
+        double cx = m10/m00, cy = m01/m00;
+        double mu20 = m20/m00 - cx*cx, mu02 = m02/m00 - cy*cy, mu11 = m11/m00 - cx*cy;
+        double t = (mu20 + mu02)/2, d = sqrt((mu20 - mu02)*(mu20 - mu02)/4 + mu11*mu11);
+        double l1 = std::max(t + d, 0.), l2 = std::max(t - d, 0.);
+
+        psf.x = window.x + cx;
+        psf.y = window.y + cy;
+        psf.background = b;
+        psf.flux = m00;
+        psf.peak = p.peak - b;
+        psf.peakX = window.x + p.peakX;
+        psf.peakY = window.y + p.peakY;
+        psf.fwhmMajor = 2.3548*sqrt(l1);
+        psf.fwhmMinor = 2.3548*sqrt(l2);
+        psf.angle = 0.5*atan2(2*mu11, mu20 - mu02);
+        psf.ellipticity = (psf.fwhmMajor > 0) ? 1 - psf.fwhmMinor/psf.fwhmMajor : 0;
+        psf.strehl = psf.peak/psf.flux;
+        if ( idealPeakFraction > 0 ) psf.strehl /= idealPeakFraction;
+        log.debug("4. Centroid = (%f;%f), peak = %f, FWHM = %fx%f", psf.x, psf.y, psf.peak, psf.fwhmMajor, psf.fwhmMinor);
+
+        // 5. Encircled energy curve
+        double Rmax = std::min(std::min(cx, w-1-cx), std::min(cy, h-1-cy)) + 0.5;
+        int Nbins = std::max(1, (int)Rmax);
+        std::vector<double> bins(Nbins, 0.);
+        std::vector<float> dx2(window.width);
+        for(int c = 0; c < window.width; c++) dx2[c] = (c - cx)*(c - cx);
+        for(int r = 0; r < window.height; r++){
+            const float * v = crop[r];
+            float dy2 = (r - cy)*(r - cy);
+            for(int c = 0; c < window.width; c++){
+                int k = (int)sqrtf(dx2[c] + dy2);
+                if ( k < Nbins ) bins[k] += v[c] - b;
+            }
+        }
+        psf.encircledEnergy.resize(Nbins);
+        double cumul = 0;
+        for(int k = 0; k < Nbins; k++){
+            cumul += bins[k];
+            psf.encircledEnergy[k] = 100*cumul/m00;
+        }
+        log.debug("5. Encircled energy up to r = %i: %f%%", Nbins, psf.encircledEnergy[Nbins-1]);
+
+        return (ImageProc_Error) log.success();
+    }
+    catch(  const std::exception& e  ){
+        return (ImageProc_Error) log.error(e.what(), ERR_PSF_FATAL);
+    }
+}
+
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Single pass over a frame for its statistics
+ *
+ * Each row is read from memory once: the histogram is filled through a
+ * lookup table into 4 interleaved sub-histograms (consecutive pixels rarely
+ * hit the same counter), then the min/max/sum/sum of squares/saturation
+ * reductions run on the same row while it is in cache. The reductions have
+ * no dependency between pixels and are vectorized by the compiler.
+ ******************************************************************************/
+template<typename T, typename S>
+static void frameStatsPass(const cv::Mat & img, const std::vector<int> & lut, int Nbins, T saturation, ImageProc_FrameStats & stats){
+    std::vector<int> sub(4*Nbins, 0);
+    int * h0 = &sub[0], * h1 = h0 + Nbins, * h2 = h1 + Nbins, * h3 = h2 + Nbins;
+    S sum = 0, sum2 = 0;
+    T vmin = img.ptr<T>(0)[0], vmax = vmin;
+    int saturated = 0;
+    const int width = img.cols;
+
+    for(int r = 0; r < img.rows; r++){
+        const T * p = img.ptr<T>(r);
+
+        int c = 0;
+        for(; c + 4 <= width; c += 4){
+            h0[lut[p[c]]]++;
+            h1[lut[p[c+1]]]++;
+            h2[lut[p[c+2]]]++;
+            h3[lut[p[c+3]]]++;
+        }
+        for(; c < width; c++) h0[lut[p[c]]]++;
+
+        S rowSum = 0, rowSum2 = 0;
+        T rowMin = p[0], rowMax = p[0];
+        int rowSaturated = 0;
+        for(c = 0; c < width; c++){
+            T v = p[c];
+            rowSum += v;
+            rowSum2 += (S)v*v;
+            rowMin = std::min(rowMin, v);
+            rowMax = std::max(rowMax, v);
+            rowSaturated += (v >= saturation);
+        }
+        sum += rowSum;
+        sum2 += rowSum2;
+        vmin = std::min(vmin, rowMin);
+        vmax = std::max(vmax, rowMax);
+        saturated += rowSaturated;
+    }
+
+    stats.histogram.assign(Nbins, 0);
+    for(int k = 0; k < Nbins; k++) stats.histogram[k] = h0[k] + h1[k] + h2[k] + h3[k];
+    double N = (double)img.rows*img.cols;
+    stats.mean = (double)sum/N;
+    stats.std = sqrt(std::max((double)sum2/N - stats.mean*stats.mean, 0.));
+    stats.min = vmin;
+    stats.max = vmax;
+    stats.saturated = saturated;
+}
+
+// Bins of the histogram: [0; saturation] spread over Nbins (same for every pixel type)
+static double histogramScale(int Nbins, double saturation){
+    return std::min(Nbins/saturation, (double) FLT_MAX); // Finite: 0*scale = 0
+}
+
+// Float pixels: no lookup table, the bin is computed (clamped before the cast, NaN not counted)
+static void frameStatsPassFloat(const cv::Mat & img, int Nbins, float saturation, ImageProc_FrameStats & stats){
+    std::vector<int> hist(Nbins, 0);
+    double sum = 0, sum2 = 0;
+    float vmin = img.ptr<float>(0)[0], vmax = vmin;
+    int saturated = 0;
+    const float scale = (float) histogramScale(Nbins, saturation);
+    const float last = (float)(Nbins - 1);
+
+    for(int r = 0; r < img.rows; r++){
+        const float * p = img.ptr<float>(r);
+        for(int c = 0; c < img.cols; c++){
+            float k = p[c]*scale;
+            if ( k != k ) continue; // NaN
+            hist[(int) std::min(std::max(k, 0.f), last)]++;
+        }
+
+        double rowSum = 0, rowSum2 = 0;
+        float rowMin = p[0], rowMax = p[0];
+        int rowSaturated = 0;
+        for(int c = 0; c < img.cols; c++){
+            float v = p[c];
+            rowSum += v;
+            rowSum2 += (double)v*v;
+            rowMin = std::min(rowMin, v);
+            rowMax = std::max(rowMax, v);
+            rowSaturated += (v >= saturation);
+        }
+        sum += rowSum;
+        sum2 += rowSum2;
+        vmin = std::min(vmin, rowMin);
+        vmax = std::max(vmax, rowMax);
+        saturated += rowSaturated;
+    }
+
+    stats.histogram = hist;
+    double N = (double)img.rows*img.cols;
+    stats.mean = sum/N;
+    stats.std = sqrt(std::max(sum2/N - stats.mean*stats.mean, 0.));
+    stats.min = vmin;
+    stats.max = vmax;
+    stats.saturated = saturated;
+}
+
+// Bin of each integer value (see histogramScale), above the saturation in the last bin
+static void histogramLUT(int Nvalues, int Nbins, double saturation, std::vector<int> & lut){
+    lut.resize(Nvalues);
+    double scale = histogramScale(Nbins, saturation);
+    for(int v = 0; v < Nvalues; v++) lut[v] = (int) std::min(v*scale, (double)(Nbins - 1));
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Get the histogram and statistics of a frame in one pass
+ *
+ * @param [in] img
+ *	Image (single channel, CV_8U, CV_16U or CV_32F)
+ * @param [out] stats
+ *	Histogram, saturation count, min, max, mean and standard deviation
+ * @param [in] Nbins
+ *	Number of bins of the histogram
+ * @param [in] saturation
+ *	Saturation level (0 = 255 for CV_8U, 65535 for CV_16U, 1 for CV_32F)
+ ******************************************************************************/
+ImageProc_Error getFrameStats(const cv::Mat & img, ImageProc_FrameStats & stats, int Nbins, double saturation){
+    UserInterface::Log log("ImageProc::getFrameStats");
+    try
+    {
+        // 1. Check the inputs
+        log.debug("1. Check the inputs");
+        if ( img.empty() ) return (ImageProc_Error) log.error("No image", ERR_IMG_MATRIX);
+        if ( !isSupported(img) ) return (ImageProc_Error) log.error("Unsupported pixel type", ERR_IMG_TYPE);
+        if ( Nbins < 1 || Nbins > 65536 ) return (ImageProc_Error) log.error("Number of bins out-of-bounds", ERR_STATS_BINS);
+        if ( saturation < 0 ) return (ImageProc_Error) log.error("Negative saturation", ERR_STATS_SATURATION);
+        if ( saturation == 0 ) saturation = (img.depth() == CV_32F) ? 1 : maxPixelValue(img);
+        stats.saturation = saturation;
+
+        // 2. Single pass
+        log.debug("2. Single pass: %i bins, saturation = %f", Nbins, saturation);
+        std::vector<int> lut;
+        switch(img.depth()){
+        case CV_8U:
+            histogramLUT(256, Nbins, saturation, lut);
+            frameStatsPass<uchar, uint64_t>(img, lut, Nbins, (uchar)std::min(ceil(saturation), 255.), stats);
+            break;
+        case CV_16U:
+            histogramLUT(65536, Nbins, saturation, lut);
+            frameStatsPass<ushort, uint64_t>(img, lut, Nbins, (ushort)std::min(ceil(saturation), 65535.), stats);
+            break;
+        case CV_32F:
+            frameStatsPassFloat(img, Nbins, saturation, stats);
+            break;
+        }
+        log.debug("3. Min = %f, max = %f, mean = %f, std = %f, saturated = %i", stats.min, stats.max, stats.mean, stats.std, stats.saturated); // Once per frame of a video
+
+        return (ImageProc_Error) log.success();
+    }
+    catch(  const std::exception& e  ){
+        return (ImageProc_Error) log.error(e.what(), ERR_STATS_FATAL);
+    }
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Add (sign = 1) or remove (sign = -1) the focus terms of the pixels of a rectangle
+ *
+ * All the terms are read from the 3x3 neighbourhood in the full image
+ * (clamped at its border), so they do not depend on the region and the sums
+ * over a region can be updated strip by strip.
+ ******************************************************************************/
+template<typename T>
+static void addFocusSums(const cv::Mat & img, const cv::Rect & rect, double sign, ImageProc_FocusTracker::Sums & s){
+    const int last = img.cols - 1;
+    for(int y = rect.y; y < rect.y + rect.height; y++){
+        const T * u = img.ptr<T>(std::max(y-1, 0));
+        const T * m = img.ptr<T>(y);
+        const T * d = img.ptr<T>(std::min(y+1, img.rows-1));
+        double rI = 0, rI2 = 0, rL = 0, rL2 = 0, rB = 0, rT = 0;
+
+        for(int x = rect.x; x < rect.x + rect.width; x++){
+            int xl = (x > 0) ? x-1 : 0;
+            int xr = (x < last) ? x+1 : last;
+            float c = m[x];
+            float L = (float)u[x] + d[x] + m[xl] + m[xr] - 4*c;
+            float B = (float)m[xr] - m[xl];
+            float gx = ((float)u[xr] + 2.f*m[xr] + d[xr]) - ((float)u[xl] + 2.f*m[xl] + d[xl]);
+            float gy = ((float)d[xl] + 2.f*d[x] + d[xr]) - ((float)u[xl] + 2.f*u[x] + u[xr]);
+            rI += c;
+            rI2 += (double)c*c;
+            rL += L;
+            rL2 += (double)L*L;
+            rB += (double)B*B;
+            rT += (double)gx*gx + (double)gy*gy;
+        }
+
+        s.I += sign*rI;
+        s.I2 += sign*rI2;
+        s.L += sign*rL;
+        s.L2 += sign*rL2;
+        s.B += sign*rB;
+        s.T += sign*rT;
+    }
+}
+
+static void addFocusSums(const cv::Mat & img, const cv::Rect & rect, double sign, ImageProc_FocusTracker::Sums & s){
+    if ( rect.area() <= 0 ) return;
+    switch(img.depth()){
+    case CV_8U: addFocusSums<uchar>(img, rect, sign, s); break;
+    case CV_16U: addFocusSums<ushort>(img, rect, sign, s); break;
+    case CV_32F: addFocusSums<float>(img, rect, sign, s); break;
+    }
+}
+
+// Add the pixels of a that are outside of its intersection i with another rectangle
+static void addFocusStrips(const cv::Mat & img, const cv::Rect & a, const cv::Rect & i, double sign, ImageProc_FocusTracker::Sums & s){
+    addFocusSums(img, cv::Rect(a.x, a.y, a.width, i.y - a.y), sign, s); // Above
+    addFocusSums(img, cv::Rect(a.x, i.y + i.height, a.width, a.y + a.height - i.y - i.height), sign, s); // Below
+    addFocusSums(img, cv::Rect(a.x, i.y, i.x - a.x, i.height), sign, s); // Left
+    addFocusSums(img, cv::Rect(i.x + i.width, i.y, a.x + a.width - i.x - i.width, i.height), sign, s); // Right
+}
+
+static void focusFromSums(const ImageProc_FocusTracker::Sums & s, int N, ImageProc_Focus & focus){
+    double variance = std::max(s.I2/N - (s.I/N)*(s.I/N), 0.);
+    focus.mean = s.I/N;
+    focus.laplacianVariance = std::max(s.L2/N - (s.L/N)*(s.L/N), 0.);
+    focus.brenner = s.B/N;
+    focus.tenengrad = s.T/N;
+    focus.normalizedVariance = (focus.mean > 0) ? variance/focus.mean : 0;
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Get the focus metrics of a region in one pass
+ *
+ * The variance of the Laplacian, Brenner, Tenengrad and normalized variance
+ * are accumulated together, reading each row of the region and its two
+ * neighbours once.
+ *
+ * @param [in] img
+ *	Image (single channel, CV_8U, CV_16U or CV_32F)
+ * @param [in] roi
+ *	Region of interest (empty = whole image)
+ * @param [out] focus
+ *	Focus metrics
+ ******************************************************************************/
+ImageProc_Error getFocus(cv::Mat & img, cv::Rect roi, ImageProc_Focus & focus){
+    ImageProc_FocusTracker tracker;
+    return tracker.start(img, roi, focus);
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Compute the metrics of a region of a new frame
+ *
+ * @param [in] img
+ *	Image (kept by the tracker until the next start)
+ * @param [in] roi
+ *	Region of interest (empty = whole image)
+ * @param [out] focus
+ *	Focus metrics
+ ******************************************************************************/
+ImageProc_Error ImageProc_FocusTracker::start(cv::Mat & img, cv::Rect roi, ImageProc_Focus & focus){
+    UserInterface::Log log("ImageProc::getFocus");
+    try
+    {
+        // 1. Check the inputs
+        log.debug("1. Check the inputs");
+        _img.release();
+        if ( img.empty() ) return (ImageProc_Error) log.error("No image", ERR_IMG_MATRIX);
+        if ( !isSupported(img) ) return (ImageProc_Error) log.error("Unsupported pixel type", ERR_IMG_TYPE);
+        if ( roi.area() == 0 ) roi = cv::Rect(0, 0, img.cols, img.rows);
+        if ( (roi & cv::Rect(0, 0, img.cols, img.rows)) != roi ) return (ImageProc_Error) log.error("ROI out-of-bounds", ERR_FOCUS_ROI_OOB);
+
+        // 2. Accumulate the metrics
+        _img = img;
+        _roi = roi;
+        _moves = 0;
+        _sums.I = _sums.I2 = _sums.L = _sums.L2 = _sums.B = _sums.T = 0;
+        addFocusSums(_img, _roi, 1, _sums);
+        focusFromSums(_sums, _roi.area(), focus);
+        log.debug("2. ROI %ix%i at %ix%i: LapVar = %f, Brenner = %f, Tenengrad = %f, NormVar = %f", roi.width, roi.height, roi.x, roi.y, focus.laplacianVariance, focus.brenner, focus.tenengrad, focus.normalizedVariance);
+
+        return (ImageProc_Error) log.success();
+    }
+    catch(  const std::exception& e  ){
+        return (ImageProc_Error) log.error(e.what(), ERR_FOCUS_FATAL);
+    }
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Move the region over the same frame
+ *
+ * Only the pixels that leave or enter the region are read: a shift of
+ * (dx;dy) costs |dx|*height + |dy|*width pixels instead of width*height.
+ *
+ * @param [in] roi
+ *	New region of interest (any size)
+ * @param [out] focus
+ *	Focus metrics of the new region
+ ******************************************************************************/
+ImageProc_Error ImageProc_FocusTracker::move(cv::Rect roi, ImageProc_Focus & focus){
+    UserInterface::Log log("ImageProc::FocusTracker::move");
+    try
+    {
+        if ( _img.empty() ) return (ImageProc_Error) log.error("No frame", ERR_FOCUS_NOT_STARTED);
+        if ( roi.area() == 0 || (roi & cv::Rect(0, 0, _img.cols, _img.rows)) != roi ) return (ImageProc_Error) log.error("ROI out-of-bounds", ERR_FOCUS_ROI_OOB);
+
+        cv::Rect overlap = roi & _roi;
+        if ( overlap.area() == 0 || ++_moves >= FOCUS_RESYNC ){
+            // Disjoint regions or resynchronisation: full pass
+            _moves = 0;
+            _sums.I = _sums.I2 = _sums.L = _sums.L2 = _sums.B = _sums.T = 0;
+            addFocusSums(_img, roi, 1, _sums);
+        }
+        else {
+            addFocusStrips(_img, _roi, overlap, -1, _sums);
+            addFocusStrips(_img, roi, overlap, 1, _sums);
+        }
+        _roi = roi;
+        focusFromSums(_sums, _roi.area(), focus);
+        log.printf("ROI %ix%i at %ix%i: LapVar = %f, Brenner = %f, Tenengrad = %f, NormVar = %f", roi.width, roi.height, roi.x, roi.y, focus.laplacianVariance, focus.brenner, focus.tenengrad, focus.normalizedVariance);
+
+        return (ImageProc_Error) log.success();
+    }
+    catch(  const std::exception& e  ){
+        return (ImageProc_Error) log.error(e.what(), ERR_FOCUS_FATAL);
+    }
+}
+
 } // namespace
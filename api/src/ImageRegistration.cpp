@@ -0,0 +1,228 @@
+/***************************************************************************//**
+ * @file	ImageRegistration.cpp
+ * @brief	Source file to register images by phase correlation
+ *
+ * This file contains all the implementations for the functions defined in:
+ * api/include/ImageRegistration.hpp
+ *
+ * @author	Thibaud Talon
+ * @date	18/10/2026
+ *******************************************************************************/
+
+#include <math.h>
+#include <float.h> // FLT_EPSILON
+#include <opencv2/core/core.hpp>
+#include <opencv2/imgproc/imgproc.hpp> // for createHanningWindow
+#include "UserInterface.hpp"
+#include "ImageProc.hpp"
+#include "ImageBatch.hpp"
+#include "ImageRegistration.hpp"
+
+namespace ImageProc{
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Cache the window and the spectrum of the reference
+ *
+ * @param [in] reference
+ *	Reference image (single channel, CV_8U, CV_16U or CV_32F)
+ ******************************************************************************/
+ImageProc_Error ImageProc_Registration::setReference(const cv::Mat & reference){
+    UserInterface::Log log("ImageProc::Registration::setReference");
+    try
+    {
+        // 1. Check the inputs
+        log.debug("1. Check the inputs");
+        _reference.release();
+        if ( reference.empty() ) return (ImageProc_Error) log.error("No image", ERR_IMG_MATRIX);
+        if ( reference.channels() != 1 ) return (ImageProc_Error) log.error("Image not single channel", ERR_IMG_TYPE);
+        if ( reference.rows < 2 || reference.cols < 2 ) return (ImageProc_Error) log.error("Image too small", ERR_REGISTER_SIZE);
+
+        // 2. Window and size of the transforms
+        _size = reference.size();
+        _dftSize = cv::Size(cv::getOptimalDFTSize(_size.width), cv::getOptimalDFTSize(_size.height));
+        log.debug("2. Frame %ix%i, DFT %ix%i", _size.width, _size.height, _dftSize.width, _dftSize.height);
+        cv::createHanningWindow(_window, _size, CV_32F);
+
+        // 3. Spectrum of the reference
+        log.debug("3. Spectrum of the reference");
+        cv::Mat F;
+        ImageProc_Error error = spectrum(reference, F);
+        if ( error ) return (ImageProc_Error) log.error("Cannot transform the reference", error);
+        _reference = F;
+
+        return (ImageProc_Error) log.success();
+    }
+    catch(  const std::exception& e  ){
+        return (ImageProc_Error) log.error(e.what(), ERR_REGISTER_FATAL);
+    }
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Windowed, padded spectrum of an image (no log, called once per frame)
+ ******************************************************************************/
+ImageProc_Error ImageProc_Registration::spectrum(const cv::Mat & img, cv::Mat & F) const{
+    if ( img.size() != _size ) return ERR_REGISTER_SIZE;
+    if ( img.channels() != 1 ) return ERR_IMG_TYPE;
+
+    // Remove the mean so that the window does not create a peak at zero shift
+    cv::Mat f, padded;
+    img.convertTo(f, CV_32F, 1, -cv::mean(img)(0));
+    cv::multiply(f, _window, f);
+    cv::copyMakeBorder(f, padded, 0, _dftSize.height - _size.height, 0, _dftSize.width - _size.width, cv::BORDER_CONSTANT, cv::Scalar(0));
+    cv::dft(padded, F, cv::DFT_COMPLEX_OUTPUT);
+    return OK_IMAGEPROC;
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Offset of the maximum of a parabola through 3 samples (0 if not a maximum)
+ ******************************************************************************/
+static float parabolicPeak(float left, float center, float right){
+    float denom = left - 2*center + right;
+    return (denom < 0) ? 0.5f*(left - right)/denom : 0.f;
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Shift of an image relative to the reference
+ *
+ * The normalized cross-power spectrum F.conj(R)/|F.conj(R)| is transformed
+ * back and its peak is refined to subpixel with a parabola along each axis.
+ *
+ * @param [in] img
+ *	Image of the same size as the reference
+ * @param [out] shift
+ *	Translation (px) such that img(x) = reference(x - shift)
+ * @param [out] response
+ *	Height of the correlation peak (1 = pure translation, ~0 = no match)
+ ******************************************************************************/
+ImageProc_Error ImageProc_Registration::registerImage(const cv::Mat & img, cv::Point2f & shift, float & response) const{
+    UserInterface::Log log("ImageProc::Registration::registerImage");
+    try
+    {
+        // 1. Check the inputs
+        log.debug("1. Check the inputs");
+        if ( _reference.empty() ) return (ImageProc_Error) log.error("No reference", ERR_REGISTER_NO_REFERENCE);
+        if ( img.empty() ) return (ImageProc_Error) log.error("No image", ERR_IMG_MATRIX);
+
+        // 2. Normalized cross-power spectrum
+        log.debug("2. Normalized cross-power spectrum");
+        cv::Mat F, C;
+        ImageProc_Error error = spectrum(img, F);
+        if ( error ) return (ImageProc_Error) log.error("Image does not match the reference", error);
+        cv::mulSpectrums(F, _reference, C, 0, true);
+        for(int r = 0; r < C.rows; r++){
+            float * p = C.ptr<float>(r);
+            for(int c = 0; c < 2*C.cols; c += 2){
+                float mag = sqrtf(p[c]*p[c] + p[c+1]*p[c+1]);
+                if ( mag > FLT_EPSILON ) {p[c] /= mag; p[c+1] /= mag;}
+                else {p[c] = 0; p[c+1] = 0;}
+            }
+        }
+
+        // 3. Peak of the correlation
+        log.debug("3. Peak of the correlation");
+        cv::Mat_<float> corr;
+        cv::idft(C, corr, cv::DFT_REAL_OUTPUT | cv::DFT_SCALE);
+        double maxVal;
+        cv::Point peak;
+        cv::minMaxLoc(corr, NULL, &maxVal, NULL, &peak);
+
+        const int W = corr.cols, H = corr.rows;
+        float dx = parabolicPeak(corr(peak.y, (peak.x - 1 + W) % W), corr(peak.y, peak.x), corr(peak.y, (peak.x + 1) % W));
+        float dy = parabolicPeak(corr((peak.y - 1 + H) % H, peak.x), corr(peak.y, peak.x), corr((peak.y + 1) % H, peak.x));
+
+        // Circular shifts above half the size are negative
+        shift.x = peak.x + dx;
+        shift.y = peak.y + dy;
+        if ( shift.x > W/2 ) shift.x -= W;
+        if ( shift.y > H/2 ) shift.y -= H;
+        response = maxVal;
+        log.printf("Shift = (%f;%f), response = %f", shift.x, shift.y, response);
+
+        return (ImageProc_Error) log.success();
+    }
+    catch(  const std::exception& e  ){
+        return (ImageProc_Error) log.error(e.what(), ERR_REGISTER_FATAL);
+    }
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Stage of a batch
+ ******************************************************************************/
+ImageProc_Error ImageProc_RegistrationStage::run(ImageProc_FrameResult & result) const{
+    cv::Point2f shift;
+    float response;
+    ImageProc_Error error = _registration.registerImage(result.frame, shift, response);
+    if ( error ) return error;
+    result.values.push_back(shift.x);
+    result.values.push_back(shift.y);
+    result.values.push_back(response);
+    return OK_IMAGEPROC;
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Register a sequence against the reference on several threads
+ *
+ * @param [in] frames
+ *	Images of the same size as the reference
+ * @param [out] shifts
+ *	Shift of each frame ({0;0} if the frame failed)
+ * @param [out] responses
+ *	Height of the correlation peak of each frame (0 if the frame failed)
+ * @param [in] Nthreads
+ *	Number of workers (0 = number of cores)
+ ******************************************************************************/
+ImageProc_Error ImageProc_Registration::registerFrames(const std::vector<cv::Mat> & frames, std::vector<cv::Point2f> & shifts, std::vector<float> & responses, int Nthreads) const{
+    UserInterface::Log log("ImageProc::Registration::registerFrames");
+    try
+    {
+        // 1. Check the inputs
+        log.debug("1. Check the inputs");
+        if ( _reference.empty() ) return (ImageProc_Error) log.error("No reference", ERR_REGISTER_NO_REFERENCE);
+
+        // 2. Register the frames
+        log.debug("2. Register %i frames", (int)frames.size());
+        ImageProc_ListSource source(frames);
+        ImageProc_RegistrationStage stage(*this);
+        std::vector<const ImageProc_Stage *> stages(1, &stage);
+        std::vector<ImageProc_FrameResult> results;
+        ImageProc_Error error = processFrames(source, stages, results, false, Nthreads);
+        if ( error ) return (ImageProc_Error) log.error("Cannot process the frames", error);
+
+        // 3. Collect the shifts
+        log.debug("3. Collect the shifts");
+        shifts.assign(frames.size(), cv::Point2f(0, 0));
+        responses.assign(frames.size(), 0.f);
+        int Nfailed = 0;
+        for(size_t II = 0; II < results.size(); II++){
+            if ( results[II].error ) {Nfailed++; continue;}
+            shifts[II] = cv::Point2f(results[II].values[0], results[II].values[1]);
+            responses[II] = results[II].values[2];
+        }
+        if ( Nfailed > 0 ) log.warning("%i frames could not be registered", Nfailed);
+
+        return (ImageProc_Error) log.success();
+    }
+    catch(  const std::exception& e  ){
+        return (ImageProc_Error) log.error(e.what(), ERR_REGISTER_FATAL);
+    }
+}
+
+} // namespace
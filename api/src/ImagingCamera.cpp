@@ -14,7 +14,10 @@
 #include <opencv2/highgui/highgui.hpp> // video structure
 #include <sys/time.h> // time structure for video
 #include <math.h> // ceil used for video
+#include <time.h> // clock_gettime for the timestamps of the frames
 #include "ImagingCamera.hpp"
+#include "ImageProc.hpp"
+#include "FrameArchive.hpp"
 #include "UserInterface.hpp"
 
 #define IMAGINGCAMERA_MAX_WIDTH 2592
@@ -38,7 +41,7 @@ ImagingCamera_Error ImagingCamera::connect(ImagingCamera_Index cameraID){
         status = IMAGINGCAMERA_OFF;
 
         // 1. Get number of camera devices
-        log.printf("1. Get number of camera devices");
+        log.debug("1. Get number of camera devices");
         DWORD dwNumberOfDevices = 0;
         error = xiGetNumberDevices(&dwNumberOfDevices);
         if( error != XI_OK ) return (ImagingCamera_Error) log.error("Cannot retrieve number of connected cameras", ERR_IMAGINGCAMERA_CANNOT_DETECT);
@@ -46,19 +49,19 @@ ImagingCamera_Error ImagingCamera::connect(ImagingCamera_Index cameraID){
         if( dwNumberOfDevices == 0 ) return (ImagingCamera_Error) log.error("No camera connected", ERR_IMAGINGCAMERA_NO_DETECT);
 
         // 2. Open device
-        log.printf("2. Open device #%i", cameraID);
+        log.debug("2. Open device #%i", cameraID);
         error = xiOpenDevice(cameraID, &handle);
         if( error != XI_OK ) return (ImagingCamera_Error) log.error("No camera connected", ERR_IMAGINGCAMERA_CANNOT_OPEN);
         status = IMAGINGCAMERA_ON;
         index = cameraID;
 
         // 3. Set exposure to 10ms
-        log.printf("3. Set exposure to 10ms");
+        log.debug("3. Set exposure to 10ms");
         error = xiSetParamInt( handle,  XI_PRM_EXPOSURE, 10000);
         if( error != XI_OK ) {status = IMAGINGCAMERA_ERROR; log.error("Cannot set exposure to 10 ms", ERR_IMAGINGCAMERA_SET_EXPOSURE);}
 
         // 4. Set capture _timeout to 5s
-        log.printf("4. Set capture timeout to 5s");
+        log.debug("4. Set capture timeout to 5s");
         _timeout = 5000;
 
         return (ImagingCamera_Error) log.success();
@@ -119,17 +122,17 @@ ImagingCamera_Error ImagingCamera::getImage(cv::Mat & img){
 
     try{
         // 1. Check inputs
-        log.printf("1. Check inputs");
+        log.debug("1. Check inputs");
         img.release();
         if( handle == NULL ) {return (ImagingCamera_Error) log.error("No opened device", ERR_IMAGINGCAMERA_NO_DEVICE);}
 
         // 2. Start acquisition
-        log.printf("2. Start acquisition");
+        log.debug("2. Start acquisition");
         error = xiStartAcquisition(handle);
         if (error != XI_OK) {status = IMAGINGCAMERA_ERROR; return (ImagingCamera_Error) log.error("Cannot start acquisition", ERR_IMAGINGCAMERA_START_ACQUISITION);}
 
         // 3. Take image
-        log.printf("3. Take image");
+        log.debug("3. Take image");
         XI_IMG xi_image;
         memset(&xi_image, 0, sizeof(XI_IMG));
         xi_image.size = sizeof(XI_IMG);
@@ -139,7 +142,7 @@ ImagingCamera_Error ImagingCamera::getImage(cv::Mat & img){
         if (error != XI_OK) {xiStopAcquisition(handle); status = IMAGINGCAMERA_ERROR; return (ImagingCamera_Error) log.error("Cannot take image", ERR_IMAGINGCAMERA_GET_IMAGE);}
 
         // 4. Convert image
-        log.printf("4. Convert image");
+        log.debug("4. Convert image");
         img = cv::Mat(xi_image.height, xi_image.width, CV_8UC1, xi_image.bp);
 
         xiStopAcquisition(handle);
@@ -155,83 +158,269 @@ ImagingCamera_Error ImagingCamera::getImage(cv::Mat & img){
 
 /***************************************************************************//**
  * @author Thibaud Talon
- * @date   21/09/2017
+ * @date   18/10/2026
  *
- * Get an video from the camera
+ * Get an image from the camera and its statistics
  *
- * @param [out] video
- *	OpenCV video to store the frames
- * @param [in] fps
- *	Frames per seconds of the video
- * @param [in] duration_s
- *	Duration of the video in seconds
+ * @param [out] img
+ *	OpenCV image
+ * @param [out] stats
+ *	Histogram, saturation count, min, max, mean and standard deviation of the image
+ * @param [in] Nbins
+ *	Number of bins of the histogram
+ * @param [in] saturation
+ *	Saturation level (0 = maximum of the pixel type)
  ******************************************************************************/
-ImagingCamera_Error ImagingCamera::getVideo(cv::VideoWriter & video, float fps, float duration_s){
-    UserInterface::Log log("ImagingCamera::getVideo");
+ImagingCamera_Error ImagingCamera::getImage(cv::Mat & img, ImageProc::ImageProc_FrameStats & stats, int Nbins, double saturation){
+    UserInterface::Log log("ImagingCamera::getImage");
 
-    try{
-        // 1. Check inputs
-        log.printf("1. Check inputs");
-        if( handle == NULL ) {return (ImagingCamera_Error) log.error("No opened device", ERR_IMAGINGCAMERA_NO_DEVICE);}
-        if (!video.isOpened()) {return (ImagingCamera_Error) log.error("Video not opened", ERR_IMAGINGCAMERA_NO_VIDEO);}
+    ImagingCamera_Error imgError = getImage(img);
+    if ( imgError ) return (ImagingCamera_Error) log.error("Cannot take image", imgError);
 
-        // 2. Enable trigger
-        log.printf("2. Enable trigger");
-        error = xiSetParamInt(handle, XI_PRM_TRG_SOURCE, XI_TRG_SOFTWARE);
-        if (error != XI_OK) {status = IMAGINGCAMERA_ERROR; return (ImagingCamera_Error) log.error("Cannot enable trigger", ERR_IMAGINGCAMERA_ENABLE_TRIGGER);}
+    if ( ImageProc::getFrameStats(img, stats, Nbins, saturation) ) return (ImagingCamera_Error) log.error("Cannot compute the statistics", ERR_IMAGINGCAMERA_FRAME_STATS);
+    log.printf("Mean = %f, max = %f, saturated = %i", stats.mean, stats.max, stats.saturated);
 
-        // 3. Set shutter type to rolling
-        log.printf("3. Set shutter type to rolling");
-        error = xiSetParamInt( handle,  XI_PRM_SHUTTER_TYPE, XI_SHUTTER_ROLLING);
-        if( error != XI_OK ) {status = IMAGINGCAMERA_ERROR; log.error("Cannot set shutter type to rolling mode", ERR_IMAGINGCAMERA_SET_SHUTTER);}
+    return (ImagingCamera_Error) log.success();
+}
 
-        // 4. Initialize timers, buffer images and parameters
-        log.printf("4. Initialize timers, buffer images and parameters");
-        long start, now, delay; // To save the time in millis
-        struct timeval tv; // To save the time
-        XI_IMG xi_image;
-        memset(&xi_image, 0, sizeof(XI_IMG));
-        xi_image.size = sizeof(XI_IMG);
-        xi_image.bp = NULL;
-        xi_image.bp_size = 0;
-        long Nframes = ceil(fps*duration_s);
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Sink writing the frames to an OpenCV video
+ ******************************************************************************/
+class VideoSink : public ImagingCamera_FrameSink{
+public:
+    VideoSink(cv::VideoWriter & video) : _video(video) {}
 
-        // 5. Start acquisition
-        log.printf("5. Start acquisition");
-        error = xiStartAcquisition(handle);
-        if (error != XI_OK) {status = IMAGINGCAMERA_ERROR; return (ImagingCamera_Error) log.error("Cannot start acquisition", ERR_IMAGINGCAMERA_START_ACQUISITION);}
+    ImagingCamera_Error add(const cv::Mat & frame, const ImageProc::ImageProc_FrameStats & stats, int index){
+        _video << frame; // Encoded before the buffer is reused (no place for the statistics)
+        return OK_IMAGINGCAMERA;
+    }
+
+private:
+    cv::VideoWriter & _video;
+};
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Sink queuing the frames and their metadata to a recorder
+ ******************************************************************************/
+class RecorderSink : public ImagingCamera_FrameSink{
+public:
+    RecorderSink(FrameArchive::FrameArchive_Recorder & recorder, const FrameArchive::FrameArchive_Metadata & metadata) : _recorder(recorder), _metadata(metadata), _dropped(0) {}
+
+    ImagingCamera_Error add(const cv::Mat & frame, const ImageProc::ImageProc_FrameStats & stats, int index){
+        struct timespec ts; // Timestamp of the frame
+        clock_gettime(CLOCK_REALTIME, &ts);
+        _metadata.timestamp_ns = (int64_t)ts.tv_sec*1000000000 + ts.tv_nsec;
+        _metadata.frame = index;
+        _metadata.saturated = stats.saturated;
+        _metadata.min = (float) stats.min;
+        _metadata.max = (float) stats.max;
+        _metadata.mean = (float) stats.mean;
+        _metadata.std = (float) stats.std;
+
+        // The recorder encodes the frame later: copy it out of the camera buffer
+        cv::Mat img = frame.clone();
+        FrameArchive::FrameArchive_Error error = _recorder.append(img, _metadata);
+        if ( error == FrameArchive::ERR_QUEUE_FULL ){ // Encoding late: only this frame is lost (gap in the frame numbers)
+            UserInterface::Log log("ImagingCamera::getVideo");
+            log.warning("Frame #%i dropped: recording queue full", index+1);
+            _dropped++;
+            return OK_IMAGINGCAMERA;
+        }
+        if ( error ) return ERR_IMAGINGCAMERA_RECORD;
+        return OK_IMAGINGCAMERA;
+    }
+
+    int dropped(void) const {return _dropped;} // Frames dropped because the queue was full
 
-        // 6. Start video
-        log.printf("6. Start video");
+private:
+    FrameArchive::FrameArchive_Recorder & _recorder;
+    FrameArchive::FrameArchive_Metadata _metadata;
+    int _dropped;
+};
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Trigger the frames of a video at a fixed rate
+ *
+ * Each frame is given to the sink as soon as it is taken, wrapping the
+ * camera buffer, with its histogram and statistics (one pass, see
+ * ImageProc::getFrameStats) for the exposure control and the quality gates.
+ *
+ * @param [in,out] sink
+ *	Consumer of the frames
+ * @param [in] fps
+ *	Frames per seconds of the video
+ * @param [in] duration_s
+ *	Duration of the video in seconds
+ ******************************************************************************/
+ImagingCamera_Error ImagingCamera::captureVideo(ImagingCamera_FrameSink & sink, float fps, float duration_s){
+    UserInterface::Log log("ImagingCamera::captureVideo");
+
+    // 1. Enable trigger
+    log.debug("1. Enable trigger");
+    error = xiSetParamInt(handle, XI_PRM_TRG_SOURCE, XI_TRG_SOFTWARE);
+    if (error != XI_OK) {status = IMAGINGCAMERA_ERROR; return (ImagingCamera_Error) log.error("Cannot enable trigger", ERR_IMAGINGCAMERA_ENABLE_TRIGGER);}
+
+    // 2. Set shutter type to rolling
+    log.debug("2. Set shutter type to rolling");
+    error = xiSetParamInt( handle,  XI_PRM_SHUTTER_TYPE, XI_SHUTTER_ROLLING);
+    if( error != XI_OK ) {status = IMAGINGCAMERA_ERROR; log.error("Cannot set shutter type to rolling mode", ERR_IMAGINGCAMERA_SET_SHUTTER);}
+
+    // 3. Initialize timers, buffer images and parameters
+    log.debug("3. Initialize timers, buffer images and parameters");
+    ImagingCamera_Error error1;
+    ImageProc::ImageProc_FrameStats stats; // Reused by every frame
+    long start, now, delay; // To save the time in millis
+    struct timeval tv; // To save the time
+    XI_IMG xi_image;
+    memset(&xi_image, 0, sizeof(XI_IMG));
+    xi_image.size = sizeof(XI_IMG);
+    xi_image.bp = NULL;
+    xi_image.bp_size = 0;
+    long Nframes = ceil(fps*duration_s);
+
+    // 4. Start acquisition
+    log.debug("4. Start acquisition");
+    ImagingCamera_Error videoError = OK_IMAGINGCAMERA; // First error: the trigger is disabled in any case
+    error = xiStartAcquisition(handle);
+    if (error != XI_OK) {status = IMAGINGCAMERA_ERROR; videoError = (ImagingCamera_Error) log.error("Cannot start acquisition", ERR_IMAGINGCAMERA_START_ACQUISITION);}
+
+    // 5. Start video
+    log.debug("5. Start video");
+    try{
         gettimeofday(&tv, NULL);
         start = (long)tv.tv_sec*1000 + (long)(tv.tv_usec/1000);
-        for (int frame = 0; frame < Nframes; frame++){
+        for (int frame = 0; frame < Nframes && !videoError; frame++){
             // Wait
             delay = (long)(1000*(frame+1)/fps);
             gettimeofday(&tv, NULL);
             now = (long)tv.tv_sec*1000 + (long)(tv.tv_usec/1000);
-            if ( ( now - start ) > delay ) {xiStopAcquisition(handle); return (ImagingCamera_Error) log.error("Framerate too high", ERR_IMAGINGCAMERA_VIDEO_FRAMERATE);}
+            if ( ( now - start ) > delay ) {videoError = (ImagingCamera_Error) log.error("Framerate too high", ERR_IMAGINGCAMERA_VIDEO_FRAMERATE); break;}
             while( ( now - start ) < delay ) {gettimeofday(&tv, NULL); now = (long)tv.tv_sec*1000 + (long)(tv.tv_usec/1000);}
 
             // Trigger next image
             error = xiSetParamInt(handle, XI_PRM_TRG_SOFTWARE, 1);
-            if (error != XI_OK) {xiStopAcquisition(handle); status = IMAGINGCAMERA_ERROR; return (ImagingCamera_Error) log.error("Cannot trigger next image", ERR_IMAGINGCAMERA_TRIGGER);}
+            if (error != XI_OK) {status = IMAGINGCAMERA_ERROR; videoError = (ImagingCamera_Error) log.error("Cannot trigger next image", ERR_IMAGINGCAMERA_TRIGGER); break;}
 
             // Get image
             error = xiGetImage( handle, _timeout, &xi_image);
-            if (error != XI_OK) {xiStopAcquisition(handle); status = IMAGINGCAMERA_ERROR; return (ImagingCamera_Error) log.error("Cannot take image", ERR_IMAGINGCAMERA_GET_IMAGE);}
+            if (error != XI_OK) {status = IMAGINGCAMERA_ERROR; videoError = (ImagingCamera_Error) log.error("Cannot take image", ERR_IMAGINGCAMERA_GET_IMAGE); break;}
+
+            // Statistics of the frame
+            cv::Mat img(xi_image.height, xi_image.width, CV_8UC1, xi_image.bp);
+            if ( ImageProc::getFrameStats(img, stats) ) {videoError = (ImagingCamera_Error) log.error("Cannot compute the statistics", ERR_IMAGINGCAMERA_FRAME_STATS); break;}
 
             // Add to video
-            video << cv::Mat(xi_image.height, xi_image.width, CV_8UC1, xi_image.bp);
-            log.printf("Frame #%i added", frame+1);
+            if ( error1 = sink.add(img, stats, frame) ) {videoError = (ImagingCamera_Error) log.error("Cannot add the frame", error1); break;}
+            log.debug("Frame #%i added", frame+1);
         }
+    }
+    catch( ... ){
+        xiStopAcquisition(handle); // Thrown by the sink: the caller reports it
+        xiSetParamInt(handle, XI_PRM_TRG_SOURCE, XI_TRG_OFF);
+        throw;
+    }
 
-        xiStopAcquisition(handle);
+    xiStopAcquisition(handle);
+
+    // 6. Disable trigger
+    log.debug("6. Disable trigger");
+    error = xiSetParamInt(handle, XI_PRM_TRG_SOURCE, XI_TRG_OFF);
+    if (error != XI_OK) {status = IMAGINGCAMERA_ERROR; log.error("Cannot disable trigger", ERR_IMAGINGCAMERA_DISABLE_TRIGGER); if ( !videoError ) videoError = ERR_IMAGINGCAMERA_DISABLE_TRIGGER;}
+    if ( videoError ) return videoError; // Already logged
+
+    return (ImagingCamera_Error) log.success();
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   21/09/2017
+ *
+ * Get an video from the camera
+ *
+ * @param [out] video
+ *	OpenCV video to store the frames
+ * @param [in] fps
+ *	Frames per seconds of the video
+ * @param [in] duration_s
+ *	Duration of the video in seconds
+ ******************************************************************************/
+ImagingCamera_Error ImagingCamera::getVideo(cv::VideoWriter & video, float fps, float duration_s){
+    UserInterface::Log log("ImagingCamera::getVideo");
+
+    try{
+        // 1. Check inputs
+        log.debug("1. Check inputs");
+        ImagingCamera_Error error1;
+        if( handle == NULL ) {return (ImagingCamera_Error) log.error("No opened device", ERR_IMAGINGCAMERA_NO_DEVICE);}
+        if (!video.isOpened()) {return (ImagingCamera_Error) log.error("Video not opened", ERR_IMAGINGCAMERA_NO_VIDEO);}
+
+        // 2. Capture the video
+        log.debug("2. Capture the video");
+        VideoSink sink(video);
+        if( error1 = captureVideo(sink, fps, duration_s) ) return (ImagingCamera_Error) log.error("Cannot capture the video", error1);
+
+        return (ImagingCamera_Error) log.success();
+
+    }
+    catch( const std::exception& e ){
+        status = IMAGINGCAMERA_ERROR;
+        return (ImagingCamera_Error) log.error(e.what(),ERR_IMAGINGCAMERA_GETVIDEO_FATAL);
+    }
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Record a video without loss
+ *
+ * Each frame is copied out of the camera buffer with its metadata and
+ * queued to the recorder, which encodes and writes it on its own threads.
+ * A frame arriving while the queue is full is dropped with a warning (its
+ * number is missing from the archive) and the recording goes on.
+ *
+ * @param [in,out] recorder
+ *	Opened recorder (segments and encoding chosen by the caller)
+ * @param [in] fps
+ *	Frames per second
+ * @param [in] duration_s
+ *	Duration of the video in seconds
+ ******************************************************************************/
+ImagingCamera_Error ImagingCamera::getVideo(FrameArchive::FrameArchive_Recorder & recorder, float fps, float duration_s){
+    UserInterface::Log log("ImagingCamera::getVideo");
 
-        // 7. Disable trigger
-        log.printf("7. Disable trigger");
-        error = xiSetParamInt(handle, XI_PRM_TRG_SOURCE, XI_TRG_OFF);
-        if (error != XI_OK) {status = IMAGINGCAMERA_ERROR; return (ImagingCamera_Error) log.error("Cannot disable trigger", ERR_IMAGINGCAMERA_DISABLE_TRIGGER);}
+    try{
+        // 1. Check inputs
+        log.debug("1. Check inputs");
+        if( handle == NULL ) {return (ImagingCamera_Error) log.error("No opened device", ERR_IMAGINGCAMERA_NO_DEVICE);}
+        if (!recorder.isOpened()) {return (ImagingCamera_Error) log.error("Recording not started", ERR_IMAGINGCAMERA_NO_VIDEO);}
+
+        // 2. Settings of the frames
+        log.debug("2. Settings of the frames");
+        ImagingCamera_Error error1;
+        int width, height;
+        FrameArchive::FrameArchive_Metadata metadata;
+        memset(&metadata, 0, sizeof(metadata));
+        metadata.camera = index;
+        if( error1 = getExposure(metadata.exposure_us) ) return (ImagingCamera_Error) log.error("Cannot read exposure", error1);
+        if( error1 = getGain(metadata.gain_dB) ) return (ImagingCamera_Error) log.error("Cannot read gain", error1);
+        if( error1 = getROI(metadata.offsetX_px, metadata.offsetY_px, width, height) ) return (ImagingCamera_Error) log.error("Cannot read ROI", error1);
+
+        // 3. Capture the video
+        log.debug("3. Capture the video");
+        RecorderSink sink(recorder, metadata);
+        error1 = captureVideo(sink, fps, duration_s);
+        if( sink.dropped() > 0 ) log.warning("%i frames dropped (encoding slower than the framerate)", sink.dropped());
+        if( error1 ) return (ImagingCamera_Error) log.error("Cannot capture the video", error1);
 
         return (ImagingCamera_Error) log.success();
 
@@ -282,12 +471,12 @@ ImagingCamera_Error ImagingCamera::setROI(int offsetX_px, int offsetY_px, int wi
         if( handle == NULL ) {return (ImagingCamera_Error) log.error("No opened device", ERR_IMAGINGCAMERA_NO_DEVICE);}
 
         // 1. Check inputs
-        log.printf("1. Check inputs");
+        log.debug("1. Check inputs");
         if ( offsetX_px + width_px > IMAGINGCAMERA_MAX_WIDTH ) {width_px = IMAGINGCAMERA_MAX_WIDTH - offsetX_px; log.error("ROI right limit out of bounds", ERR_IMAGINGCAMERA_ROI_WOOB);}
         if ( offsetY_px + height_px > IMAGINGCAMERA_MAX_HEIGHT ) {height_px = IMAGINGCAMERA_MAX_HEIGHT - offsetY_px; log.error("ROI bottom limit out of bounds", ERR_IMAGINGCAMERA_ROI_HOOB);}
 
         // 2. Get current width and height
-        log.printf("2. Get current width and height");
+        log.debug("2. Get current width and height");
         int current_width, current_height;
         error = xiGetParamInt( handle, XI_PRM_WIDTH, &current_width);
         if (error != XI_OK) {status = IMAGINGCAMERA_ERROR; return (ImagingCamera_Error) log.error("Cannot get width", ERR_IMAGINGCAMERA_GET_WIDTH);}
@@ -300,14 +489,14 @@ ImagingCamera_Error ImagingCamera::setROI(int offsetX_px, int offsetY_px, int wi
             if (error != XI_OK) {status = IMAGINGCAMERA_ERROR; return (ImagingCamera_Error) log.error("Cannot change width", ERR_IMAGINGCAMERA_SET_WIDTH);}
             error = xiGetParamInt( handle, XI_PRM_WIDTH, &width_px);
             if (error != XI_OK) {status = IMAGINGCAMERA_ERROR; return (ImagingCamera_Error) log.error("Cannot get width", ERR_IMAGINGCAMERA_GET_WIDTH);}
-            log.printf("3. ROI width set to %i px", width_px);
+            log.debug("3. ROI width set to %i px", width_px);
 
             // 4. Change horizontal offset to %i px
             error = xiSetParamInt(handle, XI_PRM_OFFSET_X , offsetX_px);
             if (error != XI_OK) {status = IMAGINGCAMERA_ERROR; return (ImagingCamera_Error) log.error("Cannot change horizontal offset", ERR_IMAGINGCAMERA_SET_OFFSETX);}
             error = xiGetParamInt( handle, XI_PRM_OFFSET_X , &offsetX_px);
             if (error != XI_OK) {status = IMAGINGCAMERA_ERROR; return (ImagingCamera_Error) log.error("Cannot get horizontal offset", ERR_IMAGINGCAMERA_GET_OFFSETX);}
-            log.printf("4. ROI horizontal offset set to %i px", offsetX_px);
+            log.debug("4. ROI horizontal offset set to %i px", offsetX_px);
         }
         else{
             // 3. Change horizontal offset to %i px
@@ -315,14 +504,14 @@ ImagingCamera_Error ImagingCamera::setROI(int offsetX_px, int offsetY_px, int wi
             if (error != XI_OK) {status = IMAGINGCAMERA_ERROR; return (ImagingCamera_Error) log.error("Cannot change horizontal offset", ERR_IMAGINGCAMERA_SET_OFFSETX);}
             error = xiGetParamInt( handle, XI_PRM_OFFSET_X , &offsetX_px);
             if (error != XI_OK) {status = IMAGINGCAMERA_ERROR; return (ImagingCamera_Error) log.error("Cannot get horizontal offset", ERR_IMAGINGCAMERA_GET_OFFSETX);}
-            log.printf("3. ROI horizontal offset set to %i px", offsetX_px);
+            log.debug("3. ROI horizontal offset set to %i px", offsetX_px);
 
             // 4. Change image width to %i px
             error = xiSetParamInt( handle, XI_PRM_WIDTH, width_px);
             if (error != XI_OK) {status = IMAGINGCAMERA_ERROR; return (ImagingCamera_Error) log.error("Cannot change width", ERR_IMAGINGCAMERA_SET_WIDTH);}
             error = xiGetParamInt( handle, XI_PRM_WIDTH, &width_px);
             if (error != XI_OK) {status = IMAGINGCAMERA_ERROR; return (ImagingCamera_Error) log.error("Cannot get width", ERR_IMAGINGCAMERA_GET_WIDTH);}
-            log.printf("4. ROI width set to %i px", width_px);
+            log.debug("4. ROI width set to %i px", width_px);
         }
 
         if ( offsetY_px + current_height > IMAGINGCAMERA_MAX_HEIGHT){
@@ -331,14 +520,14 @@ ImagingCamera_Error ImagingCamera::setROI(int offsetX_px, int offsetY_px, int wi
             if (error != XI_OK) {status = IMAGINGCAMERA_ERROR; return (ImagingCamera_Error) log.error("Cannot change height", ERR_IMAGINGCAMERA_SET_HEIGHT);}
             error = xiGetParamInt( handle, XI_PRM_HEIGHT, &height_px);
             if (error != XI_OK) {status = IMAGINGCAMERA_ERROR; return (ImagingCamera_Error) log.error("Cannot get height", ERR_IMAGINGCAMERA_GET_HEIGHT);}
-            log.printf("5. ROI height set to %i px", height_px);
+            log.debug("5. ROI height set to %i px", height_px);
 
             // 6. Change vertical offset to %i px
             error = xiSetParamInt(handle, XI_PRM_OFFSET_Y , offsetY_px);
             if (error != XI_OK) {status = IMAGINGCAMERA_ERROR; return (ImagingCamera_Error) log.error("Cannot change vertical offset", ERR_IMAGINGCAMERA_SET_OFFSETY);}
             error = xiGetParamInt( handle, XI_PRM_OFFSET_Y , &offsetY_px);
             if (error != XI_OK) {status = IMAGINGCAMERA_ERROR; return (ImagingCamera_Error) log.error("Cannot get vertical offset", ERR_IMAGINGCAMERA_GET_OFFSETY);}
-            log.printf("6. ROI vertical offset set to %i px", offsetY_px);
+            log.debug("6. ROI vertical offset set to %i px", offsetY_px);
         }
         else{
             // 5. Change vertical offset to %i px
@@ -346,7 +535,7 @@ ImagingCamera_Error ImagingCamera::setROI(int offsetX_px, int offsetY_px, int wi
             if (error != XI_OK) {status = IMAGINGCAMERA_ERROR; return (ImagingCamera_Error) log.error("Cannot change vertical offset", ERR_IMAGINGCAMERA_SET_OFFSETY);}
             error = xiGetParamInt( handle, XI_PRM_OFFSET_Y , &offsetY_px);
             if (error != XI_OK) {status = IMAGINGCAMERA_ERROR; return (ImagingCamera_Error) log.error("Cannot get vertical offset", ERR_IMAGINGCAMERA_GET_OFFSETY);}
-            log.printf("5. ROI vertical offset set to %i px", offsetY_px);
+            log.debug("5. ROI vertical offset set to %i px", offsetY_px);
 
 
             // 6. Change image height to %i px
@@ -354,7 +543,7 @@ ImagingCamera_Error ImagingCamera::setROI(int offsetX_px, int offsetY_px, int wi
             if (error != XI_OK) {status = IMAGINGCAMERA_ERROR; return (ImagingCamera_Error) log.error("Cannot change height", ERR_IMAGINGCAMERA_SET_HEIGHT);}
             error = xiGetParamInt( handle, XI_PRM_HEIGHT, &height_px);
             if (error != XI_OK) {status = IMAGINGCAMERA_ERROR; return (ImagingCamera_Error) log.error("Cannot get height", ERR_IMAGINGCAMERA_GET_HEIGHT);}
-            log.printf("6. ROI height set to %i px", height_px);
+            log.debug("6. ROI height set to %i px", height_px);
         }
 
         return (ImagingCamera_Error) log.success();
@@ -468,22 +657,22 @@ ImagingCamera_Error ImagingCamera::getROI(int & offsetX_px, int & offsetY_px, in
         // 1. Horizontal offset
         error = xiGetParamInt( handle, XI_PRM_OFFSET_X , &offsetX_px);
         if (error != XI_OK) {status = IMAGINGCAMERA_ERROR; return (ImagingCamera_Error) log.error("Cannot get horizontal offset", ERR_IMAGINGCAMERA_GET_OFFSETX);}
-        log.printf("1. ROI horizontal offset = %i px", offsetX_px);
+        log.debug("1. ROI horizontal offset = %i px", offsetX_px);
 
         // 2. Vertical offset
         error = xiGetParamInt( handle, XI_PRM_OFFSET_Y , &offsetY_px);
         if (error != XI_OK) {status = IMAGINGCAMERA_ERROR; return (ImagingCamera_Error) log.error("Cannot get vertical offset", ERR_IMAGINGCAMERA_GET_OFFSETY);}
-        log.printf("2. ROI vertical offset = %i px", offsetY_px);
+        log.debug("2. ROI vertical offset = %i px", offsetY_px);
 
         // 3. Image width
         error = xiGetParamInt( handle, XI_PRM_WIDTH, &width_px);
         if (error != XI_OK) {status = IMAGINGCAMERA_ERROR; return (ImagingCamera_Error) log.error("Cannot get width", ERR_IMAGINGCAMERA_GET_WIDTH);}
-        log.printf("3. ROI width = %i px", width_px);
+        log.debug("3. ROI width = %i px", width_px);
 
         // 4. Image height
         error = xiGetParamInt( handle, XI_PRM_HEIGHT, &height_px);
         if (error != XI_OK) {status = IMAGINGCAMERA_ERROR; return (ImagingCamera_Error) log.error("Cannot get height", ERR_IMAGINGCAMERA_GET_HEIGHT);}
-        log.printf("4. RIO height = %i px", height_px);
+        log.debug("4. RIO height = %i px", height_px);
 
         return (ImagingCamera_Error) log.success();
 
@@ -42,7 +42,7 @@ Mask_Error Mask::connect(void){
     status = MASK_OFF;
 
     // 1. Connect GPIO pins
-    log.printf("1. Connect GPIO pins");
+    log.debug("1. Connect GPIO pins");
     if (enable_gpio.connect(MASK_ENABLE, GPIO_OUTPUT)) {status = MASK_ERROR; log.error("Cannot connect Enable pin", ERR_MASK_CONNECT_PIN);}
     if (reset_gpio.connect(MASK_RESET, GPIO_OUTPUT)) {status = MASK_ERROR; log.error("Cannot connect Rest pin", ERR_MASK_CONNECT_PIN);}
     if (sleep_gpio.connect(MASK_SLEEP, GPIO_OUTPUT)) {status = MASK_ERROR; log.error("Cannot connect Sleep pin", ERR_MASK_CONNECT_PIN);}
@@ -58,16 +58,16 @@ Mask_Error Mask::connect(void){
     wide_gpio.verbose = 0;
 
     // 2. Enable controller
-    log.printf("2. Enable controller");
+    log.debug("2. Enable controller");
     if (enable_gpio.set(0)) {disconnect(); return (Mask_Error) log.error("Cannot Enable controller", ERR_MASK_SET_PIN);}
     if (step_gpio.set(0)) {disconnect(); return (Mask_Error) log.error("Cannot set Step to low", ERR_MASK_SET_PIN);}
 
     // 3. Disable RESET of controller
-    log.printf("3. Disable RESET of controller");
+    log.debug("3. Disable RESET of controller");
     if (reset_gpio.set(1)) {disconnect(); return (Mask_Error) log.error("Cannot disable reset", ERR_MASK_SET_PIN);}
 
     // 4. Put controller in sleep mode
-    log.printf("4. Put controller in sleep mode");
+    log.debug("4. Put controller in sleep mode");
     if (sleep_gpio.set(0)) {status = MASK_ERROR; return (Mask_Error) log.error("Cannot put controller in sleep mode", ERR_MASK_SET_PIN);}
 
     status = MASK_ON;
@@ -130,7 +130,7 @@ Mask_Error Mask::moveTo(Mask_Position pos){
     if (status == MASK_OFF) return (Mask_Error) log.error("Controller is OFF", ERR_MASK_CONTROLLER_OFF);
 
     // 1. Set step size and direction
-    log.printf("1. Set step size and direction");
+    log.debug("1. Set step size and direction");
     GPIO * limit_switch;
     if (pos == MASK_NARROW){
         if (direction_gpio.set(MASK_DIRECTION_NARROW)) { disconnect(); return (Mask_Error) log.error("Cannot set direction of motor", ERR_MASK_SET_PIN);}
@@ -171,12 +171,12 @@ Mask_Error Mask::moveTo(Mask_Position pos){
     }
 
     // 2. Wake up controller
-    log.printf("2. Wake up controller");
+    log.debug("2. Wake up controller");
     if (sleep_gpio.set(1)) { disconnect(); return (Mask_Error) log.error("Cannot set wake up controller", ERR_MASK_SET_PIN);}
     delay(1); // wait 1 ms
 
     // 3. Turn mask
-    log.printf("3. Turn mask");
+    log.debug("3. Turn mask");
     if (step_gpio.set(0)) { disconnect(); return (Mask_Error) log.error("Cannot take step", ERR_MASK_SET_PIN);}
     int limit;
     if ((*limit_switch).get(limit)) { disconnect(); return (Mask_Error) log.error("Cannot read limit switch", ERR_MASK_GET_PIN);}
@@ -189,7 +189,7 @@ Mask_Error Mask::moveTo(Mask_Position pos){
     }
 
     // 4. Put controller in sleep mode
-    log.printf("4. Put controller in sleep mode");
+    log.debug("4. Put controller in sleep mode");
     if (sleep_gpio.set(0)) {status = MASK_ERROR; return (Mask_Error) log.error("Cannot put controller in sleep mode", ERR_MASK_SET_PIN);}
 
     return (Mask_Error) log.success();
@@ -238,7 +238,7 @@ Mask_Error Mask::moveSteps(int steps, int speed, Mask_Resolution resolution){
     if (status == MASK_OFF) return (Mask_Error) log.error("Controller is OFF", ERR_MASK_CONTROLLER_OFF);
 
     // 1. Set step size and direction
-    log.printf("1. Set step size and direction");
+    log.debug("1. Set step size and direction");
     GPIO * limit_switch;
     if (steps > 0){
         if (direction_gpio.set(MASK_DIRECTION_NARROW)) { disconnect(); return (Mask_Error) log.error("Cannot set direction of motor", ERR_MASK_SET_PIN);}
@@ -279,7 +279,7 @@ Mask_Error Mask::moveSteps(int steps, int speed, Mask_Resolution resolution){
     }
 
     // 2. Wake up controller
-    log.printf("2. Wake up controller");
+    log.debug("2. Wake up controller");
     if (sleep_gpio.set(1)) { disconnect(); return (Mask_Error) log.error("Cannot set wake up controller", ERR_MASK_SET_PIN);}
     delay(1); // wait 1 ms
 
@@ -288,7 +288,7 @@ Mask_Error Mask::moveSteps(int steps, int speed, Mask_Resolution resolution){
     int limit;
     int count = 0;
     if ((*limit_switch).get(limit)) { disconnect(); return (Mask_Error) log.error("Cannot read limit switch", ERR_MASK_GET_PIN);}
-    log.printf("Limit = %i", limit);
+    log.debug("Limit = %i", limit);
     while(limit == 0 && count++ < abs(steps)){
         if (step_gpio.set(1)) { disconnect(); return (Mask_Error) log.error("Cannot take step", ERR_MASK_SET_PIN);}
         delay(1000./(2.*speed));
@@ -296,10 +296,10 @@ Mask_Error Mask::moveSteps(int steps, int speed, Mask_Resolution resolution){
         delay(1000./(2.*speed));
         if ((*limit_switch).get(limit)) { disconnect(); return (Mask_Error) log.error("Cannot read limit switch", ERR_MASK_GET_PIN);}
     }
-    log.printf("Limit = %i", limit);
+    log.debug("Limit = %i", limit);
 
     // 4. Put controller in sleep mode
-    log.printf("4. Put controller in sleep mode");
+    log.debug("4. Put controller in sleep mode");
     if (sleep_gpio.set(0)) {status = MASK_ERROR; return (Mask_Error) log.error("Cannot put controller in sleep mode", ERR_MASK_SET_PIN);}
 
     return (Mask_Error) log.success();
@@ -30,7 +30,7 @@ Mirror_Error Mirror::connect(uint64_t _addr64, XBee *_xbee){
         status = MIRROR_OFF;
 
         // 1. Check XBee connection
-        log.printf("1. Check XBee connection");
+        log.debug("1. Check XBee connection");
         if ((*_xbee).status == XBEE_OFF){
             if((*_xbee).reset()){
                 status = MIRROR_ERROR;
@@ -40,7 +40,7 @@ Mirror_Error Mirror::connect(uint64_t _addr64, XBee *_xbee){
         xbee = _xbee;
 
         // 2. Connect node
-        log.printf("2. Connect node");
+        log.debug("2. Connect node");
         log.printf("Address = 0x%lx Hz",_addr64);
         if((*xbee).connectNode(node, _addr64)){
             status = MIRROR_ERROR;
@@ -112,7 +112,7 @@ Mirror_Error Mirror::command(uint8_t cmd, uint8_t action, uint8_t period, uint32
     {
         int message_len = 8;
 
-        log.printf("1. Format message");
+        log.debug("1. Format message");
         unsigned char buffer[message_len];
         log.printf("Command = %i", cmd);
         buffer[0] = cmd;
@@ -126,20 +126,20 @@ Mirror_Error Mirror::command(uint8_t cmd, uint8_t action, uint8_t period, uint32
         buffer[6] = (data) & 0xFF;
 
 
-        log.printf("2. Calculate checksum");
+        log.debug("2. Calculate checksum");
         int checksum = 0;
         for(int II=0; II<message_len-1; II++) checksum += buffer[II];
         checksum &= 0xFF;
         buffer[7] = 0xFF - checksum;
 
-        log.printf("3. Send Message = %x %x %x %x %x %x %x %x", buffer[0], buffer[1], buffer[2], buffer[3], buffer[4], buffer[5], buffer[6], buffer[7]);
+        log.debug("3. Send Message = %x %x %x %x %x %x %x %x", buffer[0], buffer[1], buffer[2], buffer[3], buffer[4], buffer[5], buffer[6], buffer[7]);
         if((*xbee).send(node, buffer, message_len)){
             status = MIRROR_ERROR;
             return (Mirror_Error) log.error("Error sending message", ERR_MIRROR_SEND);
         }
 
 
-        log.printf("4. Receive acknowledgment");
+        log.debug("4. Receive acknowledgment");
         unsigned char *msg;
         int len;
         if((*xbee).receive(node, &msg, &len, timeout)){
@@ -154,7 +154,7 @@ Mirror_Error Mirror::command(uint8_t cmd, uint8_t action, uint8_t period, uint32
         log.printf("Received message = %x %x %x %x %x %x %x %x", msg[0], msg[1], msg[2], msg[3], msg[4], msg[5], msg[6], msg[7]);
 
 
-        log.printf("5. Checksum verification");
+        log.debug("5. Checksum verification");
         checksum = 0;
         for(int II=len-6; II<len; II++) checksum += msg[II];
         if ((checksum & 0xFF) != 0xFF){
@@ -163,7 +163,7 @@ Mirror_Error Mirror::command(uint8_t cmd, uint8_t action, uint8_t period, uint32
         }
 
 
-        log.printf("6. Error checking");
+        log.debug("6. Error checking");
         if(msg[0] != cmd){
             status = MIRROR_ERROR;
             return (Mirror_Error) log.error("Error in received command", ERR_MIRROR_RECEIVED_COMMAND);
@@ -239,7 +239,7 @@ Mirror_Error Mirror::readRegister(uint8_t address, int32_t &value){
     {
         int message_len = 8;
 
-        log.printf("1. Format message");
+        log.debug("1. Format message");
         unsigned char buffer[message_len];
         buffer[0] = 150;
         buffer[1] = 0;
@@ -250,20 +250,20 @@ Mirror_Error Mirror::readRegister(uint8_t address, int32_t &value){
         buffer[6] = address;
 
 
-        log.printf("2. Calculate checksum");
+        log.debug("2. Calculate checksum");
         int checksum = 0;
         for(int II=0; II<message_len-1; II++) checksum += buffer[II];
         checksum &= 0xFF;
         buffer[7] = 0xFF - checksum;
 
-        log.printf("3. Send Message = %x %x %x %x %x %x %x %x", buffer[0], buffer[1], buffer[2], buffer[3], buffer[4], buffer[5], buffer[6], buffer[7]);
+        log.debug("3. Send Message = %x %x %x %x %x %x %x %x", buffer[0], buffer[1], buffer[2], buffer[3], buffer[4], buffer[5], buffer[6], buffer[7]);
         if((*xbee).send(node, buffer, message_len)){
             status = MIRROR_ERROR;
             return (Mirror_Error) log.error("Error sending message", ERR_MIRROR_SEND);
         }
 
 
-        log.printf("4. Receive acknowledgment");
+        log.debug("4. Receive acknowledgment");
         unsigned char *msg;
         int len;
         if((*xbee).receive(node, &msg, &len, 1)){
@@ -278,7 +278,7 @@ Mirror_Error Mirror::readRegister(uint8_t address, int32_t &value){
         log.printf("Received message = %x %x %x %x %x %x %x %x", msg[0], msg[1], msg[2], msg[3], msg[4], msg[5], msg[6], msg[7]);
 
 
-        log.printf("5. Checksum verification");
+        log.debug("5. Checksum verification");
         checksum = 0;
         for(int II=len-6; II<len; II++) checksum += msg[II];
         if ((checksum & 0xFF) != 0xFF){
@@ -287,7 +287,7 @@ Mirror_Error Mirror::readRegister(uint8_t address, int32_t &value){
         }
 
 
-        log.printf("6. Error checking");
+        log.debug("6. Error checking");
         if(msg[0] != address){
             status = MIRROR_ERROR;
             return (Mirror_Error) log.error("Error in received command", ERR_MIRROR_RECEIVED_COMMAND);
@@ -325,7 +325,7 @@ Mirror_Error Mirror::movePicomotor(PicomotorID picoID, int32_t distance, Picomot
         Mirror_Error error;
 
         // 1. Turn ON picomotor HV
-        log.printf("1. Turn ON picomotor HV");
+        log.debug("1. Turn ON picomotor HV");
         error = command(163, 0, 0, 0, 10);
         if (error){
             status = MIRROR_ERROR;
@@ -337,7 +337,7 @@ Mirror_Error Mirror::movePicomotor(PicomotorID picoID, int32_t distance, Picomot
         if (mode == moveByTicks) mode_text = "ticks";
         if (mode == moveByInterval) mode_text = "intervals";
         if (mode == moveByAbsolutePosition) mode_text = "nm";
-        log.printf("2. Move picomotor by %i %s", distance, mode_text);
+        log.debug("2. Move picomotor by %i %s", distance, mode_text);
         uint8_t cmd = 180 + 10*picoID + mode;
         int time = 0.005*distance;
         if (mode == moveByInterval) time *= 30;
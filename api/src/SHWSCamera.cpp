@@ -13,6 +13,7 @@
 #include <stdio.h>
 #include "bgapi2_genicam.hpp"
 #include "SHWSCamera.hpp"
+#include "ImageProc.hpp"
 #include "UserInterface.hpp"
 
 using namespace BGAPI2;
@@ -47,7 +48,7 @@ SHWSCamera_Error SHWSCamera::connect(SHWSCamera_Index sensorID){
         try{
             systemList = SystemList::GetInstance();
             systemList->Refresh();
-            log.printf("1. Number of available systems = %i",systemList->size());
+            LOG_DEBUG(log, "1. Number of available systems = %i",systemList->size());
         }
         catch (BGAPI2::Exceptions::IException& ex){
             log.error(ex.GetErrorDescription(), ERR_SHWSCAMERA_SYSTEM_LIST_FATAL);
@@ -58,14 +59,14 @@ SHWSCamera_Error SHWSCamera::connect(SHWSCamera_Index sensorID){
             for (SystemList::iterator sysIterator = systemList->begin(); sysIterator != systemList->end(); sysIterator++){
                 try{
                     sysIterator->second->Open();
-                    log.printf("2. Open system with name = %s",(char *)sysIterator->second->GetFileName());
+                    LOG_DEBUG(log, "2. Open system with name = %s",(char *)sysIterator->second->GetFileName());
                     sSystemID = sysIterator->first;
 
                     // 3. Count available interfaces
                     try{
                         interfaceList = sysIterator->second->GetInterfaces();
                         interfaceList->Refresh(100); // timeout of 100 msec
-                        log.printf("3. Number of detected interfaces = %i",interfaceList->size());
+                        LOG_DEBUG(log, "3. Number of detected interfaces = %i",interfaceList->size());
                     }
                     catch (BGAPI2::Exceptions::IException& ex){
                         log.error(ex.GetErrorDescription(), ERR_SHWSCAMERA_INTERFACE_LIST_FATAL);
@@ -75,25 +76,25 @@ SHWSCamera_Error SHWSCamera::connect(SHWSCamera_Index sensorID){
                     try{
                         for (InterfaceList::iterator ifIterator = interfaceList->begin(); ifIterator != interfaceList->end(); ifIterator++){
                             try{
-                                log.printf("4. Open interface with name = %s",(char *)ifIterator->second->GetDisplayName());
+                                LOG_DEBUG(log, "4. Open interface with name = %s",(char *)ifIterator->second->GetDisplayName());
                                 ifIterator->second->Open();
 
                                 // 5. Search for any camera is connected to this interface
                                 deviceList = ifIterator->second->GetDevices();
                                 deviceList->Refresh(100);
-                                log.printf("5. Number of connected camera = %i",deviceList->size());
+                                LOG_DEBUG(log, "5. Number of connected camera = %i",deviceList->size());
                                 if(deviceList->size() == 0){
-                                    log.printf("6. Close interface");
+                                    log.debug("6. Close interface");
                                     ifIterator->second->Close();
                                 }
                                 else{
                                     sInterfaceID = ifIterator->first;
-                                    log.printf("6. Interface type = %s",(char *)ifIterator->second->GetTLType());
+                                    LOG_DEBUG(log, "6. Interface type = %s",(char *)ifIterator->second->GetTLType());
                                     if( ifIterator->second->GetTLType() == "GEV" ){
                                         unsigned int IPAddress = ifIterator->second->GetNode("GevInterfaceSubnetIPAddress")->GetInt();
-                                        log.printf("7. GevInterfaceSubnetIPAddress = %i.%i.%i.%i", (IPAddress>>8*3)&0xff, (IPAddress>>8*2)&0xff, (IPAddress>>8)&0xff, (IPAddress)&0xff);
+                                        log.debug("7. GevInterfaceSubnetIPAddress = %i.%i.%i.%i", (IPAddress>>8*3)&0xff, (IPAddress>>8*2)&0xff, (IPAddress>>8)&0xff, (IPAddress)&0xff);
                                         unsigned int SubnetMask = ifIterator->second->GetNode("GevInterfaceSubnetMask")->GetInt();
-                                        log.printf("8. GevInterfaceSubnetMask = %i.%i.%i.%i", (SubnetMask>>8*3)&0xff, (SubnetMask>>8*2)&0xff, (SubnetMask>>8)&0xff, (SubnetMask)&0xff);
+                                        log.debug("8. GevInterfaceSubnetMask = %i.%i.%i.%i", (SubnetMask>>8*3)&0xff, (SubnetMask>>8*2)&0xff, (SubnetMask>>8)&0xff, (SubnetMask)&0xff);
                                     }
                                     break;
                                 }
@@ -157,15 +158,15 @@ SHWSCamera_Error SHWSCamera::connect(SHWSCamera_Index sensorID){
 
         for (DeviceList::iterator devIterator = deviceList->begin(); devIterator != deviceList->end(); devIterator++){
             try{
-                log.printf("9. Open device with DeviceID = %s",(char *)devIterator->first);
+                log.debug("9. Open device with DeviceID = %s",(char *)devIterator->first);
                 devIterator->second->Open();
                 sDeviceID = devIterator->first;
 
                 if(devIterator->second->GetTLType() == "GEV"){
                     unsigned int IPAddress = devIterator->second->GetRemoteNode("GevCurrentIPAddress")->GetInt();
-                    log.printf("11. GevCurrentIPAddress = %i.%i.%i.%i", (IPAddress>>8*3)&0xff, (IPAddress>>8*2)&0xff, (IPAddress>>8)&0xff, (IPAddress)&0xff);
+                    log.debug("11. GevCurrentIPAddress = %i.%i.%i.%i", (IPAddress>>8*3)&0xff, (IPAddress>>8*2)&0xff, (IPAddress>>8)&0xff, (IPAddress)&0xff);
                     unsigned int SubnetMask = devIterator->second->GetRemoteNode("GevCurrentSubnetMask")->GetInt();
-                    log.printf("12. GevCurrentSubnetMask = %i.%i.%i.%i", (SubnetMask>>8*3)&0xff, (SubnetMask>>8*2)&0xff, (SubnetMask>>8)&0xff, (SubnetMask)&0xff);
+                    log.debug("12. GevCurrentSubnetMask = %i.%i.%i.%i", (SubnetMask>>8*3)&0xff, (SubnetMask>>8*2)&0xff, (SubnetMask>>8)&0xff, (SubnetMask)&0xff);
                 }
                 break;
             }
@@ -194,7 +195,7 @@ SHWSCamera_Error SHWSCamera::connect(SHWSCamera_Index sensorID){
     // Set trigger mode off (FreeRun)
     try{
         pDevice->GetRemoteNode("TriggerMode")->SetString("Off");
-        log.printf("13. Set trigger mode OFF = %s", (char *)pDevice->GetRemoteNode("TriggerMode")->GetValue());
+        LOG_DEBUG(log, "13. Set trigger mode OFF = %s", (char *)pDevice->GetRemoteNode("TriggerMode")->GetValue());
     }
     catch (BGAPI2::Exceptions::IException& ex){
         status = SHWSCAMERA_ERROR;
@@ -204,7 +205,7 @@ SHWSCamera_Error SHWSCamera::connect(SHWSCamera_Index sensorID){
     // Set packet delay to 50000 tics
     try{
         pDevice->GetRemoteNode("GevSCPD")->SetInt(50000);
-        log.printf("14. Set Packet delay = %i tics", pDevice->GetRemoteNode("GevSCPD")->GetInt());
+        LOG_DEBUG(log, "14. Set Packet delay = %i tics", pDevice->GetRemoteNode("GevSCPD")->GetInt());
     }
     catch (BGAPI2::Exceptions::IException& ex){
         status = SHWSCAMERA_ERROR;
@@ -212,11 +213,11 @@ SHWSCamera_Error SHWSCamera::connect(SHWSCamera_Index sensorID){
     }
 
     // Set capture timeout to 1s
-    log.printf("15. Timeout = %i ms", 1000);
+    log.debug("15. Timeout = %i ms", 1000);
     _timeout = 1000;
 
     // Set maximum number of retries if image is incomplete or timeout occurs to 10
-    log.printf("16. Maximum # of retries = %i", 10);
+    log.debug("16. Maximum # of retries = %i", 10);
     _retry_max = 10;
 
     return (SHWSCamera_Error) log.success();
@@ -302,7 +303,7 @@ SHWSCamera_Error SHWSCamera::getImage(cv::Mat & img){
     SHWSCamera_Error error = OK_SHWSCAMERA;
 
     // 1. Check inputs
-    log.printf("1. Check inputs");
+    log.debug("1. Check inputs");
     img.release();
     if(pDevice==NULL) {return (SHWSCamera_Error) log.error("No opened device",ERR_SHWSCAMERA_NO_DEVICE);}
 
@@ -317,7 +318,7 @@ SHWSCamera_Error SHWSCamera::getImage(cv::Mat & img){
     try{
         datastreamList = pDevice->GetDataStreams();
         datastreamList->Refresh();
-        log.printf("2. Detected datastreams = %i",datastreamList->size());
+        LOG_DEBUG(log, "2. Detected datastreams = %i",datastreamList->size());
     }
     catch (BGAPI2::Exceptions::IException& ex){
         status = SHWSCAMERA_ERROR;
@@ -328,7 +329,7 @@ SHWSCamera_Error SHWSCamera::getImage(cv::Mat & img){
     try{
         for (DataStreamList::iterator dstIterator = datastreamList->begin(); dstIterator != datastreamList->end(); dstIterator++){
 
-            log.printf("3. Open first datastream with ID = %s",(char*)dstIterator->first);
+            log.debug("3. Open first datastream with ID = %s",(char*)dstIterator->first);
             dstIterator->second->Open();
             sDataStreamID = dstIterator->first;
             break;
@@ -357,7 +358,7 @@ SHWSCamera_Error SHWSCamera::getImage(cv::Mat & img){
             pBuffer = new BGAPI2::Buffer();
             bufferList->Add(pBuffer);
         }
-        log.printf("4. Announced buffers = %i",bufferList->GetAnnouncedCount());
+        LOG_DEBUG(log, "4. Announced buffers = %i",bufferList->GetAnnouncedCount());
     }
     catch (BGAPI2::Exceptions::IException& ex){
         status = SHWSCAMERA_ERROR;
@@ -369,7 +370,7 @@ SHWSCamera_Error SHWSCamera::getImage(cv::Mat & img){
         for (BufferList::iterator bufIterator = bufferList->begin(); bufIterator != bufferList->end(); bufIterator++){
             bufIterator->second->QueueBuffer();
         }
-        log.printf("5. Queued buffers = %i",bufferList->GetQueuedCount());
+        LOG_DEBUG(log, "5. Queued buffers = %i",bufferList->GetQueuedCount());
     }
     catch (BGAPI2::Exceptions::IException& ex){
         status = SHWSCAMERA_ERROR;
@@ -380,7 +381,7 @@ SHWSCamera_Error SHWSCamera::getImage(cv::Mat & img){
     //START DataStream acquisition
     try{
         pDataStream->StartAcquisitionContinuous();
-        log.printf("6. DataStream started");
+        log.debug("6. DataStream started");
     }
     catch (BGAPI2::Exceptions::IException& ex){
         status = SHWSCAMERA_ERROR;
@@ -391,7 +392,7 @@ SHWSCamera_Error SHWSCamera::getImage(cv::Mat & img){
     //START CAMERA
     try{
         pDevice->GetRemoteNode("AcquisitionStart")->Execute();
-        log.printf("7. Start camera = %s",(char*)pDevice->GetModel());
+        LOG_DEBUG(log, "7. Start camera = %s",(char*)pDevice->GetModel());
     }
     catch (BGAPI2::Exceptions::IException& ex){
         status = SHWSCAMERA_ERROR;
@@ -407,16 +408,16 @@ SHWSCamera_Error SHWSCamera::getImage(cv::Mat & img){
         while(!imgTaken && (count++ < _retry_max)){
             pBufferFilled = pDataStream->GetFilledBuffer(_timeout);
             if(pBufferFilled == NULL){
-                log.printf("8. Error: Buffer Timeout after %i msec", _timeout);;
+                log.debug("8. Error: Buffer Timeout after %i msec", _timeout);;
             }
             else if(pBufferFilled->GetIsIncomplete() == true){
-                log.printf("8. Error: Image is incomplete");
+                log.debug("8. Error: Image is incomplete");
                 // queue buffer again
                 pBufferFilled->QueueBuffer();
             }
             else{
-                log.printf("8. Image taken with ID = %i",pBufferFilled->GetFrameID());
-                img = cv::Mat(pBufferFilled->GetHeight(),pBufferFilled->GetWidth(),CV_8UC1,pBufferFilled->GetMemPtr() );
+                LOG_DEBUG(log, "8. Image taken with ID = %i",pBufferFilled->GetFrameID());
+                img = cv::Mat(pBufferFilled->GetHeight(),pBufferFilled->GetWidth(),CV_8UC1,pBufferFilled->GetMemPtr() ).clone(); // The buffers are deleted below
                 imgTaken = true;
             }
         }
@@ -436,11 +437,11 @@ SHWSCamera_Error SHWSCamera::getImage(cv::Mat & img){
         //SEARCH FOR 'AcquisitionAbort'
         if(pDevice->GetRemoteNodeList()->GetNodePresent("AcquisitionAbort")){
             pDevice->GetRemoteNode("AcquisitionAbort")->Execute();
-            log.printf("9. Abort device = %s",(char*)pDevice->GetModel());
+            LOG_DEBUG(log, "9. Abort device = %s",(char*)pDevice->GetModel());
         }
 
         pDevice->GetRemoteNode("AcquisitionStop")->Execute();
-        log.printf("9. Stop device = %s",(char*)pDevice->GetModel());
+        LOG_DEBUG(log, "9. Stop device = %s",(char*)pDevice->GetModel());
     }
     catch (BGAPI2::Exceptions::IException& ex){
         status = SHWSCAMERA_ERROR;
@@ -450,22 +451,24 @@ SHWSCamera_Error SHWSCamera::getImage(cv::Mat & img){
 
     //STOP DataStream acquisition
     try{
+#if LOG_COMPILED_LEVEL <= LOG_LEVEL_DEBUG
         if( pDataStream->GetTLType() == "GEV" ){
-            log.printf("10. DataStream Statistic: GoodFrames = %i",pDataStream->GetNodeList()->GetNode("GoodFrames")->GetInt());
-            log.printf("11. DataStream Statistic: CorruptedFrames = %i",pDataStream->GetNodeList()->GetNode("CorruptedFrames")->GetInt());
-            log.printf("12. DataStream Statistic: LostFrames = %i",pDataStream->GetNodeList()->GetNode("LostFrames")->GetInt());
-            log.printf("13. DataStream Statistic: ResendRequests = %i",pDataStream->GetNodeList()->GetNode("ResendRequests")->GetInt());
-            log.printf("14. DataStream Statistic: ResendPackets = %i",pDataStream->GetNodeList()->GetNode("ResendPackets")->GetInt());
-            log.printf("15. DataStream Statistic: LostPackets = %i",pDataStream->GetNodeList()->GetNode("LostPackets")->GetInt());
-            log.printf("16. DataStream Statistic: Bandwidth = %i",pDataStream->GetNodeList()->GetNode("Bandwidth")->GetInt());
+            LOG_DEBUG(log, "10. DataStream Statistic: GoodFrames = %i",pDataStream->GetNodeList()->GetNode("GoodFrames")->GetInt());
+            LOG_DEBUG(log, "11. DataStream Statistic: CorruptedFrames = %i",pDataStream->GetNodeList()->GetNode("CorruptedFrames")->GetInt());
+            LOG_DEBUG(log, "12. DataStream Statistic: LostFrames = %i",pDataStream->GetNodeList()->GetNode("LostFrames")->GetInt());
+            LOG_DEBUG(log, "13. DataStream Statistic: ResendRequests = %i",pDataStream->GetNodeList()->GetNode("ResendRequests")->GetInt());
+            LOG_DEBUG(log, "14. DataStream Statistic: ResendPackets = %i",pDataStream->GetNodeList()->GetNode("ResendPackets")->GetInt());
+            LOG_DEBUG(log, "15. DataStream Statistic: LostPackets = %i",pDataStream->GetNodeList()->GetNode("LostPackets")->GetInt());
+            LOG_DEBUG(log, "16. DataStream Statistic: Bandwidth = %i",pDataStream->GetNodeList()->GetNode("Bandwidth")->GetInt());
         }
+#endif
 
         //BufferList Information
-        log.printf("17. BufferList Information: DeliveredCount = %i",bufferList->GetDeliveredCount());
-        log.printf("18. BufferList Information: UnderrunCount = %i",bufferList->GetUnderrunCount());
+        LOG_DEBUG(log, "17. BufferList Information: DeliveredCount = %i",bufferList->GetDeliveredCount());
+        LOG_DEBUG(log, "18. BufferList Information: UnderrunCount = %i",bufferList->GetUnderrunCount());
 
         pDataStream->StopAcquisition();
-        log.printf("19. DataStream stopped");
+        log.debug("19. DataStream stopped");
         bufferList->DiscardAllBuffers();
     }
     catch (BGAPI2::Exceptions::IException& ex){
@@ -481,7 +484,7 @@ SHWSCamera_Error SHWSCamera::getImage(cv::Mat & img){
             bufferList->RevokeBuffer(pBuffer);
             delete pBuffer;
         }
-        log.printf("20. Buffers after revoke = %i",bufferList->size());
+        LOG_DEBUG(log, "20. Buffers after revoke = %i",bufferList->size());
         pDataStream->Close();
     }
     catch (BGAPI2::Exceptions::IException& ex){
@@ -494,6 +497,33 @@ SHWSCamera_Error SHWSCamera::getImage(cv::Mat & img){
     else return (SHWSCamera_Error) log.success();
 }
 
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Get an image from the camera and its statistics
+ *
+ * @param [out] img
+ *	OpenCV image
+ * @param [out] stats
+ *	Histogram, saturation count, min, max, mean and standard deviation of the image
+ * @param [in] Nbins
+ *	Number of bins of the histogram
+ * @param [in] saturation
+ *	Saturation level (0 = maximum of the pixel type)
+ ******************************************************************************/
+SHWSCamera_Error SHWSCamera::getImage(cv::Mat & img, ImageProc::ImageProc_FrameStats & stats, int Nbins, double saturation){
+    UserInterface::Log log("SHWSCamera::getImage");
+
+    SHWSCamera_Error error = getImage(img);
+    if(error) return (SHWSCamera_Error) log.error("Error getting an image",error);
+
+    if(ImageProc::getFrameStats(img, stats, Nbins, saturation)) return (SHWSCamera_Error) log.error("Error computing the statistics",ERR_SHWSCAMERA_FRAME_STATS);
+    log.printf("Mean = %f, max = %f, saturated = %i", stats.mean, stats.max, stats.saturated);
+
+    return (SHWSCamera_Error) log.success();
+}
+
 /***************************************************************************//**
  * @author Thibaud Talon
  * @date   23/09/2017
@@ -551,12 +581,12 @@ SHWSCamera_Error SHWSCamera::setROI(int offsetX_px, int offsetY_px, int width_px
     if(pDevice==NULL) {return (SHWSCamera_Error) log.error("No opened device",ERR_SHWSCAMERA_NO_DEVICE);}
 
     // 1. Check inputs
-    log.printf("1. Check inputs");
+    log.debug("1. Check inputs");
     if ( offsetX_px + width_px > SHWSCAMERA_MAX_WIDTH ) {width_px = SHWSCAMERA_MAX_WIDTH - offsetX_px; log.error("ROI right limit out of bounds", ERR_SHWSCAMERA_ROI_WOOB);}
     if ( offsetY_px + height_px > SHWSCAMERA_MAX_HEIGHT ) {height_px = SHWSCAMERA_MAX_HEIGHT - offsetY_px; log.error("ROI bottom limit out of bounds", ERR_SHWSCAMERA_ROI_HOOB);}
 
     // 2. Get current width and height
-    log.printf("2. Get current width and height");
+    log.debug("2. Get current width and height");
     int current_width, current_height;
     try{
         current_width = pDevice->GetRemoteNode("Width")->GetInt();
@@ -589,7 +619,7 @@ SHWSCamera_Error SHWSCamera::setROI(int offsetX_px, int offsetY_px, int width_px
             status = SHWSCAMERA_ERROR;
             return (SHWSCamera_Error) log.error(ex.GetErrorDescription(), ERR_SHWSCAMERA_GET_WIDTH);
         }
-        log.printf("3. ROI width set to %i px", width_px);
+        log.debug("3. ROI width set to %i px", width_px);
 
 
         // 4. Change horizontal offset to %i px
@@ -607,7 +637,7 @@ SHWSCamera_Error SHWSCamera::setROI(int offsetX_px, int offsetY_px, int width_px
             status = SHWSCAMERA_ERROR;
             return (SHWSCamera_Error) log.error(ex.GetErrorDescription(), ERR_SHWSCAMERA_GET_OFFSETX);
         }
-        log.printf("4. ROI horizontal offset set to %i px", offsetX_px);
+        log.debug("4. ROI horizontal offset set to %i px", offsetX_px);
     }
     else{
         // 3. Change horizontal offset to %i px
@@ -625,7 +655,7 @@ SHWSCamera_Error SHWSCamera::setROI(int offsetX_px, int offsetY_px, int width_px
             status = SHWSCAMERA_ERROR;
             return (SHWSCamera_Error) log.error(ex.GetErrorDescription(), ERR_SHWSCAMERA_GET_OFFSETX);
         }
-        log.printf("3. ROI horizontal offset set to %i px", offsetX_px);
+        log.debug("3. ROI horizontal offset set to %i px", offsetX_px);
 
         // 4. Change image width to %i px
         try{
@@ -642,7 +672,7 @@ SHWSCamera_Error SHWSCamera::setROI(int offsetX_px, int offsetY_px, int width_px
             status = SHWSCAMERA_ERROR;
             return (SHWSCamera_Error) log.error(ex.GetErrorDescription(), ERR_SHWSCAMERA_GET_WIDTH);
         }
-        log.printf("3. ROI width set to %i px", width_px);
+        log.debug("3. ROI width set to %i px", width_px);
     }
 
     if ( offsetY_px + current_height > SHWSCAMERA_MAX_HEIGHT){
@@ -661,7 +691,7 @@ SHWSCamera_Error SHWSCamera::setROI(int offsetX_px, int offsetY_px, int width_px
             status = SHWSCAMERA_ERROR;
             return (SHWSCamera_Error) log.error(ex.GetErrorDescription(), ERR_SHWSCAMERA_GET_HEIGHT);
         }
-        log.printf("5. ROI height set to %i px", height_px);
+        log.debug("5. ROI height set to %i px", height_px);
 
         // 6. Change vertical offset to %i px
         try{
@@ -678,7 +708,7 @@ SHWSCamera_Error SHWSCamera::setROI(int offsetX_px, int offsetY_px, int width_px
             status = SHWSCAMERA_ERROR;
             return (SHWSCamera_Error) log.error(ex.GetErrorDescription(), ERR_SHWSCAMERA_SET_OFFSETY);
         }
-        log.printf("6. Roi vertical offset set to %i px", offsetY_px);
+        log.debug("6. Roi vertical offset set to %i px", offsetY_px);
     }
     else{
         // 5. Change vertical offset to %i px
@@ -696,7 +726,7 @@ SHWSCamera_Error SHWSCamera::setROI(int offsetX_px, int offsetY_px, int width_px
             status = SHWSCAMERA_ERROR;
             return (SHWSCamera_Error) log.error(ex.GetErrorDescription(), ERR_SHWSCAMERA_SET_OFFSETY);
         }
-        log.printf("5. ROI vertical offset set to %i px", offsetY_px);
+        log.debug("5. ROI vertical offset set to %i px", offsetY_px);
 
 
         // 6. Change image height to %i px
@@ -714,7 +744,7 @@ SHWSCamera_Error SHWSCamera::setROI(int offsetX_px, int offsetY_px, int width_px
             status = SHWSCAMERA_ERROR;
             return (SHWSCamera_Error) log.error(ex.GetErrorDescription(), ERR_SHWSCAMERA_GET_HEIGHT);
         }
-        log.printf("6. ROI height set to %i px", height_px);
+        log.debug("6. ROI height set to %i px", height_px);
     }
 
     return (SHWSCamera_Error) log.success();
@@ -915,7 +945,7 @@ SHWSCamera_Error SHWSCamera::getROI(int & offsetX_px, int & offsetY_px, int & wi
         status = SHWSCAMERA_ERROR;
         return (SHWSCamera_Error) log.error(ex.GetErrorDescription(), ERR_SHWSCAMERA_GET_OFFSETX);
     }
-    log.printf("1. ROI horizontal offset = %i px", offsetX_px);
+    log.debug("1. ROI horizontal offset = %i px", offsetX_px);
 
     try{
         offsetY_px = pDevice->GetRemoteNode("OffsetY")->GetInt();
@@ -924,7 +954,7 @@ SHWSCamera_Error SHWSCamera::getROI(int & offsetX_px, int & offsetY_px, int & wi
         status = SHWSCAMERA_ERROR;
         return (SHWSCamera_Error) log.error(ex.GetErrorDescription(), ERR_SHWSCAMERA_SET_OFFSETY);
     }
-    log.printf("2. ROI vertical offset = %i px", offsetY_px);
+    log.debug("2. ROI vertical offset = %i px", offsetY_px);
 
     try{
         width_px = pDevice->GetRemoteNode("Width")->GetInt();
@@ -933,7 +963,7 @@ SHWSCamera_Error SHWSCamera::getROI(int & offsetX_px, int & offsetY_px, int & wi
         status = SHWSCAMERA_ERROR;
         return (SHWSCamera_Error) log.error(ex.GetErrorDescription(), ERR_SHWSCAMERA_GET_WIDTH);
     }
-    log.printf("3. ROI width = %i px", width_px);
+    log.debug("3. ROI width = %i px", width_px);
 
     try{
         height_px = pDevice->GetRemoteNode("Height")->GetInt();
@@ -942,7 +972,7 @@ SHWSCamera_Error SHWSCamera::getROI(int & offsetX_px, int & offsetY_px, int & wi
         status = SHWSCAMERA_ERROR;
         return (SHWSCamera_Error) log.error(ex.GetErrorDescription(), ERR_SHWSCAMERA_GET_HEIGHT);
     }
-    log.printf("4. ROI height = %i px", height_px);
+    log.debug("4. ROI height = %i px", height_px);
 
     return (SHWSCamera_Error) log.success();
 }
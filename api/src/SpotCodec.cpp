@@ -0,0 +1,420 @@
+/***************************************************************************//**
+ * @file	SpotCodec.cpp
+ * @brief	Source file to compress spot images without loss
+ *
+ * This file contains all the implementations for the functions defined in:
+ * api/include/SpotCodec.hpp
+ *
+ * @author	Thibaud Talon
+ * @date	18/10/2026
+ *******************************************************************************/
+
+#include <string.h>
+#include <stdint.h>
+#include <algorithm> // std::min, std::max
+#include <opencv2/core/core.hpp>
+#include "SpotCodec.hpp"
+#include "UserInterface.hpp"
+
+namespace SpotCodec{
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Bits written MSB first
+ ******************************************************************************/
+class BitWriter{
+public:
+    BitWriter(std::vector<uchar> & out) : _out(out), _acc(0), _N(0) {}
+    void put(uint32_t value, int bits){ // value < 2^bits, bits <= 32
+        _acc = (_acc << bits) | value;
+        _N += bits;
+        while ( _N >= 8 ){
+            _N -= 8;
+            _out.push_back((uchar)(_acc >> _N));
+        }
+    }
+    void flush(void){ // Pad the last byte with 0
+        if ( _N ) put(0, 8 - _N);
+    }
+private:
+    std::vector<uchar> & _out;
+    uint64_t _acc;
+    int _N; // Bits of _acc not written yet
+};
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Bits read MSB first (0 after the end, see overrun)
+ ******************************************************************************/
+class BitReader{
+public:
+    BitReader(const uchar * data, size_t Nbytes) : _p(data), _end(data + Nbytes), _acc(0), _N(0), _Nbytes(Nbytes), _read(0) {}
+    uint32_t get(int bits){ // bits <= 32
+        if ( _N < bits ) refill();
+        _N -= bits;
+        return (uint32_t)((_acc >> _N) & ((1ULL << bits) - 1));
+    }
+    int zeros(int max){ // Leading zeros (at most max <= 56), not consumed
+        refill();
+        uint64_t top = _acc << (64 - _N);
+        int N = top ? __builtin_clzll(top) : 64;
+        return std::min(N, max);
+    }
+    bool overrun(void) const {return _read*8 - _N > _Nbytes*8;} // More bits read than written
+private:
+    void refill(void){
+        while ( _N <= 56 ){
+            _acc = (_acc << 8) | (_p < _end ? *_p++ : 0);
+            _N += 8;
+            _read++;
+        }
+    }
+    const uchar * _p;
+    const uchar * _end;
+    uint64_t _acc;
+    int _N; // Bits of _acc not read yet
+    uint64_t _Nbytes, _read;
+};
+
+static inline uint32_t zigzag(int e){
+    return (uint32_t)((e << 1) ^ (e >> 31));
+}
+
+static inline int unzigzag(uint32_t u){
+    return (int)(u >> 1) ^ -(int)(u & 1);
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Residuals of a row (zigzag-mapped)
+ *
+ * The prediction is the median of left, up and left + up - up-left,
+ * i.e. left + up - up-left clamped between left and up. The loop has no
+ * branch so that it is vectorized. up = NULL on the first row of a strip
+ * (prediction = left).
+ ******************************************************************************/
+template <typename T>
+static void predictRow(const T * row, const T * up, int cols, uint32_t * residuals){
+    residuals[0] = zigzag((int)row[0] - (up ? (int)up[0] : 0));
+    if ( up == NULL ){
+        for(int II = 1; II < cols; II++) residuals[II] = zigzag((int)row[II] - (int)row[II-1]);
+        return;
+    }
+    for(int II = 1; II < cols; II++){
+        int a = row[II-1], b = up[II], c = up[II-1];
+        int low = std::min(a, b), high = std::max(a, b);
+        int prediction = std::min(std::max(a + b - c, low), high);
+        residuals[II] = zigzag((int)row[II] - prediction);
+    }
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Code the residuals of a strip by blocks
+ *
+ *	1 gamma(r): run of r blocks without residual
+ *	0 k(5 bits) codes: block Rice-coded with parameter k, each residual u is
+ *		(u >> k) zeros, a one and the k low bits of u, or SPOTCODEC_ESCAPE
+ *		zeros and u on rawBits bits
+ ******************************************************************************/
+static void codeResiduals(const uint32_t * residuals, size_t N, int rawBits, BitWriter & bits){
+    size_t II = 0;
+    while ( II < N ){
+        // Run of blocks without residual
+        size_t run = 0;
+        for(size_t end = std::min(N, II + SPOTCODEC_BLOCK_SIZE); II < N; end = std::min(N, II + SPOTCODEC_BLOCK_SIZE)){
+            size_t JJ = II;
+            while ( JJ < end && residuals[JJ] == 0 ) JJ++;
+            if ( JJ < end ) break;
+            II = end;
+            run++;
+        }
+        if ( run ){
+            int Nbits = 32 - __builtin_clz((uint32_t) run);
+            bits.put(1, 1);
+            bits.put(0, Nbits - 1);
+            bits.put((uint32_t) run, Nbits);
+            continue;
+        }
+
+        // Rice-coded block
+        size_t end = std::min(N, II + SPOTCODEC_BLOCK_SIZE);
+        uint64_t sum = 0;
+        for(size_t JJ = II; JJ < end; JJ++) sum += residuals[JJ];
+        int k = 0;
+        while ( k < rawBits - 1 && ((uint64_t)(end - II) << (k+1)) <= sum ) k++;
+        bits.put(0, 1);
+        bits.put(k, 5);
+        for(; II < end; II++){
+            uint32_t u = residuals[II], q = u >> k;
+            if ( q < SPOTCODEC_ESCAPE ){
+                bits.put(1, q + 1);
+                if ( k ) bits.put(u & ((1u << k) - 1), k);
+            }
+            else{
+                bits.put(0, SPOTCODEC_ESCAPE);
+                bits.put(u, rawBits);
+            }
+        }
+    }
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Decode the residuals of a strip (false if the code is corrupted)
+ ******************************************************************************/
+static bool decodeResiduals(BitReader & bits, size_t N, int rawBits, uint32_t * residuals){
+    size_t II = 0;
+    while ( II < N ){
+        if ( bits.get(1) ){
+            int Nzeros = bits.zeros(32);
+            if ( Nzeros >= 32 ) return false;
+            bits.get(Nzeros);
+            uint64_t run = bits.get(Nzeros + 1);
+            size_t end = (size_t) std::min<uint64_t>(N, II + run*SPOTCODEC_BLOCK_SIZE);
+            memset(residuals + II, 0, (end - II)*sizeof(uint32_t));
+            II = end;
+            continue;
+        }
+        int k = bits.get(5);
+        if ( k >= rawBits ) return false;
+        for(size_t end = std::min(N, II + SPOTCODEC_BLOCK_SIZE); II < end; II++){
+            int q = bits.zeros(SPOTCODEC_ESCAPE);
+            if ( q == SPOTCODEC_ESCAPE ){
+                bits.get(SPOTCODEC_ESCAPE);
+                residuals[II] = bits.get(rawBits);
+            }
+            else{
+                bits.get(q + 1);
+                residuals[II] = ((uint32_t) q << k) | bits.get(k);
+            }
+        }
+        if ( bits.overrun() ) return false;
+    }
+    return !bits.overrun();
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Encode / decode a strip of rows
+ ******************************************************************************/
+template <typename T>
+static void encodeStrip(const cv::Mat & img, int rowStart, int rowEnd, std::vector<uchar> & out){
+    int rawBits = 8*sizeof(T) + 1;
+    std::vector<uint32_t> residuals((size_t)(rowEnd - rowStart)*img.cols);
+    for(int II = rowStart; II < rowEnd; II++){
+        predictRow<T>(img.ptr<T>(II), (II > rowStart) ? img.ptr<T>(II-1) : NULL, img.cols, &residuals[(size_t)(II - rowStart)*img.cols]);
+    }
+    out.clear();
+    out.reserve(residuals.size()*sizeof(T)/2);
+    BitWriter bits(out);
+    codeResiduals(&residuals[0], residuals.size(), rawBits, bits);
+    bits.flush();
+}
+
+template <typename T>
+static bool decodeStrip(const uchar * data, size_t Nbytes, int rowStart, int rowEnd, cv::Mat & img){
+    int rawBits = 8*sizeof(T) + 1;
+    std::vector<uint32_t> residuals((size_t)(rowEnd - rowStart)*img.cols);
+    BitReader bits(data, Nbytes);
+    if ( !decodeResiduals(bits, residuals.size(), rawBits, &residuals[0]) ) return false;
+
+    const int maxValue = (1 << (8*sizeof(T))) - 1;
+    bool valid = true;
+    for(int II = rowStart; II < rowEnd; II++){
+        T * row = img.ptr<T>(II);
+        const T * up = (II > rowStart) ? img.ptr<T>(II-1) : NULL;
+        const uint32_t * residual = &residuals[(size_t)(II - rowStart)*img.cols];
+        int x = unzigzag(residual[0]) + (up ? (int)up[0] : 0);
+        valid &= (x >= 0 && x <= maxValue);
+        row[0] = (T) x;
+        for(int III = 1; III < img.cols; III++){
+            int prediction = row[III-1];
+            if ( up ){
+                int a = row[III-1], b = up[III], c = up[III-1];
+                prediction = std::min(std::max(a + b - c, std::min(a, b)), std::max(a, b));
+            }
+            x = unzigzag(residual[III]) + prediction;
+            valid &= (x >= 0 && x <= maxValue);
+            row[III] = (T) x;
+        }
+    }
+    return valid;
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Encode / decode the strips in parallel
+ ******************************************************************************/
+class EncodeStripsBody : public cv::ParallelLoopBody{
+public:
+    EncodeStripsBody(const cv::Mat & img, int stripRows, std::vector< std::vector<uchar> > & strips) :
+        _img(img), _stripRows(stripRows), _strips(strips) {}
+    void operator()(const cv::Range & range) const{
+        for(int k = range.start; k < range.end; k++){
+            int rowStart = k*_stripRows;
+            int rowEnd = std::min(_img.rows, rowStart + _stripRows);
+            if ( _img.depth() == CV_8U ) encodeStrip<uchar>(_img, rowStart, rowEnd, _strips[k]);
+            else encodeStrip<ushort>(_img, rowStart, rowEnd, _strips[k]);
+        }
+    }
+private:
+    const cv::Mat & _img;
+    int _stripRows;
+    std::vector< std::vector<uchar> > & _strips;
+};
+
+class DecodeStripsBody : public cv::ParallelLoopBody{
+public:
+    DecodeStripsBody(const std::vector<const uchar *> & data, const uint32_t * Nbytes, int stripRows, cv::Mat & img, std::vector<uchar> & valid) :
+        _data(data), _Nbytes(Nbytes), _stripRows(stripRows), _img(img), _valid(valid) {}
+    void operator()(const cv::Range & range) const{
+        for(int k = range.start; k < range.end; k++){
+            int rowStart = k*_stripRows;
+            int rowEnd = std::min(_img.rows, rowStart + _stripRows);
+            if ( _img.depth() == CV_8U ) _valid[k] = decodeStrip<uchar>(_data[k], _Nbytes[k], rowStart, rowEnd, _img);
+            else _valid[k] = decodeStrip<ushort>(_data[k], _Nbytes[k], rowStart, rowEnd, _img);
+        }
+    }
+private:
+    const std::vector<const uchar *> & _data;
+    const uint32_t * _Nbytes;
+    int _stripRows;
+    cv::Mat & _img;
+    std::vector<uchar> & _valid;
+};
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Compress a frame without loss
+ *
+ * The strips are encoded in parallel; the result does not depend on the
+ * number of threads.
+ *
+ * @param [in] img
+ *	Frame (CV_8UC1 or CV_16UC1)
+ * @param [out] data
+ *	Encoded frame
+ * @param [in] stripRows
+ *	Rows per strip (fewer rows = more parallelism, slightly larger code)
+ ******************************************************************************/
+SpotCodec_Error encode(const cv::Mat & img, std::vector<uchar> & data, int stripRows){
+    UserInterface::Log log("SpotCodec::encode");
+    try{
+        // 1. Check inputs
+        log.debug("1. Check inputs");
+        if ( img.empty() || img.dims != 2 ) return (SpotCodec_Error) log.error("No image", ERR_ENCODE_IMAGE);
+        if ( img.type() != CV_8UC1 && img.type() != CV_16UC1 ) return (SpotCodec_Error) log.error("Type of image not supported (CV_8UC1 or CV_16UC1)", ERR_ENCODE_TYPE);
+        if ( stripRows <= 0 ) return (SpotCodec_Error) log.error("Rows per strip must be positive", ERR_ENCODE_STRIPS);
+
+        // 2. Encode the strips in parallel
+        int Nstrips = (img.rows + stripRows - 1)/stripRows;
+        log.debug("2. Encode %i strips in parallel", Nstrips);
+        std::vector< std::vector<uchar> > strips(Nstrips);
+        cv::parallel_for_(cv::Range(0, Nstrips), EncodeStripsBody(img, stripRows, strips));
+
+        // 3. Header, sizes and strips
+        log.debug("3. Header, sizes and strips");
+        SpotCodec_Header header;
+        memset(&header, 0, sizeof(header));
+        memcpy(header.magic, SPOTCODEC_MAGIC, sizeof(header.magic));
+        header.version = SPOTCODEC_VERSION;
+        header.depth = (uint8_t) img.depth();
+        header.rows = img.rows;
+        header.cols = img.cols;
+        header.stripRows = stripRows;
+
+        size_t Nbytes = sizeof(header) + Nstrips*sizeof(uint32_t);
+        for(int k = 0; k < Nstrips; k++) Nbytes += strips[k].size();
+        data.resize(Nbytes);
+        uchar * p = &data[0];
+        memcpy(p, &header, sizeof(header));
+        p += sizeof(header);
+        for(int k = 0; k < Nstrips; k++){
+            uint32_t size = (uint32_t) strips[k].size();
+            memcpy(p, &size, sizeof(size));
+            p += sizeof(size);
+        }
+        for(int k = 0; k < Nstrips; k++){
+            if ( !strips[k].empty() ) memcpy(p, &strips[k][0], strips[k].size());
+            p += strips[k].size();
+        }
+        log.debug("%i bytes (ratio %.2f)", (int) Nbytes, (double) img.total()*img.elemSize()/Nbytes);
+
+        return (SpotCodec_Error) log.success();
+    }
+    catch( const std::exception& e ){
+        return (SpotCodec_Error) log.error(e.what(), ERR_ENCODE_FATAL);
+    }
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Decompress a frame
+ *
+ * @param [in] data
+ *	Encoded frame
+ * @param [in] Nbytes
+ *	Bytes of the encoded frame
+ * @param [out] img
+ *	Frame (CV_8UC1 or CV_16UC1)
+ ******************************************************************************/
+SpotCodec_Error decode(const uchar * data, size_t Nbytes, cv::Mat & img){
+    UserInterface::Log log("SpotCodec::decode");
+    try{
+        // 1. Check the header
+        log.debug("1. Check the header");
+        SpotCodec_Header header;
+        if ( data == NULL || Nbytes < sizeof(header) ) return (SpotCodec_Error) log.error("Not an encoded frame", ERR_DECODE_FORMAT);
+        memcpy(&header, data, sizeof(header));
+        if ( memcmp(header.magic, SPOTCODEC_MAGIC, sizeof(header.magic)) != 0 ) return (SpotCodec_Error) log.error("Not an encoded frame", ERR_DECODE_FORMAT);
+        if ( header.version != SPOTCODEC_VERSION ) return (SpotCodec_Error) log.error("Version not supported", ERR_DECODE_FORMAT);
+        if ( (header.depth != CV_8U && header.depth != CV_16U) || header.rows <= 0 || header.cols <= 0 || header.stripRows <= 0 ) return (SpotCodec_Error) log.error("Corrupted header", ERR_DECODE_FORMAT);
+
+        // 2. Strips
+        log.debug("2. Strips");
+        int Nstrips = (header.rows + header.stripRows - 1)/header.stripRows;
+        if ( Nbytes - sizeof(header) < Nstrips*sizeof(uint32_t) ) return (SpotCodec_Error) log.error("Truncated frame", ERR_DECODE_CORRUPTED);
+        std::vector<uint32_t> sizes(Nstrips);
+        memcpy(&sizes[0], data + sizeof(header), Nstrips*sizeof(uint32_t));
+        std::vector<const uchar *> strips(Nstrips);
+        size_t offset = sizeof(header) + Nstrips*sizeof(uint32_t);
+        for(int k = 0; k < Nstrips; k++){
+            if ( sizes[k] > Nbytes - offset ) return (SpotCodec_Error) log.error("Truncated frame", ERR_DECODE_CORRUPTED);
+            strips[k] = data + offset;
+            offset += sizes[k];
+        }
+
+        // 3. Decode the strips in parallel
+        log.debug("3. Decode %i strips in parallel", Nstrips);
+        img.create(header.rows, header.cols, CV_MAKETYPE(header.depth, 1));
+        std::vector<uchar> valid(Nstrips, 0);
+        cv::parallel_for_(cv::Range(0, Nstrips), DecodeStripsBody(strips, &sizes[0], header.stripRows, img, valid));
+        for(int k = 0; k < Nstrips; k++) if ( !valid[k] ) return (SpotCodec_Error) log.error("Corrupted strip", ERR_DECODE_CORRUPTED);
+
+        return (SpotCodec_Error) log.success();
+    }
+    catch( const std::exception& e ){
+        return (SpotCodec_Error) log.error(e.what(), ERR_DECODE_FATAL);
+    }
+}
+
+}
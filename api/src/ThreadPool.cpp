@@ -0,0 +1,165 @@
+/***************************************************************************//**
+ * @file	ThreadPool.cpp
+ * @brief	Source file to run tasks on a pool of worker threads
+ *
+ * This file contains all the implementations for the functions defined in:
+ * api/include/ThreadPool.hpp
+ *
+ * @author	Thibaud Talon
+ * @date	18/10/2026
+ *******************************************************************************/
+
+#include <pthread.h>
+#include <unistd.h> // sysconf
+#include "ThreadPool.hpp"
+#include "UserInterface.hpp"
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Start the workers
+ *
+ * @param [in] Nthreads
+ *	Number of worker threads (0 = number of cores)
+ * @param [in] maxQueued
+ *	Maximum number of tasks waiting in the queue (0 = unbounded)
+ ******************************************************************************/
+ThreadPool::ThreadPool(int Nthreads, int maxQueued){
+    UserInterface::Log log("ThreadPool::ThreadPool");
+
+    _maxQueued = maxQueued;
+    _running = 0;
+    _stop = false;
+    pthread_mutex_init(&_mutex, NULL);
+    pthread_cond_init(&_hasTask, NULL);
+    pthread_cond_init(&_hasRoom, NULL);
+    pthread_cond_init(&_idle, NULL);
+
+    if ( Nthreads <= 0 ) Nthreads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    if ( Nthreads <= 0 ) Nthreads = 1;
+
+    log.printf("Start %i workers", Nthreads);
+    for(int II = 0; II < Nthreads; II++){
+        pthread_t thread;
+        if ( pthread_create(&thread, NULL, worker, this) != 0 ) {log.error("Cannot create worker", ERR_THREADPOOL_CREATE); break;}
+        _threads.push_back(thread);
+    }
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Run the queued tasks and join the workers
+ ******************************************************************************/
+ThreadPool::~ThreadPool(void){
+    pthread_mutex_lock(&_mutex);
+    _stop = true;
+    pthread_cond_broadcast(&_hasTask);
+    pthread_cond_broadcast(&_hasRoom); // submit() returns ERR_THREADPOOL_STOPPED
+    pthread_mutex_unlock(&_mutex);
+
+    for(size_t II = 0; II < _threads.size(); II++) pthread_join(_threads[II], NULL);
+
+    pthread_cond_destroy(&_idle);
+    pthread_cond_destroy(&_hasRoom);
+    pthread_cond_destroy(&_hasTask);
+    pthread_mutex_destroy(&_mutex);
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Queue a task
+ *
+ * @param [in] task
+ *	Task to run
+ * @param [in] autoDelete
+ *	Delete the task once it has run
+ * @param [in] block
+ *	Wait for room in a bounded queue (otherwise return ERR_THREADPOOL_FULL)
+ ******************************************************************************/
+ThreadPool_Error ThreadPool::submit(ThreadPool_Task * task, bool autoDelete, bool block){
+    pthread_mutex_lock(&_mutex);
+    while ( !_stop && _maxQueued > 0 && (int)_queue.size() >= _maxQueued ){
+        if ( !block ) {pthread_mutex_unlock(&_mutex); return ERR_THREADPOOL_FULL;}
+        pthread_cond_wait(&_hasRoom, &_mutex);
+    }
+    if ( _stop || _threads.empty() ) {pthread_mutex_unlock(&_mutex); return ERR_THREADPOOL_STOPPED;}
+
+    Entry entry = {task, autoDelete};
+    _queue.push_back(entry);
+    pthread_cond_signal(&_hasTask);
+    pthread_mutex_unlock(&_mutex);
+    return OK_THREADPOOL;
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Wait until all the submitted tasks are done
+ ******************************************************************************/
+void ThreadPool::wait(void){
+    pthread_mutex_lock(&_mutex);
+    while ( !_queue.empty() || _running > 0 ) pthread_cond_wait(&_idle, &_mutex);
+    pthread_mutex_unlock(&_mutex);
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Number of tasks queued or running
+ ******************************************************************************/
+int ThreadPool::pending(void){
+    pthread_mutex_lock(&_mutex);
+    int N = (int)_queue.size() + _running;
+    pthread_mutex_unlock(&_mutex);
+    return N;
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Loop of a worker thread: run the queued tasks until the pool stops
+ *
+ * An exception thrown by a task is logged and does not stop the worker.
+ ******************************************************************************/
+void * ThreadPool::worker(void * arg){
+    ThreadPool * pool = (ThreadPool *) arg;
+
+    pthread_mutex_lock(&pool->_mutex);
+    while ( true ){
+        while ( pool->_queue.empty() && !pool->_stop ) pthread_cond_wait(&pool->_hasTask, &pool->_mutex);
+        if ( pool->_queue.empty() ) break; // Stopped and nothing left to run
+
+        Entry entry = pool->_queue.front();
+        pool->_queue.pop_front();
+        pool->_running++;
+        pthread_cond_signal(&pool->_hasRoom);
+        pthread_mutex_unlock(&pool->_mutex);
+
+        try{
+            entry.task->run();
+        }
+        catch( const std::exception& e ){
+            UserInterface::Log log("ThreadPool::worker");
+            log.error(e.what(), ERR_THREADPOOL_TASK);
+        }
+        catch( ... ){
+            UserInterface::Log log("ThreadPool::worker");
+            log.error("Unknown exception in a task", ERR_THREADPOOL_TASK);
+        }
+        if ( entry.autoDelete ) delete entry.task;
+
+        pthread_mutex_lock(&pool->_mutex);
+        pool->_running--;
+        if ( pool->_queue.empty() && pool->_running == 0 ) pthread_cond_broadcast(&pool->_idle);
+    }
+    pthread_mutex_unlock(&pool->_mutex);
+    return NULL;
+}
@@ -14,21 +14,95 @@
 #include <stdio.h>
 #include <stdarg.h> // va_list
 #include <stdlib.h> // atof
+#include <math.h>   // fabsf, signbit
 #include <iostream> // streams (clog)
 #include <fstream>  // std::ifstream
 #include <string.h> // strchr
+#include <ctype.h>  // tolower
 #include <iomanip>  // stew, setfill
 #include <time.h>   // time_t, struct tm, difftime, time, mktime
 #include <sys/time.h>
+#include <sstream>  // std::ostringstream
+#include <vector>
+#include <string>
+#include <algorithm> // std::min, std::max
+#include <stdint.h>
+#include <fcntl.h>    // open
+#include <unistd.h>   // close
+#include <sys/mman.h> // mmap
+#include <sys/stat.h> // fstat
+#include <pthread.h>
 #include "UserInterface.hpp"
 
 namespace UserInterface {
 
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Copy a printf into a record of the given level
+ ******************************************************************************/
+void Log::record(int level, const char * fmt, va_list va){
+    if ( level < getLogLevel() ) return;
+
+    Log_Record * record = openLogRecord();
+    record->name = _name;
+    record->fmt = fmt;
+    record->increment = increment++;
+    record->level = level;
+    record->kind = LOG_PRINTF;
+    record->code = 0;
+    record->Nbytes = packLogArguments(fmt, va, record->args, LOG_ARGS_SIZE);
+    commitLogRecord(record);
+}
+
+#if LOG_COMPILED_LEVEL <= LOG_LEVEL_DEBUG
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Steps of a function (LOG_LEVEL_DEBUG)
+ *
+ * @param [in] fmt
+ *	Formated text (see: http://www.cplusplus.com/reference/cstdio/printf/)
+ ******************************************************************************/
+void Log::debug (const char * fmt, ...){
+    va_list va;
+    va_start(va, fmt);
+    record(LOG_LEVEL_DEBUG, fmt, va);
+    va_end(va);
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   21/09/2017
+ *
+ * Display and return success (LOG_LEVEL_DEBUG)
+ *
+ ******************************************************************************/
+int Log::success(){
+    if ( LOG_LEVEL_DEBUG < getLogLevel() ) return OK;
+
+    Log_Record * record = openLogRecord();
+    record->name = _name;
+    record->fmt = NULL;
+    record->increment = increment++;
+    record->level = LOG_LEVEL_DEBUG;
+    record->kind = LOG_SUCCESS;
+    record->code = OK;
+    record->Nbytes = 0;
+
+    commitLogRecord(record);
+    return OK;
+}
+#endif
+
+#if LOG_COMPILED_LEVEL <= LOG_LEVEL_INFO
 /***************************************************************************//**
  * @author Thibaud Talon
  * @date   21/09/2017
  *
- * Display a matrix in the log
+ * Display a matrix in the log (formatted on the calling thread, not a hot path)
  *
  * @param [in] text
  *	Name of the matrix
@@ -36,21 +110,30 @@ namespace UserInterface {
  *	Matrix to display
  ******************************************************************************/
 void Log::printMat(const char* text, cv::Mat & mat){
+    if ( LOG_LEVEL_INFO < getLogLevel() ) return;
+
     int N = mat.rows;
+    std::ostringstream lines;
     for(int II=0; II<N; II++){
+        struct timeval tv;
+        struct tm local;
+        char time_str[100];
         gettimeofday(&tv, NULL);
-        rawtime = tv.tv_sec;
-        strftime( time_str, 100, "%F\t%T", localtime (&rawtime));
-        std::cout << time_str << "." << std::setfill('0') << std::setw(6) << tv.tv_usec << '\t' << _name << '\t' << increment << '\t' << text << " = " << mat.row(II) << std::endl;
+        strftime( time_str, 100, "%F\t%T", localtime_r (&tv.tv_sec, &local));
+        lines << time_str << "." << std::setfill('0') << std::setw(6) << tv.tv_usec << '\t' << _name << '\t' << increment << '\t' << text << " = " << mat.row(II) << '\n';
         increment++;
     }
+    writeLogText(lines.str().c_str());
 }
 
 /***************************************************************************//**
  * @author Thibaud Talon
  * @date   21/09/2017
  *
- * Classic printf function but in the log format
+ * Classic printf function but in the log format (LOG_LEVEL_INFO)
+ *
+ * The arguments are copied into the record, the formatting is done by the
+ * background thread.
  *
  * @param [in] fmt
  *	Formated text (see: http://www.cplusplus.com/reference/cstdio/printf/)
@@ -58,123 +141,213 @@ void Log::printMat(const char* text, cv::Mat & mat){
 void Log::printf (const char * fmt, ...){
     va_list va;
     va_start(va, fmt);
-    char buffer[256];
-    vsprintf(buffer,fmt, va);
+    record(LOG_LEVEL_INFO, fmt, va);
     va_end(va);
+}
+#endif
 
-    gettimeofday(&tv, NULL);
-    rawtime = tv.tv_sec;
-    strftime( time_str, 100, "%F\t%T", localtime (&rawtime));
-    std::cout << time_str << "." << std::setfill('0') << std::setw(6) << tv.tv_usec << '\t' << _name << '\t' << increment << '\t' << buffer << std::endl;
-    increment++;
+#if LOG_COMPILED_LEVEL <= LOG_LEVEL_WARNING
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Display a warning (LOG_LEVEL_WARNING, "WARNING: " is added to the text)
+ *
+ * @param [in] fmt
+ *	Formated text (see: http://www.cplusplus.com/reference/cstdio/printf/)
+ ******************************************************************************/
+void Log::warning (const char * fmt, ...){
+    va_list va;
+    va_start(va, fmt);
+    record(LOG_LEVEL_WARNING, fmt, va);
+    va_end(va);
 }
+#endif
 
+#if LOG_COMPILED_LEVEL <= LOG_LEVEL_ERROR
 /***************************************************************************//**
  * @author Thibaud Talon
  * @date   21/09/2017
  *
- * Display and return errors
+ * Display and return errors (LOG_LEVEL_ERROR)
  *
  * @param [in] errorText
- *	Description of the error
+ *	Description of the error (copied, may be temporary)
  * @param [in] errorInt
  *	Error code
  ******************************************************************************/
 int Log::error(const char* errorText, int errorInt){
-    gettimeofday(&tv, NULL);
-    rawtime = tv.tv_sec;
-    strftime( time_str, 100, "%F\t%T", localtime (&rawtime));
-    std::cout << time_str << "." << std::setfill('0') << std::setw(6) << tv.tv_usec << '\t' << _name << '\t' << increment << "\tERROR = " << errorText << " (" << errorInt << ")" << std::endl;
-    increment++;
+    if ( LOG_LEVEL_ERROR < getLogLevel() ) return errorInt;
+
+    Log_Record * record = openLogRecord();
+    record->name = _name;
+    record->fmt = NULL;
+    record->increment = increment++;
+    record->level = LOG_LEVEL_ERROR;
+    record->kind = LOG_ERROR;
+    record->code = errorInt;
+
+    if ( errorText == NULL ) errorText = "";
+    int length = 0;
+    while ( length < LOG_ARGS_SIZE - 1 && errorText[length] != 0 ) length++;
+    memcpy(record->args, errorText, length);
+    record->args[length] = 0;
+    record->Nbytes = length + 1;
+
+    commitLogRecord(record);
     return errorInt;
 }
+#endif
 
 /***************************************************************************//**
  * @author Thibaud Talon
- * @date   21/09/2017
+ * @date   18/10/2026
  *
- * Display and return success
+ * Lowest level written at runtime
  *
+ * @param [in] level
+ *	LOG_LEVEL_DEBUG, LOG_LEVEL_INFO, LOG_LEVEL_WARNING, LOG_LEVEL_ERROR or LOG_LEVEL_NONE
  ******************************************************************************/
-int Log::success(){
-    gettimeofday(&tv, NULL);
-    rawtime = tv.tv_sec;
-    strftime( time_str, 100, "%F\t%T", localtime (&rawtime));
-    std::cout << time_str << "." << std::setfill('0') << std::setw(6) << tv.tv_usec << '\t' << _name << '\t' << increment << "\tNO ERROR (" << OK << ")" << std::endl;
-    increment++;
-    return OK;
+void Log::setLevel(int level){
+    setLogLevel(level);
 }
 
 /***************************************************************************//**
  * @author Thibaud Talon
- * @date   21/09/2017
+ * @date   18/10/2026
  *
- * Save OpenCV Mat_ to .csv file
+ * Write the log to a binary file
+ *
+ * The lines logged so far are written to the current output first. The
+ * binary file is turned back into text with LogDecode.exe.
  *
- * @param [in] mat
- *	Matrix to save
  * @param [in] filename
- *	Name of the file (ends with .csv)
+ *	Name of the file (created or truncated)
  ******************************************************************************/
-UserInterface_Error saveMatAsCSV(cv::Mat_<float> & mat, const char * filename){
-    Log log("UserInterface::saveMatAsCSV");
+UserInterface_Error openBinaryLog(const char * filename){
+    Log log("UserInterface::openBinaryLog");
+
     try{
         // 1. Check inputs
-        log.printf("1. Check inputs");
-        if ( mat.empty() ) return (UserInterface_Error) log.error("No data",ERR_SAVECSV_MAT);
-        if (sizeof(filename) == 0) return (UserInterface_Error) log.error("No filename", ERR_SAVECSV_FILENAME);
+        log.debug("1. Check inputs");
+        if ( filename == NULL || filename[0] == 0 ) return (UserInterface_Error) log.error("No filename", ERR_BINLOG_FILENAME);
 
-        // 2. Create new file
-        log.printf("2. Create new file");
-        std::ofstream csvfile;
-        csvfile.open(filename);
-        if ( !csvfile ) return (UserInterface_Error) log.error("Cannot create file",ERR_SAVECSV_OPEN);
-
-        // 3. Loop over vector and save
-        log.printf("3. Loop over vector and save");
-        csvfile.precision(10);
-        for(int II=0; II < mat.rows; II++){
-            for(int III=0; III < mat.cols; III++){
-                csvfile << mat(II,III);
-
-                if (III < mat.cols-1) csvfile << ",";
-                else csvfile << std::endl;
-            }
-        }
-        csvfile.close();
+        // 2. Open file
+        log.debug("2. Open file");
+        FILE * file = fopen(filename, "wb");
+        if ( file == NULL ) return (UserInterface_Error) log.error("Cannot open file", ERR_BINLOG_OPEN);
+        log.printf("Log written to %s", filename);
+
+        // 3. Switch the sink
+        log.debug("3. Switch the sink");
+        setLogSink(new Log_BinarySink(file));
 
         return (UserInterface_Error) log.success();
     }
     catch( const std::exception& e ){
-        return (UserInterface_Error) log.error(e.what(),ERR_SAVECSV_FATAL);
+        return (UserInterface_Error) log.error(e.what(),ERR_BINLOG_FATAL);
     }
 }
-UserInterface_Error saveMatAsCSV(cv::Mat_<int> & mat, const char * filename){
-    Log log("UserInterface::saveMatAsCSV");
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Format one value of a csv file (returns the length, out holds 32 chars)
+ *
+ * The floats are written with the fewest significant digits (6 to 9) that
+ * read back to the same float.
+ ******************************************************************************/
+static int formatCSVValue(int value, char * out){
+    char digits[16];
+    int N = 0, length = 0;
+    unsigned int v = (value < 0) ? 0u - (unsigned int) value : (unsigned int) value;
+    do { digits[N++] = (char)('0' + v%10); v /= 10; } while ( v );
+    if ( value < 0 ) out[length++] = '-';
+    while ( N ) out[length++] = digits[--N];
+    return length;
+}
+
+static int formatCSVValue(float value, char * out){
+    // Range first: the cast is undefined for NaN (fails the comparison), infinities and |value| >= 2^31
+    if ( fabsf(value) < 1e7f && value == (float)(int) value && !(value == 0 && signbit(value)) ) return formatCSVValue((int) value, out);
+    for(int precision = 6; precision < 9; precision++){
+        int length = snprintf(out, 32, "%.*g", precision, value);
+        if ( (float) strtod(out, NULL) == value ) return length;
+    }
+    return snprintf(out, 32, "%.9g", value);
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Format blocks of rows in parallel (one buffer per block)
+ ******************************************************************************/
+template <typename T>
+class CSVBlocksBody : public cv::ParallelLoopBody{
+public:
+    CSVBlocksBody(const cv::Mat_<T> & mat, int rowStart, int Nrows, std::vector<std::string> & buffers) :
+        _mat(mat), _rowStart(rowStart), _Nrows(Nrows), _buffers(buffers) {}
+    void operator()(const cv::Range & range) const{
+        char value[32];
+        for(int k = range.start; k < range.end; k++){
+            std::string & buffer = _buffers[k];
+            buffer.clear();
+            int rowEnd = std::min(_mat.rows, _rowStart + (k+1)*_Nrows);
+            for(int II = _rowStart + k*_Nrows; II < rowEnd; II++){
+                const T * row = _mat[II];
+                for(int III = 0; III < _mat.cols; III++){
+                    buffer.append(value, formatCSVValue(row[III], value));
+                    buffer.push_back( (III < _mat.cols-1) ? ',' : '\n' );
+                }
+            }
+        }
+    }
+private:
+    const cv::Mat_<T> & _mat;
+    int _rowStart, _Nrows;
+    std::vector<std::string> & _buffers;
+};
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Save a .csv file (see saveMatAsCSV)
+ ******************************************************************************/
+template <typename T>
+static UserInterface_Error saveCSV(Log & log, cv::Mat_<T> & mat, const char * filename, int Nstrips){
     try{
         // 1. Check inputs
-        log.printf("1. Check inputs");
+        log.debug("1. Check inputs");
         if ( mat.empty() ) return (UserInterface_Error) log.error("No data",ERR_SAVECSV_MAT);
-        if (sizeof(filename) == 0) return (UserInterface_Error) log.error("No filename", ERR_SAVECSV_FILENAME);
+        if ( filename == NULL || filename[0] == 0 ) return (UserInterface_Error) log.error("No filename", ERR_SAVECSV_FILENAME);
+        if ( Nstrips < 0 ) return (UserInterface_Error) log.error("Negative number of strips", ERR_SAVECSV_STRIPS);
+        if ( Nstrips == 0 ) Nstrips = cv::getNumThreads();
+        Nstrips = std::max(1, Nstrips);
 
         // 2. Create new file
-        log.printf("2. Create new file");
-        std::ofstream csvfile;
-        csvfile.open(filename);
-        if ( !csvfile ) return (UserInterface_Error) log.error("Cannot create file",ERR_SAVECSV_OPEN);
-
-        // 3. Loop over vector and save
-        log.printf("3. Loop over vector and save");
-        csvfile.precision(10);
-        for(int II=0; II < mat.rows; II++){
-            for(int III=0; III < mat.cols; III++){
-                csvfile << mat(II,III);
-
-                if (III < mat.cols-1) csvfile << ",";
-                else csvfile << std::endl;
+        log.debug("2. Create new file");
+        FILE * csvfile = fopen(filename, "w");
+        if ( csvfile == NULL ) return (UserInterface_Error) log.error("Cannot create file",ERR_SAVECSV_OPEN);
+
+        // 3. Format blocks of rows in parallel and write them in order
+        int Nrows = std::max(1, CSV_BLOCK_SIZE/(12*mat.cols)); // Rows per block
+        int Nblocks = (mat.rows + Nrows - 1)/Nrows;
+        log.debug("3. Format %i blocks of %i rows (%i in parallel)", Nblocks, Nrows, Nstrips);
+        std::vector<std::string> buffers(std::min(Nstrips, Nblocks));
+        for(int rowStart = 0; rowStart < mat.rows; rowStart += Nrows*(int)buffers.size()){
+            int N = std::min((int)buffers.size(), (mat.rows - rowStart + Nrows - 1)/Nrows);
+            cv::parallel_for_(cv::Range(0, N), CSVBlocksBody<T>(mat, rowStart, Nrows, buffers));
+            for(int k = 0; k < N; k++){
+                if ( fwrite(buffers[k].data(), 1, buffers[k].size(), csvfile) != buffers[k].size() ){
+                    fclose(csvfile);
+                    return (UserInterface_Error) log.error("Cannot write file", ERR_SAVECSV_WRITE);
+                }
             }
         }
-        csvfile.close();
+        if ( fclose(csvfile) != 0 ) return (UserInterface_Error) log.error("Cannot close file", ERR_SAVECSV_CLOSE);
 
         return (UserInterface_Error) log.success();
     }
@@ -187,68 +360,373 @@ UserInterface_Error saveMatAsCSV(cv::Mat_<int> & mat, const char * filename){
  * @author Thibaud Talon
  * @date   21/09/2017
  *
- * Load .csv file OpenCV Mat_
+ * Save OpenCV Mat_ to .csv file
+ *
+ * Blocks of rows are formatted in parallel into large buffers written in
+ * order with one fwrite each. The floats are written with the shortest
+ * text that reads back to the same value.
  *
+ * @param [in] mat
+ *	Matrix to save
  * @param [in] filename
  *	Name of the file (ends with .csv)
- * @param [out] mat
- *	Matrix to load the data in
+ * @param [in] Nstrips
+ *	Number of blocks formatted in parallel (0 = number of threads)
  ******************************************************************************/
-UserInterface_Error loadMatFromCSV(const char * filename, cv::Mat_<float> &mat){
-    Log log("UserInterface::loadMatFromCSV");
+UserInterface_Error saveMatAsCSV(cv::Mat_<float> & mat, const char * filename, int Nstrips){
+    Log log("UserInterface::saveMatAsCSV");
+    return saveCSV(log, mat, filename, Nstrips);
+}
+UserInterface_Error saveMatAsCSV(cv::Mat_<int> & mat, const char * filename, int Nstrips){
+    Log log("UserInterface::saveMatAsCSV");
+    return saveCSV(log, mat, filename, Nstrips);
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Allocator of the matrices built on a mapped file
+ *
+ * The reference counter sits in a block that also records the mapping:
+ * when the last owner (UserInterface_MappedFile or matrix) is released,
+ * the file is unmapped. Matrices created later with this allocator
+ * (create() on a matrix of the mapping) are allocated on the heap.
+ ******************************************************************************/
+struct MappedMatBlock{
+    int refcount; // First member (cv::Mat::refcount points to the block)
+    void * base; // Start of the mapping, or of the heap buffer
+    size_t length; // Length of the mapping (0 for a heap buffer)
+};
+
+class MappedMatAllocator : public cv::MatAllocator{
+public:
+    void allocate(int dims, const int * sizes, int type, int *& refcount, uchar *& datastart, uchar *& data, size_t * step){
+        size_t total = CV_ELEM_SIZE(type);
+        for(int II = dims-1; II >= 0; II--){
+            if ( step ) step[II] = total;
+            total *= sizes[II];
+        }
+        MappedMatBlock * block = new MappedMatBlock;
+        block->refcount = 1;
+        block->base = cv::fastMalloc(total);
+        block->length = 0;
+        refcount = &block->refcount;
+        datastart = data = (uchar *) block->base;
+    }
+    void deallocate(int * refcount, uchar *, uchar *){
+        MappedMatBlock * block = (MappedMatBlock *) refcount;
+        if ( block->length ) munmap(block->base, block->length);
+        else cv::fastFree(block->base);
+        delete block;
+    }
+};
+
+static MappedMatAllocator * mappedMatAllocator = NULL;
+static pthread_once_t mappedMatOnce = PTHREAD_ONCE_INIT;
+
+static void createMappedMatAllocator(void){
+    mappedMatAllocator = new MappedMatAllocator; // Never deleted (matrices may be released at exit)
+}
 
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Map a file in memory (copy-on-write: the file is never modified)
+ *
+ * An empty file is opened with size() = 0 and no data.
+ *
+ * @param [in] filename
+ *	Name of the file
+ ******************************************************************************/
+UserInterface_Error UserInterface_MappedFile::open(const char * filename){
+    Log log("UserInterface::MappedFile::open");
     try{
         // 1. Check inputs
-        log.printf("1. Check inputs");
-        if (sizeof(filename) == 0) return (UserInterface_Error) log.error("No filename", ERR_LOADCSV_FILENAME);
+        log.debug("1. Check inputs");
+        close();
+        if ( filename == NULL || filename[0] == 0 ) return (UserInterface_Error) log.error("No filename", ERR_MAPFILE_FILENAME);
 
-        // 2. Open file
-        log.printf("2. Open file");
-        std::ifstream csvfile;
-        csvfile.open(filename);
-        if ( !csvfile ) return (UserInterface_Error) log.error("Cannot open file", ERR_LOADCSV_OPEN);
-
-        // 3. Find number of columns by reading first line
-        log.printf("3. Find number of columns by reading first line");
-        mat = cv::Mat_<float>(1, 1);
-        char buffer[256];
-
-        // First line
-        csvfile.getline(buffer,256);
-        mat(0) = (float)atof(buffer);
-        char * comma = strchr(buffer,',');
-
-        // Remaining of line
-        while (comma!=NULL){
-            mat.push_back((float)atof(comma+1));
-            comma = strchr(comma+1,',');
-        }
+        // 2. Map file
+        log.debug("2. Map file");
+        int fd = ::open(filename, O_RDONLY);
+        if ( fd < 0 ) return (UserInterface_Error) log.error("Cannot open file", ERR_MAPFILE_OPEN);
+        struct stat st;
+        if ( fstat(fd, &st) != 0 ) {::close(fd); return (UserInterface_Error) log.error("Cannot read size of file", ERR_MAPFILE_OPEN);}
+        if ( st.st_size == 0 ) {::close(fd); return (UserInterface_Error) log.success();}
+        size_t length = (size_t) st.st_size;
+        void * map = mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if ( map == MAP_FAILED ) return (UserInterface_Error) log.error("Cannot map file", ERR_MAPFILE_MAP);
+        madvise(map, length, MADV_WILLNEED);
+
+        // 3. Shared block
+        log.debug("3. Shared block");
+        pthread_once(&mappedMatOnce, createMappedMatAllocator);
+        _block = new MappedMatBlock;
+        _block->refcount = 1;
+        _block->base = map;
+        _block->length = length;
+
+        return (UserInterface_Error) log.success();
+    }
+    catch( const std::exception& e ){
+        return (UserInterface_Error) log.error(e.what(), ERR_MAPFILE_FATAL);
+    }
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Release the mapping (unmapped once the matrices built on it are released)
+ ******************************************************************************/
+void UserInterface_MappedFile::close(void){
+    if ( _block != NULL && CV_XADD(&_block->refcount, -1) == 1 ) mappedMatAllocator->deallocate(&_block->refcount, NULL, NULL);
+    _block = NULL;
+}
+
+const uchar * UserInterface_MappedFile::data(void) const{
+    return (_block == NULL) ? NULL : (const uchar *) _block->base;
+}
+
+size_t UserInterface_MappedFile::size(void) const{
+    return (_block == NULL) ? 0 : _block->length;
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Matrix on the mapping (no copy)
+ *
+ * The matrix keeps the file mapped, even after close(). Writes to the
+ * matrix stay private to the process.
+ *
+ * @param [in] offset
+ *	Offset of the first element in the file (bytes)
+ * @param [in] rows, cols, type
+ *	Size and type of the matrix
+ * @param [in] step
+ *	Bytes per row (AUTO_STEP = continuous)
+ ******************************************************************************/
+cv::Mat UserInterface_MappedFile::view(size_t offset, int rows, int cols, int type, size_t step) const{
+    if ( _block == NULL ) return cv::Mat();
+    cv::Mat mat(rows, cols, type, (uchar *) _block->base + offset, step);
+    CV_XADD(&_block->refcount, 1);
+    mat.refcount = &_block->refcount;
+    mat.allocator = mappedMatAllocator;
+    return mat;
+}
 
-        // Reformet matrix
-        mat = mat.t();
-        log.printf("cols = %i", mat.cols);
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Line of a csv file (without the end of line)
+ ******************************************************************************/
+struct CSV_Line{
+    const char * start;
+    const char * end;
+};
 
-        // 4. Loop over file and load
-        log.printf("4. Loop over file and load");
-        cv::Mat_<float> row = cv::Mat_<float>::zeros(1,mat.cols);
-        csvfile.getline(buffer,256);
-        while(!csvfile.eof() && !csvfile.fail()){
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Parse one value of a csv file (same result as atof/atoi)
+ *
+ * The float parser builds the decimal mantissa and exponent of the value;
+ * when the mantissa fits in 53 bits and the exponent in [-22, 22], one
+ * multiplication or division by an exact power of 10 gives the correctly
+ * rounded double. The other values (long mantissa, large exponent, nan,
+ * inf) go through strtod. Returns the end of the value.
+ ******************************************************************************/
+static const double exactPowersOf10[23] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10,
+    1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
 
-            row(0) = (float)atof(buffer);
-            comma = strchr(buffer,',');
+static const char * parseCSVValue(const char * p, const char * end, float & value){
+    while ( p < end && (*p == ' ' || *p == '\t') ) p++;
+    const char * start = p;
 
-            // Remaining of line
-            int II = 1;
-            while (comma!=NULL){
-                row(II++) = (float)atof(comma+1);
-                comma = strchr(comma+1,',');
+    // Sign, mantissa and exponent
+    bool negative = false;
+    if ( p < end && (*p == '-' || *p == '+') ) negative = (*p++ == '-');
+    uint64_t mantissa = 0;
+    int Ndigits = 0, exponent = 0;
+    bool digits = false;
+    while ( p < end && (unsigned)(*p - '0') < 10 ){
+        if ( Ndigits < 19 ) { mantissa = mantissa*10 + (*p - '0'); if ( mantissa ) Ndigits++; }
+        else { Ndigits++; exponent++; }
+        digits = true;
+        p++;
+    }
+    if ( p < end && *p == '.' ){
+        p++;
+        while ( p < end && (unsigned)(*p - '0') < 10 ){
+            if ( Ndigits < 19 ) { mantissa = mantissa*10 + (*p - '0'); if ( mantissa ) Ndigits++; exponent--; }
+            else Ndigits++;
+            digits = true;
+            p++;
+        }
+    }
+    if ( digits && p < end && (*p == 'e' || *p == 'E') ){
+        const char * q = p + 1;
+        bool negativeExponent = false;
+        if ( q < end && (*q == '-' || *q == '+') ) negativeExponent = (*q++ == '-');
+        if ( q < end && (unsigned)(*q - '0') < 10 ){
+            int e = 0;
+            while ( q < end && (unsigned)(*q - '0') < 10 ){
+                if ( e < 10000 ) e = e*10 + (*q - '0');
+                q++;
             }
+            exponent += negativeExponent ? -e : e;
+            p = q;
+        }
+    }
+
+    // Exact conversion
+    if ( digits && Ndigits <= 19 && mantissa <= (1ULL << 53) && exponent >= -22 && exponent <= 22 ){
+        double d = (double) mantissa;
+        d = (exponent < 0) ? d/exactPowersOf10[-exponent] : d*exactPowersOf10[exponent];
+        value = (float) (negative ? -d : d);
+        return p;
+    }
+
+    // strtod for the other values
+    char buffer[128];
+    int length = 0;
+    while ( start + length < end && start[length] != ',' && length < (int)sizeof(buffer) - 1 ) { buffer[length] = start[length]; length++; }
+    buffer[length] = 0;
+    char * stop;
+    value = (float) strtod(buffer, &stop);
+    return start + (stop - buffer);
+}
+
+static const char * parseCSVValue(const char * p, const char * end, int & value){
+    while ( p < end && (*p == ' ' || *p == '\t') ) p++;
+    bool negative = false;
+    if ( p < end && (*p == '-' || *p == '+') ) negative = (*p++ == '-');
+    long long v = 0;
+    while ( p < end && (unsigned)(*p - '0') < 10 ) v = v*10 + (*p++ - '0');
+    value = (int) (negative ? -v : v);
+    return p;
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Parse a line of Ncols values into row (false if the number of values differs)
+ ******************************************************************************/
+template <typename T>
+static bool parseCSVRow(const CSV_Line & line, T * row, int Ncols){
+    const char * p = line.start;
+    for(int II = 0; II < Ncols; II++){
+        p = parseCSVValue(p, line.end, row[II]);
+        const char * comma = (const char *) memchr(p, ',', line.end - p);
+        if ( II < Ncols-1 ){
+            if ( comma == NULL ) return false;
+            p = comma + 1;
+        }
+        else if ( comma != NULL ) return false;
+    }
+    return true;
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Parse strips of lines in parallel
+ ******************************************************************************/
+template <typename T>
+class CSVRowsBody : public cv::ParallelLoopBody{
+public:
+    CSVRowsBody(const std::vector<CSV_Line> & lines, int Nstrips, cv::Mat_<T> & mat, std::vector<uchar> & valid) :
+        _lines(lines), _Nstrips(Nstrips), _mat(mat), _valid(valid) {}
+    void operator()(const cv::Range & range) const{
+        for(int k = range.start; k < range.end; k++){
+            int rowStart = (int)((long)_lines.size()*k/_Nstrips);
+            int rowEnd = (int)((long)_lines.size()*(k+1)/_Nstrips);
+            for(int II = rowStart; II < rowEnd; II++) _valid[II] = parseCSVRow(_lines[II], _mat[II], _mat.cols);
+        }
+    }
+private:
+    const std::vector<CSV_Line> & _lines;
+    int _Nstrips;
+    cv::Mat_<T> & _mat;
+    std::vector<uchar> & _valid;
+};
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Load a .csv file (see loadMatFromCSV)
+ ******************************************************************************/
+template <typename T>
+static UserInterface_Error loadCSV(Log & log, const char * filename, cv::Mat_<T> & mat, int Nstrips){
+    try{
+        // 1. Check inputs
+        log.debug("1. Check inputs");
+        if ( filename == NULL || filename[0] == 0 ) return (UserInterface_Error) log.error("No filename", ERR_LOADCSV_FILENAME);
+        if ( Nstrips < 0 ) return (UserInterface_Error) log.error("Negative number of strips", ERR_LOADCSV_STRIPS);
+
+        // 2. Map file
+        log.debug("2. Map file");
+        UserInterface_MappedFile file;
+        if ( file.open(filename) ) return (UserInterface_Error) log.error("Cannot open file", ERR_LOADCSV_OPEN);
+        const char * data = (const char *) file.data(), * end = data + file.size();
+
+        // 3. Find the lines and the number of columns
+        log.debug("3. Find the lines and the number of columns");
+        size_t Nlines = 0;
+        for(const char * p = data; p < end; Nlines++){
+            const char * eol = (const char *) memchr(p, '\n', end - p);
+            p = (eol == NULL) ? end : eol + 1;
+        }
+        std::vector<CSV_Line> lines;
+        lines.reserve(Nlines);
+        for(const char * p = data; p < end; ){
+            const char * eol = (const char *) memchr(p, '\n', end - p);
+            CSV_Line line = {p, (eol == NULL) ? end : eol};
+            p = (eol == NULL) ? end : eol + 1;
+            if ( line.end > line.start && line.end[-1] == '\r' ) line.end--;
+
+            // Blank lines are skipped
+            const char * q = line.start;
+            while ( q < line.end && (*q == ' ' || *q == '\t') ) q++;
+            if ( q < line.end ) lines.push_back(line);
+        }
+        if ( lines.empty() ) return (UserInterface_Error) log.error("Empty file", ERR_LOADCSV_EMPTY);
+
+        int Ncols = 1;
+        for(const char * p = lines[0].start; (p = (const char *) memchr(p, ',', lines[0].end - p)) != NULL; p++) Ncols++;
+        log.printf("cols = %i", Ncols);
+
+        // 4. Parse the lines in parallel
+        if ( Nstrips == 0 ) Nstrips = cv::getNumThreads();
+        Nstrips = std::max(1, std::min(Nstrips, (int)lines.size()));
+        log.debug("4. Parse %i strips in parallel", Nstrips);
+        mat.create((int)lines.size(), Ncols);
+        std::vector<uchar> valid(lines.size(), 0);
+        cv::parallel_for_(cv::Range(0, Nstrips), CSVRowsBody<T>(lines, Nstrips, mat, valid));
 
-            if (II == mat.cols) mat.push_back(row);
-            csvfile.getline(buffer,256);
+        // 5. Remove the lines with another number of columns
+        log.debug("5. Remove the lines with another number of columns");
+        int Nrows = 0;
+        for(int II = 0; II < mat.rows; II++){
+            if ( !valid[II] ) continue;
+            if ( II != Nrows ) memcpy(mat[Nrows], mat[II], Ncols*sizeof(T));
+            Nrows++;
+        }
+        if ( Nrows < mat.rows ){
+            log.warning("%i lines skipped (number of columns differs from the first line)", mat.rows - Nrows);
+            mat = mat.rowRange(0, Nrows);
         }
         log.printf("rows = %i", mat.rows);
-        csvfile.close();
 
         return (UserInterface_Error) log.success();
     }
@@ -256,69 +734,213 @@ UserInterface_Error loadMatFromCSV(const char * filename, cv::Mat_<float> &mat){
         return (UserInterface_Error) log.error(e.what(),ERR_LOADCSV_FATAL);
     }
 }
-UserInterface_Error loadMatFromCSV(const char * filename, cv::Mat_<int> &mat){
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   21/09/2017
+ *
+ * Load .csv file OpenCV Mat_
+ *
+ * The file is mapped in memory: a first pass (memchr) finds the lines and
+ * the number of columns of the first line, the matrix is allocated once
+ * and strips of lines are parsed in parallel. Blank lines and lines with
+ * another number of columns are skipped.
+ *
+ * @param [in] filename
+ *	Name of the file (ends with .csv)
+ * @param [out] mat
+ *	Matrix to load the data in
+ * @param [in] Nstrips
+ *	Number of strips of lines parsed in parallel (0 = number of threads)
+ ******************************************************************************/
+UserInterface_Error loadMatFromCSV(const char * filename, cv::Mat_<float> &mat, int Nstrips){
+    Log log("UserInterface::loadMatFromCSV");
+    return loadCSV(log, filename, mat, Nstrips);
+}
+UserInterface_Error loadMatFromCSV(const char * filename, cv::Mat_<int> &mat, int Nstrips){
     Log log("UserInterface::loadMatFromCSV");
+    return loadCSV(log, filename, mat, Nstrips);
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Fletcher-64 checksum of 32-bit words
+ ******************************************************************************/
+uint64_t fletcher64(const uint32_t * words, size_t N){
+    uint64_t sum1 = 0, sum2 = 0;
+    while ( N ){
+        size_t block = std::min(N, (size_t) 65536); // No overflow before the modulo
+        for(size_t II = 0; II < block; II++){
+            sum1 += words[II];
+            sum2 += sum1;
+        }
+        sum1 %= 0xFFFFFFFFULL;
+        sum2 %= 0xFFFFFFFFULL;
+        words += block;
+        N -= block;
+    }
+    return (sum2 << 32) | sum1;
+}
 
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Save a binary matrix file (see saveMat)
+ ******************************************************************************/
+template <typename T>
+static UserInterface_Error saveBinary(Log & log, cv::Mat_<T> & mat, const char * filename){
     try{
         // 1. Check inputs
-        log.printf("1. Check inputs");
-        if (sizeof(filename) == 0) return (UserInterface_Error) log.error("No filename", ERR_LOADCSV_FILENAME);
+        log.debug("1. Check inputs");
+        if ( mat.empty() ) return (UserInterface_Error) log.error("No data", ERR_SAVEMAT_MAT);
+        if ( filename == NULL || filename[0] == 0 ) return (UserInterface_Error) log.error("No filename", ERR_SAVEMAT_FILENAME);
+        cv::Mat_<T> data = mat.isContinuous() ? mat : mat.clone();
 
-        // 2. Open file
-        log.printf("2. Open file");
-        std::ifstream csvfile;
-        csvfile.open(filename);
-        if ( !csvfile ) return (UserInterface_Error) log.error("Cannot open file", ERR_LOADCSV_OPEN);
-
-        // 3. Find number of columns by reading first line
-        log.printf("3. Find number of columns by reading first line");
-        mat = cv::Mat_<int>(1, 1);
-        char buffer[256];
-
-        // First line
-        csvfile.getline(buffer,256);
-        mat(0) = (int)atoi(buffer);
-        char * comma = strchr(buffer,',');
-
-        // Remaining of line
-        while (comma!=NULL){
-            mat.push_back((int)atoi(comma+1));
-            comma = strchr(comma+1,',');
+        // 2. Header
+        log.debug("2. Header");
+        Mat_BinaryHeader header;
+        memset(&header, 0, sizeof(header));
+        memcpy(header.magic, MAT_BINARY_MAGIC, sizeof(header.magic));
+        header.version = MAT_BINARY_VERSION;
+        header.byteOrder = MAT_BINARY_BYTE_ORDER;
+        header.type = data.type();
+        header.rows = data.rows;
+        header.cols = data.cols;
+        header.offset = MAT_BINARY_OFFSET;
+        header.Nbytes = (uint64_t) data.total()*sizeof(T);
+        header.checksum = fletcher64((const uint32_t *) data.data, header.Nbytes/4);
+
+        // 3. Write a temporary file
+        log.debug("3. Write a temporary file");
+        std::ostringstream tmp;
+        tmp << filename << ".tmp" << getpid();
+        FILE * file = fopen(tmp.str().c_str(), "wb");
+        if ( file == NULL ) return (UserInterface_Error) log.error("Cannot create file", ERR_SAVEMAT_OPEN);
+        std::vector<char> padding(MAT_BINARY_OFFSET - sizeof(header), 0);
+        bool written = fwrite(&header, sizeof(header), 1, file) == 1
+            && fwrite(&padding[0], 1, padding.size(), file) == padding.size()
+            && fwrite(data.data, 1, header.Nbytes, file) == header.Nbytes
+            && fflush(file) == 0
+            && fsync(fileno(file)) == 0;
+        if ( fclose(file) != 0 ) written = false;
+        if ( !written ){
+            unlink(tmp.str().c_str());
+            return (UserInterface_Error) log.error("Cannot write file", ERR_SAVEMAT_WRITE);
         }
 
-        // Reformet matrix
-        mat = mat.t();
-        log.printf("cols = %i", mat.cols);
+        // 4. Replace the file
+        log.debug("4. Replace the file");
+        if ( rename(tmp.str().c_str(), filename) != 0 ){
+            unlink(tmp.str().c_str());
+            return (UserInterface_Error) log.error("Cannot rename file", ERR_SAVEMAT_RENAME);
+        }
+        const char * slash = strrchr(filename, '/');
+        std::string directory = (slash == NULL) ? std::string(".") : std::string(filename, slash == filename ? 1 : slash - filename);
+        int fd = open(directory.c_str(), O_RDONLY);
+        if ( fd >= 0 ) { fsync(fd); close(fd); } // Make the rename durable
 
-        // 4. Loop over file and load
-        log.printf("4. Loop over file and load");
-        cv::Mat_<int> row = cv::Mat_<int>::zeros(1,mat.cols);
-        csvfile.getline(buffer,256);
-        while(!csvfile.eof() && !csvfile.fail()){
+        return (UserInterface_Error) log.success();
+    }
+    catch( const std::exception& e ){
+        return (UserInterface_Error) log.error(e.what(), ERR_SAVEMAT_FATAL);
+    }
+}
 
-            row(0) = (int)atoi(buffer);
-            comma = strchr(buffer,',');
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Load a binary matrix file (see loadMat)
+ ******************************************************************************/
+template <typename T>
+static UserInterface_Error loadBinary(Log & log, const char * filename, cv::Mat_<T> & mat, bool verify){
+    try{
+        // 1. Check inputs
+        log.debug("1. Check inputs");
+        if ( filename == NULL || filename[0] == 0 ) return (UserInterface_Error) log.error("No filename", ERR_LOADMAT_FILENAME);
 
-            // Remaining of line
-            int II = 1;
-            while (comma!=NULL){
-                row(II++) = (int)atoi(comma+1);
-                comma = strchr(comma+1,',');
-            }
+        // 2. Map file
+        log.debug("2. Map file");
+        UserInterface_MappedFile file;
+        if ( file.open(filename) ) return (UserInterface_Error) log.error("Cannot open file", ERR_LOADMAT_OPEN);
+        if ( file.size() < sizeof(Mat_BinaryHeader) ) return (UserInterface_Error) log.error("Not a binary matrix", ERR_LOADMAT_FORMAT);
 
-            if (II == mat.cols) mat.push_back(row);
-            csvfile.getline(buffer,256);
-        }
-        log.printf("rows = %i", mat.rows);
-        csvfile.close();
+        // 3. Check the header
+        log.debug("3. Check the header");
+        const Mat_BinaryHeader & header = *(const Mat_BinaryHeader *) file.data();
+        if ( memcmp(header.magic, MAT_BINARY_MAGIC, sizeof(header.magic)) != 0 ) return (UserInterface_Error) log.error("Not a binary matrix", ERR_LOADMAT_FORMAT);
+        if ( header.byteOrder != MAT_BINARY_BYTE_ORDER ) return (UserInterface_Error) log.error("Byte order not supported", ERR_LOADMAT_FORMAT);
+        if ( header.version != MAT_BINARY_VERSION ) return (UserInterface_Error) log.error("Version not supported", ERR_LOADMAT_FORMAT);
+        if ( header.rows <= 0 || header.cols <= 0 || header.offset % sizeof(T) != 0
+             || header.Nbytes != (uint64_t) header.rows*header.cols*sizeof(T)
+             || header.offset > file.size() || header.Nbytes > file.size() - header.offset ) return (UserInterface_Error) log.error("Corrupted header", ERR_LOADMAT_FORMAT);
+        if ( header.type != cv::DataType<T>::type ) return (UserInterface_Error) log.error("Wrong type of matrix", ERR_LOADMAT_TYPE);
+        if ( verify && fletcher64((const uint32_t *)(file.data() + header.offset), header.Nbytes/4) != header.checksum ) return (UserInterface_Error) log.error("Wrong checksum", ERR_LOADMAT_CHECKSUM);
+        log.printf("rows = %i, cols = %i", header.rows, header.cols);
+
+        // 4. Matrix on the mapping (unmapped on release)
+        log.debug("4. Matrix on the mapping");
+        mat = file.view(header.offset, header.rows, header.cols, header.type);
 
         return (UserInterface_Error) log.success();
     }
     catch( const std::exception& e ){
-        return (UserInterface_Error) log.error(e.what(),ERR_LOADCSV_FATAL);
+        return (UserInterface_Error) log.error(e.what(), ERR_LOADMAT_FATAL);
     }
 }
 
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Save OpenCV Mat_ to binary matrix file
+ *
+ * The file is written under a temporary name, synced and renamed, so
+ * that a reader (or a crash) never sees a partial file.
+ *
+ * @param [in] mat
+ *	Matrix to save
+ * @param [in] filename
+ *	Name of the file
+ ******************************************************************************/
+UserInterface_Error saveMat(cv::Mat_<float> & mat, const char * filename){
+    Log log("UserInterface::saveMat");
+    return saveBinary(log, mat, filename);
+}
+UserInterface_Error saveMat(cv::Mat_<int> & mat, const char * filename){
+    Log log("UserInterface::saveMat");
+    return saveBinary(log, mat, filename);
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Load binary matrix file to OpenCV Mat_
+ *
+ * The file is mapped in memory and the matrix points to the mapping (no
+ * copy); writes to the matrix stay private. The file is unmapped when
+ * the last matrix sharing the data is released.
+ *
+ * @param [in] filename
+ *	Name of the file
+ * @param [out] mat
+ *	Matrix to load the data in (same type as the file)
+ * @param [in] verify
+ *	Check the checksum of the data (reads the whole file)
+ ******************************************************************************/
+UserInterface_Error loadMat(const char * filename, cv::Mat_<float> & mat, bool verify){
+    Log log("UserInterface::loadMat");
+    return loadBinary(log, filename, mat, verify);
+}
+UserInterface_Error loadMat(const char * filename, cv::Mat_<int> & mat, bool verify){
+    Log log("UserInterface::loadMat");
+    return loadBinary(log, filename, mat, verify);
+}
+
 /***************************************************************************//**
  * @author Thibaud Talon
  * @date   21/09/2017
@@ -334,12 +956,12 @@ UserInterface_Error saveImage(cv::Mat & img, const char * filename){
     Log log("UserInterface::saveImage");
     try{
         // 1. Check inputs
-        log.printf("1. Check inputs");
+        log.debug("1. Check inputs");
         if ( img.empty() ) return (UserInterface_Error) log.error("No image", ERR_IMG_MATRIX);
         if (sizeof(filename) == 0) return (UserInterface_Error) log.error("No filename", ERR_SAVEIMG_FILENAME);
 
         // 2. Save the image
-        log.printf("2. Save the image");
+        log.debug("2. Save the image");
         if ( cv::imwrite(filename, img) == false) return (UserInterface_Error) log.error("Cannot save the image", ERR_SAVEIMG_WRITE);
 
         return (UserInterface_Error) log.success();
@@ -349,6 +971,138 @@ UserInterface_Error saveImage(cv::Mat & img, const char * filename){
     }
 }
 
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Save of one image (run on a worker of UserInterface_ImageSaver)
+ ******************************************************************************/
+class UserInterface_ImageSaver::Task : public ThreadPool_Task{
+public:
+    Task(UserInterface_ImageSaver * saver, const char * filename, const std::vector<int> & params) :
+        _saver(saver), _filename(filename), _params(params) {}
+    void run(void){
+        Log log("UserInterface::ImageSaver");
+        try{
+            if ( cv::imwrite(_filename, img, _params) == false ) _saver->failed((UserInterface_Error) log.error("Cannot save the image", ERR_SAVEIMG_WRITE));
+            else log.debug("Image saved to %s", _filename.c_str());
+        }
+        catch( const std::exception& e ){
+            _saver->failed((UserInterface_Error) log.error(e.what(), ERR_SAVEIMG_FATAL));
+        }
+        img.release();
+    }
+
+    cv::Mat img;
+
+private:
+    UserInterface_ImageSaver * _saver;
+    std::string _filename;
+    std::vector<int> _params;
+};
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Start the workers
+ *
+ * @param [in] Nthreads
+ *	Number of worker threads (0 = number of cores)
+ * @param [in] maxQueued
+ *	Maximum number of images waiting in the queue
+ ******************************************************************************/
+UserInterface_ImageSaver::UserInterface_ImageSaver(int Nthreads, int maxQueued) : _pool(Nthreads, std::max(1, maxQueued)) {
+    _jpegQuality = 95;
+    _pngCompression = 3;
+    _error = OK_USERINTERFACE;
+    pthread_mutex_init(&_mutex, NULL);
+}
+
+UserInterface_ImageSaver::~UserInterface_ImageSaver(void){
+    _pool.wait();
+    pthread_mutex_destroy(&_mutex);
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Queue an image
+ *
+ * Never waits: when the queue is full the image is not taken.
+ *
+ * @param [in,out] img
+ *	Image to save (released when queued, copied if it wraps external memory)
+ * @param [in] filename
+ *	Name of the file (extension gives the format)
+ ******************************************************************************/
+UserInterface_Error UserInterface_ImageSaver::save(cv::Mat & img, const char * filename){
+    Log log("UserInterface::ImageSaver::save");
+    try{
+        // 1. Check inputs
+        log.debug("1. Check inputs");
+        if ( img.empty() ) return (UserInterface_Error) log.error("No image", ERR_IMG_MATRIX);
+        if ( filename == NULL || filename[0] == 0 ) return (UserInterface_Error) log.error("No filename", ERR_SAVEIMG_FILENAME);
+
+        // 2. Parameters of the format
+        log.debug("2. Parameters of the format");
+        std::vector<int> params;
+        const char * dot = strrchr(filename, '.');
+        std::string extension = (dot == NULL) ? std::string() : std::string(dot + 1);
+        for(size_t II = 0; II < extension.size(); II++) extension[II] = (char) tolower(extension[II]);
+        if ( extension == "jpg" || extension == "jpeg" ){
+            params.push_back(CV_IMWRITE_JPEG_QUALITY);
+            params.push_back(_jpegQuality);
+        }
+        else if ( extension == "png" ){
+            params.push_back(CV_IMWRITE_PNG_COMPRESSION);
+            params.push_back(_pngCompression);
+        }
+
+        // 3. Queue the image
+        log.debug("3. Queue the image");
+        Task * task = new Task(this, filename, params);
+        if ( img.refcount == NULL ) task->img = img.clone(); // External memory (camera buffer): reused by the next capture
+        else task->img = img; // Shares the data
+        ThreadPool_Error error = _pool.submit(task, true, false);
+        if ( error != OK_THREADPOOL ){
+            delete task;
+            if ( error == ERR_THREADPOOL_FULL ) return (UserInterface_Error) log.error("Queue full", ERR_SAVEIMG_FULL);
+            return (UserInterface_Error) log.error("No worker", ERR_SAVEIMG_FATAL);
+        }
+        img.release(); // The data now belongs to the task
+
+        return (UserInterface_Error) log.success();
+    }
+    catch( const std::exception& e ){
+        return (UserInterface_Error) log.error(e.what(), ERR_SAVEIMG_FATAL);
+    }
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Wait until the queued images are written
+ *
+ * Returns the first error of the workers since the previous flush.
+ ******************************************************************************/
+UserInterface_Error UserInterface_ImageSaver::flush(void){
+    _pool.wait();
+    pthread_mutex_lock(&_mutex);
+    UserInterface_Error error = _error;
+    _error = OK_USERINTERFACE;
+    pthread_mutex_unlock(&_mutex);
+    return error;
+}
+
+void UserInterface_ImageSaver::failed(UserInterface_Error error){
+    pthread_mutex_lock(&_mutex);
+    if ( _error == OK_USERINTERFACE ) _error = error;
+    pthread_mutex_unlock(&_mutex);
+}
+
 /***************************************************************************//**
  * @author Thibaud Talon
  * @date   21/09/2017
@@ -364,11 +1118,11 @@ UserInterface_Error loadImage(const char * filename, cv::Mat & img){
     Log log("UserInterface::loadImage");
     try{
         // 1. Check inputs
-        log.printf("1. Check inputs");
+        log.debug("1. Check inputs");
         if (sizeof(filename) == 0) return (UserInterface_Error) log.error("No filename", ERR_LOADIMG_FILENAME);
 
         // 2. Load the image
-        log.printf("2. Load the image");
+        log.debug("2. Load the image");
         img = cv::imread(filename, 0);
         if ( img.empty() ) return (UserInterface_Error) log.error("Cannot load the image", ERR_LOADIMG_LOAD);
 
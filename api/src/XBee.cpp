@@ -32,7 +32,7 @@ XBee_Error XBee::connect(int baudrate){
     try
     {
         // 1. Initialize parameters
-        log.printf("1. Initialize parameters");
+        log.debug("1. Initialize parameters");
         log.printf("Baudrate = %i Hz",baudrate);
         _baudrate = baudrate;
         xbee = NULL;
@@ -43,7 +43,7 @@ XBee_Error XBee::connect(int baudrate){
         }
 
         // 2. Connect the the XBee device
-        log.printf("2. Connect the the XBee device");
+        log.debug("2. Connect the the XBee device");
         error = xbee_setup(&xbee, "xbeeZB", "/dev/ttyUSB0", _baudrate);
         if (error != XBEE_ENONE){
             error = xbee_setup(&xbee, "xbeeZB", "/dev/ttyUSB1", _baudrate);
@@ -75,12 +75,12 @@ XBee_Error XBee::disconnect(void){
     UserInterface::Log log("XBee::disconnect");
     try
     {
-        log.printf("1. Disconnect all nodes");
+        log.debug("1. Disconnect all nodes");
         for (int i = 0; i < XBEE_MAX_NODES; i++) {
             if (nodes[i].con) disconnectNode(nodes[i]);
         }
 
-        log.printf("2. Disconnect XBee");
+        log.debug("2. Disconnect XBee");
         if (xbee){
             error = xbee_shutdown(xbee);
             if ( error != XBEE_ENONE ) {return (XBee_Error) log.error(xbee_errorToStr(error),ERR_XBEE_DISCONNECT);}
@@ -126,7 +126,7 @@ XBee_Error XBee::connectNode(XBeeNode & handle, uint64_t addr64){
         if (!xbee) return (XBee_Error) log.error("XBee not set up", ERR_XBEE_NO_DEVICE);
 
         // 1. Register connection
-        log.printf("1. Register connection");
+        log.debug("1. Register connection");
         int con_index = 0;
         while((nodes[con_index].con != NULL) && (con_index < XBEE_MAX_NODES)) con_index++;
         if (con_index == XBEE_MAX_NODES){return (XBee_Error) log.error("Maximum number of nodes reached", ERR_XBEE_TOO_MANY_NODES);}
@@ -135,7 +135,7 @@ XBee_Error XBee::connectNode(XBeeNode & handle, uint64_t addr64){
         handle.status = XBEE_OFF;
 
         // 2. Setup MAC address
-        log.printf("2. Setup MAC address = 0x%lx", addr64);
+        log.debug("2. Setup MAC address = 0x%lx", addr64);
         struct xbee_conAddress address;
         memset(&address, 0, sizeof(address));
         address.addr64_enabled = 1;
@@ -145,7 +145,7 @@ XBee_Error XBee::connectNode(XBeeNode & handle, uint64_t addr64){
         handle.address = addr64;
 
         // 3. Connect to remote node
-        log.printf("3. Connect to remote node");
+        log.debug("3. Connect to remote node");
         handle.error = xbee_conNew(xbee, &handle.con, "Data", &address);
         if (handle.error != XBEE_ENONE) {
             status = XBEE_ERROR;
@@ -154,7 +154,7 @@ XBee_Error XBee::connectNode(XBeeNode & handle, uint64_t addr64){
         }
 
         // 4. Set connection data
-        log.printf("4. Set connection data");
+        log.debug("4. Set connection data");
         handle.error = xbee_conDataSet(handle.con, xbee, NULL);
         if (handle.error != XBEE_ENONE) {
             status = XBEE_ERROR;
@@ -166,7 +166,7 @@ XBee_Error XBee::connectNode(XBeeNode & handle, uint64_t addr64){
         handle.status = XBEE_ON;
 
         // 5. Purge connection
-        log.printf("5. Purge connection");
+        log.debug("5. Purge connection");
         XBee_Error ret;
         if ( ret = purge(handle)) {
             handle.status = XBEE_ERROR;
@@ -255,10 +255,10 @@ XBee_Error XBee::send(XBeeNode & handle, const unsigned char *msg, unsigned int
     {
         if (!handle.con) return (XBee_Error) log.error("Remote XBee not connected", ERR_XBEE_NO_CONNECTION);
 
-        log.printf("1. Check inputs");
+        log.debug("1. Check inputs");
         if (len > XBEE_MAX_MESSAGE_LENGTH) return (XBee_Error) log.error("Too much data to send", ERR_XBEE_SEND_LEN);
 
-        log.printf("2. Transmit data");
+        log.debug("2. Transmit data");
         handle.error = xbee_connTx(handle.con, NULL, msg, len);
         if (handle.error != XBEE_ENONE){
             handle.status = XBEE_ERROR;
@@ -299,7 +299,7 @@ XBee_Error XBee::receive(XBeeNode & handle, unsigned char **msg, int *len, int t
         if (!handle.con) return (XBee_Error) log.error("Remote XBee not connected", ERR_XBEE_NO_CONNECTION);
 
         // 1. Receive data
-        log.printf("1. Receive data with timeout = %i s", timeout);
+        log.debug("1. Receive data with timeout = %i s", timeout);
         struct xbee_pkt *pkt;
         int counter = 0;
         while(((handle.error = xbee_conRxWait(handle.con, &pkt, NULL)) != XBEE_ENONE) && (counter < timeout)) log.printf("Counter = %i s",++counter);
@@ -312,7 +312,7 @@ XBee_Error XBee::receive(XBeeNode & handle, unsigned char **msg, int *len, int t
         if ((handle.error = xbee_pktFree(pkt)) != XBEE_ENONE) return (XBee_Error) log.error(xbee_errorToStr(handle.error),ERR_XBEE_FREE_PKT);
 
         // 2. Purge connection
-        log.printf("2. Purge connection");
+        log.debug("2. Purge connection");
         XBee_Error ret;
         if ( ret = purge(handle)) {
             handle.status = XBEE_ERROR;
@@ -423,7 +423,7 @@ XBee_Error XBee::getTelemetry(XBee_Telemetry & telemetry){
         struct xbee_con *local;
 
         // 1. Connect to local AT node
-        log.printf("1. Connect to local AT node");
+        log.debug("1. Connect to local AT node");
         error = xbee_conNew(xbee, &local, "Local AT", NULL);
         if (error != XBEE_ENONE) {
             status = XBEE_ERROR;
@@ -431,7 +431,7 @@ XBee_Error XBee::getTelemetry(XBee_Telemetry & telemetry){
         }
 
         // 2. Purge local connection
-        log.printf("2. Purge local connection");
+        log.debug("2. Purge local connection");
         error = xbee_conPurge(local);
         if (error != XBEE_ENONE){
             status = XBEE_ERROR;
@@ -2181,7 +2181,7 @@ XBee_Error XBee::getTelemetry(XBee_Telemetry & telemetry){
         }
 
         // 3. Close local connection
-        log.printf("3. Close local connection");
+        log.debug("3. Close local connection");
         error = xbee_conEnd(local);
         if (error != XBEE_ENONE) {
             status = XBEE_ERROR;
@@ -2217,7 +2217,7 @@ XBee_Error XBee::getNodeTelemetry(XBeeNode & handle, XBeeNode_Telemetry & teleme
         struct xbee_con *remote;
 
         // 1. Setup MAC address
-        log.printf("1. Setup MAC address = 0x%0lx", handle.address);
+        log.debug("1. Setup MAC address = 0x%0lx", handle.address);
         struct xbee_conAddress address;
         memset(&address, 0, sizeof(address));
         address.addr64_enabled = 1;
@@ -2226,7 +2226,7 @@ XBee_Error XBee::getNodeTelemetry(XBeeNode & handle, XBeeNode_Telemetry & teleme
         }
 
         // 2. Connect to remote AT node
-        log.printf("2. Connect to remote AT node");
+        log.debug("2. Connect to remote AT node");
         error = xbee_conNew(xbee, &remote, "Remote AT", &address);
         if (error != XBEE_ENONE) {
             status = XBEE_ERROR;
@@ -2234,7 +2234,7 @@ XBee_Error XBee::getNodeTelemetry(XBeeNode & handle, XBeeNode_Telemetry & teleme
         }
 
         // 3. Purge remote connection
-        log.printf("3. Purge remote connection");
+        log.debug("3. Purge remote connection");
         error = xbee_conPurge(remote);
         if (error != XBEE_ENONE){
             status = XBEE_ERROR;
@@ -4346,7 +4346,7 @@ XBee_Error XBee::getNodeTelemetry(XBeeNode & handle, XBeeNode_Telemetry & teleme
 
 
         // 4. Close remote connection
-        log.printf("4. Close remote connection");
+        log.debug("4. Close remote connection");
         error = xbee_conEnd(remote);
         if (error != XBEE_ENONE) {
             status = XBEE_ERROR;
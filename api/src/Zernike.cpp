@@ -0,0 +1,377 @@
+/***************************************************************************//**
+ * @file	Zernike.cpp
+ * @brief	Source file to decompose wavefronts on the Zernike polynomials
+ *
+ * This file contains all the implementations for the functions defined in:
+ * api/include/Zernike.hpp
+ *
+ * @author	Thibaud Talon
+ * @date	18/10/2026
+ *******************************************************************************/
+
+#include <math.h>
+#include <stdint.h>
+#include <opencv2/core/core.hpp>
+#include <gsl/gsl_cblas.h>
+#include "Zernike.hpp"
+#include "UserInterface.hpp"
+
+namespace Zernike{
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Number of modes up to a radial order
+ *
+ * @param [in] order
+ *	Largest radial order
+ ******************************************************************************/
+int numberOfModes(int order){
+    return (order + 1)*(order + 2)/2;
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Radial order and azimuthal frequency of a Noll index
+ *
+ * @param [in] j
+ *	Noll index (1 = piston, 2 = tilt x, 3 = tilt y, 4 = defocus, ...)
+ * @param [out] n
+ *	Radial order
+ * @param [out] m
+ *	Azimuthal frequency: positive = cosine (even j), negative = sine (odd j)
+ ******************************************************************************/
+void nollToNM(int j, int & n, int & m){
+    n = (int)((sqrt(8.*j - 7) - 1)/2);
+    int p = j - n*(n + 1)/2; // Position inside the radial order (1-based)
+    if ( n % 2 == 0 ) m = 2*(p/2);
+    else m = 2*((p - 1)/2) + 1;
+    if ( m != 0 && j % 2 == 1 ) m = -m;
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Coefficients of the radial polynomial R_n^m
+ *
+ * c[k] = (-1)^k (n-k)! / (k! ((n+m)/2-k)! ((n-m)/2-k)!) is computed with
+ * exact 64-bit integer factorials (n <= ZERNIKE_MAX_ORDER).
+ *
+ * @param [in] n
+ *	Radial order
+ * @param [in] m
+ *	Azimuthal frequency (sign ignored)
+ * @param [out] c
+ *	c[k] multiplies rho^(n-2k), k = 0 to (n-|m|)/2
+ ******************************************************************************/
+void radialCoefficients(int n, int m, std::vector<double> & c){
+    int64_t factorial[ZERNIKE_MAX_ORDER + 1];
+    factorial[0] = 1;
+    for(int II = 1; II <= n; II++) factorial[II] = factorial[II-1]*II;
+
+    m = abs(m);
+    c.resize((n - m)/2 + 1);
+    for(int k = 0; k <= (n - m)/2; k++){
+        int64_t value = factorial[n - k]/(factorial[k]*factorial[(n + m)/2 - k]*factorial[(n - m)/2 - k]);
+        c[k] = (k % 2 == 0) ? (double)value : -(double)value;
+    }
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Value and derivatives of a mode at a point of the unit disk
+ *
+ * With rho' = d/drho: dZ/dx = N (R' cos(t) T - R T' sin(t)/rho)
+ *                     dZ/dy = N (R' sin(t) T + R T' cos(t)/rho)
+ * R/rho is evaluated as a polynomial (R has a factor rho^|m|), so the
+ * derivatives are finite at the center.
+ ******************************************************************************/
+struct Mode{
+    int n, m;
+    double norm; // sqrt(n+1) for m = 0, sqrt(2(n+1)) otherwise
+    std::vector<double> c;
+};
+
+static void buildModes(int order, std::vector<Mode> & modes){
+    modes.resize(numberOfModes(order));
+    for(int j = 1; j <= (int)modes.size(); j++){
+        Mode & mode = modes[j-1];
+        nollToNM(j, mode.n, mode.m);
+        mode.norm = (mode.m == 0) ? sqrt(mode.n + 1.) : sqrt(2.*(mode.n + 1));
+        radialCoefficients(mode.n, mode.m, mode.c);
+    }
+}
+
+static void evaluateMode(const Mode & mode, double rho, double theta, double & z, double & dzdx, double & dzdy){
+    double R = 0, dR = 0, Rrho = 0;
+    for(size_t k = 0; k < mode.c.size(); k++){
+        int p = mode.n - 2*(int)k;
+        R += mode.c[k]*pow(rho, p);
+        if ( p > 0 ){
+            dR += mode.c[k]*p*pow(rho, p - 1);
+            Rrho += mode.c[k]*pow(rho, p - 1);
+        }
+    }
+
+    int m = abs(mode.m);
+    double T = 1, dT = 0;
+    if ( mode.m > 0 ) {T = cos(m*theta); dT = -m*sin(m*theta);}
+    else if ( mode.m < 0 ) {T = sin(m*theta); dT = m*cos(m*theta);}
+
+    double ct = cos(theta), st = sin(theta);
+    z = mode.norm*R*T;
+    dzdx = mode.norm*(dR*ct*T - Rrho*dT*st);
+    dzdy = mode.norm*(dR*st*T + Rrho*dT*ct);
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Least-squares pseudo-inverse (A'A)^-1 A' (SVD inverse of the small normal matrix)
+ ******************************************************************************/
+static void pseudoInverse(const cv::Mat & A, cv::Mat_<float> & pinv){
+    cv::Mat AtA = A.t()*A;
+    cv::Mat AtAinv;
+    cv::invert(AtA, AtAinv, cv::DECOMP_SVD);
+    cv::Mat P = AtAinv*A.t();
+    P.convertTo(pinv, CV_32F);
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Sample the modes on a pupil grid
+ *
+ * The pupil is the disk inscribed in the grid. The pseudo-inverse has zero
+ * columns outside of the pupil, so a wavefront is decomposed without
+ * gathering its pupil pixels (its values outside the pupil must be finite).
+ *
+ * @param [in] size
+ *	Number of pixels across the grid
+ * @param [in] order
+ *	Largest radial order
+ ******************************************************************************/
+Zernike_Error Zernike_Basis::buildPupil(int size, int order){
+    UserInterface::Log log("Zernike::buildPupil");
+    try
+    {
+        // 1. Check the inputs
+        log.debug("1. Check the inputs");
+        if ( size < 2 ) return (Zernike_Error) log.error("Grid too small", ERR_PUPIL_SIZE);
+        if ( order < 0 || order > ZERNIKE_MAX_ORDER ) return (Zernike_Error) log.error("Order out-of-bounds", ERR_ZERNIKE_ORDER);
+
+        // 2. Sample the modes
+        std::vector<Mode> modes;
+        buildModes(order, modes);
+        const int Nmodes = modes.size();
+        log.debug("2. Sample %i modes on a %ix%i grid", Nmodes, size, size);
+
+        cv::Mat_<double> basis = cv::Mat_<double>::zeros(size*size, Nmodes);
+        std::vector<int> pupil; // Index of the pupil pixels
+        const double radius = size/2.;
+        for(int r = 0; r < size; r++){
+            for(int c = 0; c < size; c++){
+                double x = (c + 0.5 - radius)/radius, y = (r + 0.5 - radius)/radius;
+                double rho = sqrt(x*x + y*y);
+                if ( rho > 1 ) continue;
+                double theta = atan2(y, x), dzdx, dzdy;
+                int index = r*size + c;
+                pupil.push_back(index);
+                for(int j = 0; j < Nmodes; j++) evaluateMode(modes[j], rho, theta, basis(index, j), dzdx, dzdy);
+            }
+        }
+
+        // 3. Pseudo-inverse on the pupil pixels
+        log.debug("3. Pseudo-inverse on %i pupil pixels", (int)pupil.size());
+        cv::Mat_<double> A((int)pupil.size(), Nmodes);
+        for(size_t II = 0; II < pupil.size(); II++){
+            cv::Mat_<double> row = A.row(II);
+            basis.row(pupil[II]).copyTo(row);
+        }
+        cv::Mat_<float> pinvPupil;
+        pseudoInverse(A, pinvPupil);
+
+        _pinv = cv::Mat_<float>::zeros(Nmodes, size*size);
+        for(size_t II = 0; II < pupil.size(); II++){
+            cv::Mat_<float> column = _pinv.col(pupil[II]);
+            pinvPupil.col(II).copyTo(column);
+        }
+        basis.convertTo(_basis, CV_32F);
+
+        _order = order;
+        _Nmodes = Nmodes;
+        _size = size;
+        _Nsub = 0;
+
+        return (Zernike_Error) log.success();
+    }
+    catch(  const std::exception& e  ){
+        _Nmodes = 0;
+        return (Zernike_Error) log.error(e.what(), ERR_PUPIL_FATAL);
+    }
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Sample the derivatives of the modes at subaperture positions
+ *
+ * The piston has no slope: its coefficient is always 0.
+ *
+ * @param [in] positions
+ *	Centers of the subapertures (2 x N, x;y in units of the pupil radius)
+ * @param [in] order
+ *	Largest radial order
+ ******************************************************************************/
+Zernike_Error Zernike_Basis::buildSlopes(const cv::Mat_<float> & positions, int order){
+    UserInterface::Log log("Zernike::buildSlopes");
+    try
+    {
+        // 1. Check the inputs
+        log.debug("1. Check the inputs");
+        if ( positions.rows != 2 || positions.cols < 1 ) return (Zernike_Error) log.error("Positions not 2 x N", ERR_SLOPES_POSITIONS);
+        if ( order < 1 || order > ZERNIKE_MAX_ORDER ) return (Zernike_Error) log.error("Order out-of-bounds", ERR_ZERNIKE_ORDER);
+
+        // 2. Sample the derivatives (x slopes then y slopes)
+        std::vector<Mode> modes;
+        buildModes(order, modes);
+        const int Nmodes = modes.size();
+        const int Nsub = positions.cols;
+        log.debug("2. Sample the derivatives of %i modes at %i subapertures", Nmodes, Nsub);
+
+        cv::Mat_<double> basis(2*Nsub, Nmodes);
+        for(int II = 0; II < Nsub; II++){
+            double x = positions(0, II), y = positions(1, II);
+            double rho = sqrt(x*x + y*y), theta = atan2(y, x), z;
+            for(int j = 0; j < Nmodes; j++) evaluateMode(modes[j], rho, theta, z, basis(II, j), basis(Nsub + II, j));
+        }
+
+        // 3. Pseudo-inverse
+        log.debug("3. Pseudo-inverse");
+        pseudoInverse(basis, _pinv);
+        basis.convertTo(_basis, CV_32F);
+
+        _order = order;
+        _Nmodes = Nmodes;
+        _size = 0;
+        _Nsub = Nsub;
+
+        return (Zernike_Error) log.success();
+    }
+    catch(  const std::exception& e  ){
+        _Nmodes = 0;
+        return (Zernike_Error) log.error(e.what(), ERR_SLOPES_FATAL);
+    }
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Coefficients of a wavefront (one GEMV with the cached pseudo-inverse)
+ *
+ * @param [in] wavefront
+ *	Wavefront on the pupil grid (size x size, single channel)
+ * @param [out] coefficients
+ *	Coefficient of each mode (Nmodes x 1, Noll order)
+ ******************************************************************************/
+Zernike_Error Zernike_Basis::decompose(const cv::Mat & wavefront, cv::Mat_<float> & coefficients) const{
+    UserInterface::Log log("Zernike::decompose");
+    try
+    {
+        // 1. Check the inputs
+        log.debug("1. Check the inputs");
+        if ( _Nmodes == 0 || _size == 0 ) return (Zernike_Error) log.error("No pupil basis", ERR_ZERNIKE_NO_BASIS);
+        if ( wavefront.rows != _size || wavefront.cols != _size || wavefront.channels() != 1 ) return (Zernike_Error) log.error("Wavefront does not match the grid", ERR_DECOMPOSE_SIZE);
+
+        // 2. Project
+        log.debug("2. Project on %i modes", _Nmodes);
+        cv::Mat w = wavefront;
+        if ( w.type() != CV_32F ) w.convertTo(w, CV_32F);
+        if ( !w.isContinuous() ) w = w.clone();
+        coefficients.create(_Nmodes, 1);
+        cblas_sgemv(CblasRowMajor, CblasNoTrans, _Nmodes, _size*_size, 1.f, _pinv.ptr<float>(0), _size*_size, w.ptr<float>(0), 1, 0.f, coefficients.ptr<float>(0), 1);
+
+        return (Zernike_Error) log.success();
+    }
+    catch(  const std::exception& e  ){
+        return (Zernike_Error) log.error(e.what(), ERR_DECOMPOSE_FATAL);
+    }
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Coefficients of Shack-Hartmann slopes (one GEMV with the cached pseudo-inverse)
+ *
+ * @param [in] slopes
+ *	Slopes in units of the pupil radius (2 x N: x slopes then y slopes)
+ * @param [out] coefficients
+ *	Coefficient of each mode (Nmodes x 1, Noll order)
+ ******************************************************************************/
+Zernike_Error Zernike_Basis::decomposeSlopes(const cv::Mat_<float> & slopes, cv::Mat_<float> & coefficients) const{
+    UserInterface::Log log("Zernike::decomposeSlopes");
+    try
+    {
+        // 1. Check the inputs
+        log.debug("1. Check the inputs");
+        if ( _Nmodes == 0 || _Nsub == 0 ) return (Zernike_Error) log.error("No slope basis", ERR_ZERNIKE_NO_BASIS);
+        if ( (int)slopes.total() != 2*_Nsub ) return (Zernike_Error) log.error("Slopes do not match the subapertures", ERR_DECOMPOSE_SIZE);
+
+        // 2. Project
+        log.debug("2. Project on %i modes", _Nmodes);
+        cv::Mat_<float> s = slopes.isContinuous() ? slopes : slopes.clone();
+        coefficients.create(_Nmodes, 1);
+        cblas_sgemv(CblasRowMajor, CblasNoTrans, _Nmodes, 2*_Nsub, 1.f, _pinv.ptr<float>(0), 2*_Nsub, s.ptr<float>(0), 1, 0.f, coefficients.ptr<float>(0), 1);
+
+        return (Zernike_Error) log.success();
+    }
+    catch(  const std::exception& e  ){
+        return (Zernike_Error) log.error(e.what(), ERR_DECOMPOSE_FATAL);
+    }
+}
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * Wavefront from coefficients (one GEMV with the cached basis)
+ *
+ * @param [in] coefficients
+ *	Coefficient of each mode (Nmodes x 1, Noll order)
+ * @param [out] wavefront
+ *	Wavefront on the pupil grid (0 outside of the pupil)
+ ******************************************************************************/
+Zernike_Error Zernike_Basis::reconstruct(const cv::Mat_<float> & coefficients, cv::Mat_<float> & wavefront) const{
+    UserInterface::Log log("Zernike::reconstruct");
+    try
+    {
+        // 1. Check the inputs
+        log.debug("1. Check the inputs");
+        if ( _Nmodes == 0 || _size == 0 ) return (Zernike_Error) log.error("No pupil basis", ERR_ZERNIKE_NO_BASIS);
+        if ( (int)coefficients.total() != _Nmodes ) return (Zernike_Error) log.error("Coefficients do not match the basis", ERR_RECONSTRUCT_SIZE);
+
+        // 2. Sum the modes
+        log.debug("2. Sum %i modes", _Nmodes);
+        cv::Mat_<float> a = coefficients.isContinuous() ? coefficients : coefficients.clone();
+        wavefront.create(_size, _size);
+        cblas_sgemv(CblasRowMajor, CblasNoTrans, _size*_size, _Nmodes, 1.f, _basis.ptr<float>(0), _Nmodes, a.ptr<float>(0), 1, 0.f, wavefront.ptr<float>(0), 1);
+
+        return (Zernike_Error) log.success();
+    }
+    catch(  const std::exception& e  ){
+        return (Zernike_Error) log.error(e.what(), ERR_RECONSTRUCT_FATAL);
+    }
+}
+
+} // namespace
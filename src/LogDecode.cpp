@@ -0,0 +1,125 @@
+/***************************************************************************//**
+ * @file	LogDecode.cpp
+ * @brief	Turn a binary log back into the text lines of the log
+ *
+ * @author	Thibaud Talon
+ * @date	18/10/2026
+ *
+ * @param [in] input
+ *	Binary log (see UserInterface::openBinaryLog)
+ * @param [in] output
+ *	Text file (same layout as the text log)
+ *******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include "UserInterface.hpp"
+#include "AsyncLog.hpp"
+
+/***************************************************************************//**
+ * @author Thibaud Talon
+ * @date   18/10/2026
+ *
+ * LEB128 varint (false at the end of the file)
+ ******************************************************************************/
+static bool getVarint(FILE * file, uint64_t & value){
+    value = 0;
+    for(int shift = 0; shift < 64; shift += 7){
+        int byte = fgetc(file);
+        if ( byte == EOF ) return false;
+        value |= (uint64_t)(byte & 0x7F) << shift;
+        if ( (byte & 0x80) == 0 ) return true;
+    }
+    return false;
+}
+
+static int64_t unzigzag(uint64_t value){
+    return (int64_t)(value >> 1) ^ -(int64_t)(value & 1);
+}
+
+int main(int argc, char* argv[]){
+    UserInterface::Log log("LogDecode");
+
+    // 1. Parsing data
+    log.printf("1. Parsing inputs");
+    if(argc < 3) return log.error("No input, output specified",-1);
+    else if(argc > 3) log.warning("Extra inputs discarded");
+
+    // 2. Read the header
+    log.printf("2. Read the header");
+    FILE * input = fopen(argv[1], "rb");
+    if( input == NULL ) return log.error("Cannot open input", -1);
+    UserInterface::Log_BinaryHeader header;
+    if( fread(&header, sizeof(header), 1, input) != 1 || memcmp(header.magic, LOG_BINARY_MAGIC, sizeof(header.magic)) != 0 ) {fclose(input); return log.error("Not a binary log", -1);}
+    if( header.byteOrder != LOG_BINARY_BYTE_ORDER ) {fclose(input); return log.error("Byte order of the log not supported", -1);}
+    if( header.version < 1 || header.version > LOG_BINARY_VERSION ) {fclose(input); return log.error("Version of the log not supported", -1);}
+
+    FILE * output = fopen(argv[2], "w");
+    if( output == NULL ) {fclose(input); return log.error("Cannot open output", -1);}
+    int Nrecords = 0;
+    bool truncated = false, corrupted = false;
+    {
+        UserInterface::Log_TextSink sink(output); // Flushed when the block ends, before output is closed
+        int64_t offset = 0; // Version 1: CLOCK_MONOTONIC times, turned into dates with the clock anchor
+        if( header.version == 1 ) offset = (header.realtimeSec - header.monotonicSec)*1000000000LL + (header.realtimeNsec - header.monotonicNsec);
+
+        // 3. Decode the entries
+        log.printf("3. Decode the entries");
+        std::vector<std::string> strings(1); // Id 0 = no string
+        std::vector<char> text;
+        UserInterface::Log_Record record;
+        int64_t time = 0;
+        int tag;
+        while( (tag = fgetc(input)) != EOF ){
+            uint64_t a, b, c, d, e, f, g;
+            if( tag == UserInterface::LOG_TAG_STRING ){
+                if( !getVarint(input, a) || !getVarint(input, b) ) {truncated = true; break;}
+                text.resize(b);
+                if( b > 0 && fread(&text[0], 1, b, input) != b ) {truncated = true; break;}
+                if( a >= strings.size() ) strings.resize(a + 1);
+                strings[a].assign(text.begin(), text.end());
+            }
+            else if( tag == UserInterface::LOG_TAG_RECORD ){
+                int level, kind;
+                if( !getVarint(input, a) || !getVarint(input, b) || !getVarint(input, c) || !getVarint(input, d) ) {truncated = true; break;}
+                if( (level = fgetc(input)) == EOF || (kind = fgetc(input)) == EOF ) {truncated = true; break;}
+                if( !getVarint(input, e) || !getVarint(input, f) ) {truncated = true; break;}
+                if( b >= strings.size() || c >= strings.size() || f > LOG_ARGS_SIZE ) {corrupted = true; break;}
+                if( f > 0 && fread(record.args, 1, f, input) != f ) {truncated = true; break;}
+
+                time += unzigzag(a);
+                record.time.tv_sec = (time + offset)/1000000000LL;
+                record.time.tv_nsec = (time + offset)%1000000000LL;
+                record.name = strings[b].c_str();
+                record.fmt = strings[c].c_str();
+                record.increment = (int) d;
+                record.level = level;
+                record.kind = kind;
+                record.code = (int) unzigzag(e);
+                record.Nbytes = (int) f;
+                sink.write(&record, 1);
+                Nrecords++;
+            }
+            else if( tag == UserInterface::LOG_TAG_TEXT ){
+                if( !getVarint(input, g) ) {truncated = true; break;}
+                text.resize(g + 1);
+                if( g > 0 && fread(&text[0], 1, g, input) != g ) {truncated = true; break;}
+                text[g] = 0;
+                sink.writeText(&text[0]);
+            }
+            else {corrupted = true; break;}
+        }
+    }
+    fclose(input);
+    fclose(output);
+    if( corrupted ) return log.error("Corrupted log", -1);
+
+    // 4. Display the results
+    log.printf("4. Display the results");
+    log.printf("%i records decoded", Nrecords);
+    if( truncated ) log.warning("Log truncated (last entry incomplete)");
+
+    return log.success();
+}
@@ -0,0 +1,64 @@
+/***************************************************************************//**
+ * @file	RecordBICVideo.cpp
+ * @brief	Record video from Boom Inspection Camera without loss, in segments
+ *
+ * @author	Thibaud Talon
+ * @date	18/10/2026
+ *
+ * @param [in] basename
+ *	Name of the files without extension (<basename>_NNNN.far, <basename>.idx)
+ * @param [in] fps
+ *	Frames per second of the video
+ * @param [in] duration_s
+ *	Duration of the video in seconds
+ * @param [in] segment_s
+ *	Duration of a segment in seconds
+ * @param [in] raw (optional)
+ *	1 to write the frames as they are (default: lossless compression)
+ *******************************************************************************/
+
+#include <math.h> // ceil
+#include "UserInterface.hpp"
+#include "ImagingCamera.hpp"
+#include "FrameArchive.hpp"
+#include "AAReST.hpp"
+
+int main(int argc, char* argv[]){
+    UserInterface::Log log("RecordBICVideo");
+
+    // 1. Parsing data
+    log.printf("1. Parsing inputs");
+    if(argc < 5) return log.error("No basename, framerate (fps), duration (s), segment duration (s) specified",-1);
+    else if(argc > 6) log.warning("Extra inputs discarded");
+
+    ImagingCamera_Error error1;
+    FrameArchive::FrameArchive_Error error2;
+    float fps = atof(argv[2]);
+    FrameArchive::FrameArchive_Encoding encoding = (argc > 5 && atoi(argv[5])) ? FrameArchive::FRAMEARCHIVE_RAW : FrameArchive::FRAMEARCHIVE_SPOTS;
+
+    // 2. Connect camera
+    log.printf("2. Connect camera");
+    ImagingCamera BoomInspectionCamera(IMAGINGCAMERA_BOOM_INSPECTION_CAMERA);
+    if( BoomInspectionCamera.status != IMAGINGCAMERA_ON ) return log.error("Error connecting to camera", BoomInspectionCamera.status);
+
+    // 3. Set ROI
+    log.printf("3. Set ROI");
+    if( error1 = BoomInspectionCamera.setROI(BIC_OFFSETX, BIC_OFFSETY, BIC_WIDTH, BIC_HEIGHT) ) return log.error("Could not set ROI", error1);
+
+    // 4. Start the recording
+    log.printf("4. Start the recording");
+    FrameArchive::FrameArchive_Recorder recorder;
+    if( error2 = recorder.open(argv[1], (int)ceil(fps*atof(argv[4])), encoding) ) return log.error("Cannot start the recording", error2);
+
+    // 5. Get video
+    log.printf("5. Get video");
+    error1 = BoomInspectionCamera.getVideo(recorder, fps, atof(argv[3]));
+
+    // 6. Close the recording (frames already taken are kept)
+    log.printf("6. Close the recording");
+    error2 = recorder.close();
+    if( error1 ) return log.error("Could not get video", error1);
+    if( error2 ) return log.error("Error while recording", error2);
+
+    return log.success();
+}
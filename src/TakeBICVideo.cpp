@@ -23,7 +23,7 @@ int main(int argc, char* argv[]){
     // 1. Parsing data
     log.printf("1. Parsing inputs");
     if(argc < 4) return log.error("No filename, framerate (fps), duration (s) specified",-1);
-    else if(argc > 4) log.printf("WARNING: Extra inputs discarded");
+    else if(argc > 4) log.warning("Extra inputs discarded");
 
     ImagingCamera_Error error1;
     UserInterface::UserInterface_Error error2;
@@ -15,7 +15,7 @@ int main(int argc, char* argv[]){
 
     // 1. Parsing data
     log.printf("1. Parsing inputs");
-    if(argc > 1) log.printf("WARNING: Extra inputs discarded");
+    if(argc > 1) log.warning("Extra inputs discarded");
 
     ImagingCamera_Error error;
 
@@ -0,0 +1,68 @@
+/***************************************************************************//**
+ * @file	Calibration_BuildMaps.cpp
+ * @brief	Test file to build, save, load and apply dark/flat/bad pixel correction maps
+ *
+ * @author	Thibaud Talon
+ * @date	18/10/2026
+ *
+ * @param [in] filename
+ *	Output calibration file
+ * @param [in] filename
+ *	Dark image file
+ * @param [in] filename
+ *	Flat image file
+ * @param [in] filename
+ *	Raw image file to correct
+ * @param [in] filename
+ *	Output corrected image file
+ *******************************************************************************/
+
+#include "UserInterface.hpp"
+#include "Calibration.hpp"
+
+int main(int argc, char* argv[]){
+    UserInterface::Log log("Algorithm");
+
+    // 1. Parsing data
+    log.printf("1. Parsing data");
+    if(argc < 6) return log.error("No filenames (calibration, dark, flat, raw, corrected) specified",-1);
+    else if(argc > 6) log.warning("Extra inputs discarded");
+
+    UserInterface::UserInterface_Error error1;
+    Calibration::Calibration_Error error2;
+    cv::Mat img;
+
+    // 2. Build master dark
+    log.printf("2. Build master dark");
+    std::vector<cv::Mat> darks(1);
+    if( error1 = UserInterface::loadImage(argv[2], darks[0]) ) return log.error("Error loading dark", error1);
+    Calibration::Calibration_Map map;
+    map.exposure_us = 10000;
+    map.gain_dB = 0;
+    if( error2 = Calibration::buildMasterDark(darks, map.dark) ) return log.error("Error building dark", error2);
+
+    // 3. Build master flat
+    log.printf("3. Build master flat");
+    std::vector<cv::Mat> flats(1);
+    if( error1 = UserInterface::loadImage(argv[3], flats[0]) ) return log.error("Error loading flat", error1);
+    if( error2 = Calibration::buildMasterFlat(flats, map.dark, map.gain) ) return log.error("Error building flat", error2);
+
+    // 4. Find the bad pixels
+    log.printf("4. Find the bad pixels");
+    if( error2 = Calibration::buildBadPixelMap(map.dark, map.gain, 5, 0.5, map.badPixels) ) return log.error("Error building bad pixel map", error2);
+
+    // 5. Save and load the maps
+    log.printf("5. Save and load the maps");
+    Calibration::Calibration_Library library;
+    library.add(map);
+    if( error2 = library.save(argv[1]) ) return log.error("Error saving maps", error2);
+    if( error2 = library.load(argv[1]) ) return log.error("Error loading maps", error2);
+
+    // 6. Correct the raw image
+    log.printf("6. Correct the raw image");
+    if( error1 = UserInterface::loadImage(argv[4], img) ) return log.error("Error loading raw image", error1);
+    if( error2 = library.apply(img, 10000, 0, img) ) return log.error("Error correcting image", error2);
+    if( error1 = UserInterface::saveImage(img, argv[5]) ) return log.error("Error saving corrected image", error1);
+
+    return log.success();
+}
@@ -0,0 +1,73 @@
+/***************************************************************************//**
+ * @file	FrameArchive_WriteRead.cpp
+ * @brief	Test file to write synthetic frames to an archive and read them back
+ *
+ * @author	Thibaud Talon
+ * @date	18/10/2026
+ *
+ * @param [in] filename
+ *	Name of the archive
+ * @param [in] Nframes
+ *	Number of frames
+ *******************************************************************************/
+
+#include <unistd.h> // truncate
+#include <time.h>
+#include "UserInterface.hpp"
+#include "FrameArchive.hpp"
+
+int main(int argc, char* argv[]){
+    UserInterface::Log log("Algorithm");
+
+    // 1. Parsing data
+    log.printf("1. Parsing data");
+    if(argc < 3) return log.error("No filename, number of frames specified",-1);
+    else if(argc > 3) log.warning("Extra inputs discarded");
+
+    FrameArchive::FrameArchive_Error error;
+    int Nframes = atoi(argv[2]);
+    if( Nframes < 1 ) return log.error("Number of frames must be positive", -1);
+
+    // 2. Synthetic frames
+    log.printf("2. Synthetic frames");
+    std::vector<cv::Mat> frames(Nframes);
+    for(int II = 0; II < Nframes; II++){
+        frames[II].create(480, 640, CV_16UC1);
+        cv::randu(frames[II], 0, 4096);
+    }
+
+    // 3. Write the archive
+    log.printf("3. Write the archive");
+    struct timespec t0, t1;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    FrameArchive::FrameArchive_Writer writer;
+    if( error = writer.open(argv[1]) ) return log.error("Error creating the archive", error);
+    for(int II = 0; II < Nframes; II++){
+        FrameArchive::FrameArchive_Metadata metadata = {0, 1000, 0, 0, 0, 0, 0, II};
+        if( error = writer.append(frames[II], metadata) ) return log.error("Error appending a frame", error);
+    }
+    if( error = writer.close() ) return log.error("Error closing the archive", error);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    log.printf("Written in %f ms", (t1.tv_sec - t0.tv_sec)*1e3 + (t1.tv_nsec - t0.tv_nsec)*1e-6);
+
+    // 4. Read the frames back (in reverse order)
+    log.printf("4. Read the frames back");
+    FrameArchive::FrameArchive_Reader reader;
+    if( error = reader.open(argv[1]) ) return log.error("Error opening the archive", error);
+    if( reader.size() != Nframes ) return log.error("Wrong number of frames", -1);
+    for(int II = Nframes-1; II >= 0; II--){
+        cv::Mat frame;
+        FrameArchive::FrameArchive_Metadata metadata;
+        if( error = reader.read(II, frame, metadata) ) return log.error("Error reading a frame", error);
+        if( metadata.frame != II || cv::norm(frame, frames[II], cv::NORM_INF) > 0 ) return log.error("Frames differ", -1);
+    }
+    reader.close();
+
+    // 5. Remove the footer and read the archive again (index rebuilt)
+    log.printf("5. Remove the footer and read the archive again");
+    if( truncate(argv[1], writer.bytes()) != 0 ) return log.error("Cannot truncate the archive", -1);
+    if( error = reader.open(argv[1]) ) return log.error("Error opening the archive", error);
+    if( !reader.recovered() || reader.size() != Nframes ) return log.error("Index not rebuilt", -1);
+
+    return log.success();
+}
@@ -0,0 +1,70 @@
+/***************************************************************************//**
+ * @file	ImageProc_CentroidKernels.cpp
+ * @brief	Test file to compare the integer and floating-point centroid kernels
+ *
+ * The integer kernel (8 and 16-bit images) must give the centroid of a
+ * double-precision reference sum bit for bit. The floating-point kernel
+ * (used for CV_32F images) is run on the same frame converted to float.
+ *
+ * @author	Thibaud Talon
+ * @date	18/10/2026
+ *
+ * @param [in] side
+ *	Side of the random 16-bit frame in px (at most 2048)
+ *******************************************************************************/
+
+#include <math.h>
+#include <stdint.h>
+#include "UserInterface.hpp"
+#include "ImageProc.hpp"
+
+int main(int argc, char* argv[]){
+    UserInterface::Log log("Algorithm");
+
+    // 1. Parsing data
+    log.printf("1. Parsing data");
+    if(argc < 2) return log.error("No side of the frame specified",-1);
+    else if(argc > 2) log.warning("Extra inputs discarded");
+
+    ImageProc::ImageProc_Error error;
+    int side = atoi(argv[1]);
+    if( side < 1 || side > 2048 ) return log.error("Side must be in [1;2048]", -1);
+
+    // 2. Random 16-bit frame
+    log.printf("2. Random 16-bit frame");
+    cv::Mat img(side, side, CV_16UC1);
+    cv::randu(img, 0, 65536);
+
+    // 3. Reference sums (exact integers, then double)
+    log.printf("3. Reference sums");
+    uint64_t m00 = 0, m10 = 0, m01 = 0;
+    for(int r = 0; r < img.rows; r++){
+        const ushort * p = img.ptr<ushort>(r);
+        for(int c = 0; c < img.cols; c++){
+            m00 += p[c];
+            m10 += (uint64_t)p[c]*c;
+            m01 += (uint64_t)p[c]*r;
+        }
+    }
+    float xRef = (float)((double)m10/(double)m00);
+    float yRef = (float)((double)m01/(double)m00);
+    log.printf("Reference = (%.9g;%.9g)", xRef, yRef);
+
+    // 4. Integer kernel (16-bit frame)
+    log.printf("4. Integer kernel");
+    cv::Mat_<float> center;
+    if( error = ImageProc::getSpotLoc(img, center) ) return log.error("Error with the integer kernel", error);
+    log.printf("Integer kernel = (%.9g;%.9g)", center(0), center(1));
+    if( center(0) != xRef || center(1) != yRef ) return log.error("Integer kernel differs from the reference", -1);
+
+    // 5. Floating-point kernel (same frame as float)
+    log.printf("5. Floating-point kernel");
+    cv::Mat imgFloat;
+    img.convertTo(imgFloat, CV_32F);
+    cv::Mat_<float> centerFloat;
+    if( error = ImageProc::getSpotLoc(imgFloat, centerFloat) ) return log.error("Error with the floating-point kernel", error);
+    log.printf("Floating-point kernel = (%.9g;%.9g), difference = (%g;%g) px", centerFloat(0), centerFloat(1), centerFloat(0) - xRef, centerFloat(1) - yRef);
+    if( fabs(centerFloat(0) - xRef) > 1e-3 || fabs(centerFloat(1) - yRef) > 1e-3 ) return log.error("Kernels differ by more than 1e-3 px", -1);
+
+    return log.success();
+}
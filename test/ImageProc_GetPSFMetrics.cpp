@@ -0,0 +1,59 @@
+/***************************************************************************//**
+ * @file	ImageProc_GetPSFMetrics.cpp
+ * @brief	Test file to measure a PSF in one pass over a window
+ *
+ * @author	Thibaud Talon
+ * @date	18/10/2026
+ *
+ * @param [in] filename
+ *	Input image file
+ * @param [in] left, top, width, height
+ *	Window around the PSF
+ *******************************************************************************/
+
+#include "UserInterface.hpp"
+#include "ImageProc.hpp"
+
+int main(int argc, char* argv[]){
+    UserInterface::Log log("Algorithm");
+
+    // 1. Parsing data
+    log.printf("1. Parsing data");
+    if(argc < 6) return log.error("No filename, left, top, width, height specified",-1);
+    else if(argc > 6) log.warning("Extra inputs discarded");
+
+    UserInterface::UserInterface_Error error1;
+    ImageProc::ImageProc_Error error2;
+    cv::Mat img;
+
+    // 2. Load image
+    log.printf("2. Load image");
+    if( error1 = UserInterface::loadImage(argv[1], img) ) return log.error("Error loading image", error1);
+
+    // 3. Measure the PSF
+    log.printf("3. Measure the PSF");
+    ImageProc::ImageProc_PSF psf;
+    cv::Rect window(atoi(argv[2]), atoi(argv[3]), atoi(argv[4]), atoi(argv[5]));
+    if( error2 = ImageProc::getPSFMetrics(img, window, psf) ) return log.error("Error measuring the PSF", error2);
+
+    // 4. Display the metrics
+    log.printf("4. Display the metrics");
+    log.printf("Centroid = (%f;%f)", psf.x, psf.y);
+    log.printf("Background = %f, flux = %f", psf.background, psf.flux);
+    log.printf("Peak = %f at (%i;%i)", psf.peak, psf.peakX, psf.peakY);
+    log.printf("FWHM = %f x %f px, angle = %f rad, ellipticity = %f", psf.fwhmMajor, psf.fwhmMinor, psf.angle, psf.ellipticity);
+    log.printf("Strehl proxy (peak/flux) = %f", psf.strehl);
+    log.printf("Radius of 50%% energy = %f px", psf.radiusOfEnergy(50));
+    log.printf("Radius of 80%% energy = %f px", psf.radiusOfEnergy(80));
+
+    // 5. Compare with the binary search
+    log.printf("5. Compare with the binary search");
+    cv::Mat_<float> center(2,1);
+    center(0) = psf.x;
+    center(1) = psf.y;
+    float radius;
+    if( error2 = ImageProc::getRadiusOfEncircleEnergy(img, center, 80, 0.5, radius, 100) ) return log.error("Error computing the radius", error2);
+    log.printf("Radius of 80%% energy (binary search, whole image) = %f px", radius);
+
+    return log.success();
+}
@@ -0,0 +1,65 @@
+/***************************************************************************//**
+ * @file	ImageProc_GetSpotLoc.cpp
+ * @brief	Test file to compare the centroid estimators on an image
+ *
+ * @author	Thibaud Talon
+ * @date	18/10/2026
+ *
+ * @param [in] filename
+ *	Input image file
+ * @param [in] halfWidth
+ *	Half width of the window around the brightest pixel in px
+ *******************************************************************************/
+
+#include "UserInterface.hpp"
+#include "ImageProc.hpp"
+
+int main(int argc, char* argv[]){
+    UserInterface::Log log("Algorithm");
+
+    // 1. Parsing data
+    log.printf("1. Parsing data");
+    if(argc < 3) return log.error("No filename, half width of window (px) specified",-1);
+    else if(argc > 3) log.warning("Extra inputs discarded");
+
+    UserInterface::UserInterface_Error error1;
+    ImageProc::ImageProc_Error error2;
+    cv::Mat img;
+
+    // 2. Load image
+    log.printf("2. Load image");
+    if( error1 = UserInterface::loadImage(argv[1], img) ) return log.error("Error loading image", error1);
+
+    // 3. Centroid of the whole image
+    log.printf("3. Centroid of the whole image");
+    cv::Mat_<float> center;
+    if( error2 = ImageProc::getSpotLoc(img, center) ) return log.error("Error finding centroid", error2);
+    log.printMat("Centroid (whole image)", center);
+
+    // 4. Window around the centroid
+    log.printf("4. Window around the centroid");
+    int halfWidth = atoi(argv[2]);
+    cv::Rect window((int)center(0) - halfWidth, (int)center(1) - halfWidth, 2*halfWidth+1, 2*halfWidth+1);
+
+    // 5. Compare the estimators
+    log.printf("5. Compare the estimators");
+    if( error2 = ImageProc::getSpotLoc(img, center, ImageProc::CENTROID_COG, window) ) return log.error("Error with COG", error2);
+    log.printMat("Centroid (COG)", center);
+    if( error2 = ImageProc::getSpotLoc(img, center, ImageProc::CENTROID_IWCOG, window) ) return log.error("Error with IWCOG", error2);
+    log.printMat("Centroid (IWCOG)", center);
+    if( error2 = ImageProc::getSpotLoc(img, center, ImageProc::CENTROID_GAUSSIAN, window) ) return log.error("Error with Gaussian fit", error2);
+    log.printMat("Centroid (Gaussian)", center);
+
+    // 6. Batch over the four quadrants of the window
+    log.printf("6. Batch over the four quadrants of the window");
+    std::vector<cv::Rect> windows;
+    windows.push_back(cv::Rect(window.x, window.y, halfWidth, halfWidth));
+    windows.push_back(cv::Rect(window.x + halfWidth, window.y, halfWidth, halfWidth));
+    windows.push_back(cv::Rect(window.x, window.y + halfWidth, halfWidth, halfWidth));
+    windows.push_back(cv::Rect(window.x + halfWidth, window.y + halfWidth, halfWidth, halfWidth));
+    cv::Mat_<float> centers;
+    if( error2 = ImageProc::getSpotLoc(img, windows, centers, ImageProc::CENTROID_GAUSSIAN) ) return log.error("Error with batch", error2);
+    log.printMat("Centroids (batch)", centers);
+
+    return log.success();
+}
@@ -0,0 +1,54 @@
+/***************************************************************************//**
+ * @file	ImageProc_GetSpotsLoc.cpp
+ * @brief	Test file to find all the spots of an image with the labeling
+ *
+ * @author	Thibaud Talon
+ * @date	18/10/2026
+ *
+ * @param [in] filename
+ *	Input image file
+ * @param [in] threshold
+ *	Pixels above the threshold belong to a spot
+ * @param [in] Nstrips
+ *	Number of strips labeled in parallel
+ *******************************************************************************/
+
+#include "UserInterface.hpp"
+#include "ImageProc.hpp"
+
+int main(int argc, char* argv[]){
+    UserInterface::Log log("Algorithm");
+
+    // 1. Parsing data
+    log.printf("1. Parsing data");
+    if(argc < 4) return log.error("No filename, threshold, number of strips specified",-1);
+    else if(argc > 4) log.warning("Extra inputs discarded");
+
+    UserInterface::UserInterface_Error error1;
+    ImageProc::ImageProc_Error error2;
+    cv::Mat img;
+
+    // 2. Load image
+    log.printf("2. Load image");
+    if( error1 = UserInterface::loadImage(argv[1], img) ) return log.error("Error loading image", error1);
+
+    // 3. Label the spots
+    log.printf("3. Label the spots");
+    ImageProc::ImageProc_Blobs blobs;
+    if( error2 = ImageProc::getSpotsLoc(img, blobs, atof(argv[2]), 3, 4000000, atoi(argv[3])) ) return log.error("Error labeling spots", error2);
+
+    // 4. Display the spots
+    log.printf("4. Display the spots");
+    for(size_t II = 0; II < blobs.size(); II++){
+        log.printf("Spot #%i: (%f;%f) area = %i flux = %f peak = %f box = %ix%i at %ix%i", (int)II, blobs.x[II], blobs.y[II], blobs.area[II], blobs.flux[II], blobs.peak[II], blobs.width[II], blobs.height[II], blobs.left[II], blobs.top[II]);
+    }
+
+    // 5. Convert to a list of spots
+    log.printf("5. Convert to a list of spots");
+    ImageProc::ImageProc_SpotList spots;
+    blobs.getSpots(spots);
+    cv::Mat_<float> spotsPositionArray = spots.asMat();
+    log.printMat("Spots (x;y;size)", spotsPositionArray);
+
+    return log.success();
+}
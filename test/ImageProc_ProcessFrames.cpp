@@ -0,0 +1,64 @@
+/***************************************************************************//**
+ * @file	ImageProc_ProcessFrames.cpp
+ * @brief	Test file to find the spots of every frame of a sequence on several cores
+ *
+ * @author	Thibaud Talon
+ * @date	18/10/2026
+ *
+ * @param [in] source
+ *	Input video file or directory of images
+ * @param [in] threshold
+ *	Pixels above the threshold belong to a spot
+ * @param [in] Nthreads
+ *	Number of workers (0 = number of cores)
+ *******************************************************************************/
+
+#include <sys/stat.h>
+#include "UserInterface.hpp"
+#include "ImageProc.hpp"
+#include "ImageBatch.hpp"
+
+int main(int argc, char* argv[]){
+    UserInterface::Log log("Algorithm");
+
+    // 1. Parsing data
+    log.printf("1. Parsing data");
+    if(argc < 4) return log.error("No source, threshold, number of workers specified",-1);
+    else if(argc > 4) log.warning("Extra inputs discarded");
+
+    ImageProc::ImageProc_Error error;
+
+    // 2. Open the source
+    log.printf("2. Open the source");
+    struct stat info;
+    ImageProc::ImageProc_FrameSource * source;
+    if( stat(argv[1], &info) == 0 && S_ISDIR(info.st_mode) ) source = new ImageProc::ImageProc_DirectorySource(argv[1]);
+    else source = new ImageProc::ImageProc_VideoSource(argv[1]);
+
+    // 3. Build the chain
+    log.printf("3. Build the chain");
+    ImageProc::ImageProc_SpotsLocStage spotsLoc(atof(argv[2]));
+    ImageProc::ImageProc_EncircledEnergyStage encircledEnergy(80, 1);
+    std::vector<const ImageProc::ImageProc_Stage *> stages;
+    stages.push_back(&spotsLoc);
+    stages.push_back(&encircledEnergy);
+
+    // 4. Process the frames
+    log.printf("4. Process the frames");
+    std::vector<ImageProc::ImageProc_FrameResult> results;
+    error = ImageProc::processFrames(*source, stages, results, false, atoi(argv[3]));
+    delete source;
+    if( error ) return log.error("Error processing frames", error);
+
+    // 5. Display the results
+    log.printf("5. Display the results");
+    for(size_t II = 0; II < results.size(); II++){
+        if( results[II].error ) {log.printf("Frame #%i: stage %i failed (error %i)", results[II].index, results[II].stage, results[II].error); continue;}
+        log.printf("Frame #%i: %i spots", results[II].index, results[II].spots.size());
+        for(int JJ = 0; JJ < results[II].spots.size(); JJ++){
+            log.printf("  Spot #%i: (%f;%f) radius of 80%% energy = %f", JJ, results[II].spots.x()[JJ], results[II].spots.y()[JJ], results[II].values[JJ]);
+        }
+    }
+
+    return log.success();
+}
@@ -0,0 +1,76 @@
+/***************************************************************************//**
+ * @file	ImageProc_ProcessFramesInFlight.cpp
+ * @brief	Test file to check that the results of a batch longer than the frames in flight stay intact
+ *
+ * @author	Thibaud Talon
+ * @date	18/10/2026
+ *
+ * @param [in] Nframes
+ *	Number of synthetic frames (one spot each, at a position given by the frame)
+ * @param [in] maxInFlight
+ *	Maximum number of frames in flight (smaller than Nframes)
+ *******************************************************************************/
+
+#include <math.h>
+#include "UserInterface.hpp"
+#include "ImageProc.hpp"
+#include "ImageBatch.hpp"
+
+#define SPOT_X(k) (10 + (k)%100) // Centre of the spot of frame k
+#define SPOT_Y(k) (20 + (k)/100)
+
+/***************************************************************************//**
+ * Frames of 128x128 pixels with a 3x3 spot at (SPOT_X(k);SPOT_Y(k))
+ ******************************************************************************/
+class SyntheticSource : public ImageProc::ImageProc_FrameSource{
+public:
+    SyntheticSource(int Nframes) : _Nframes(Nframes), _k(0) {}
+    bool read(cv::Mat & frame){
+        if ( _k >= _Nframes ) return false;
+        frame = cv::Mat::zeros(128, 128, CV_8UC1);
+        frame(cv::Rect(SPOT_X(_k) - 1, SPOT_Y(_k) - 1, 3, 3)).setTo(cv::Scalar(255));
+        _k++;
+        return true;
+    }
+
+private:
+    int _Nframes, _k;
+};
+
+int main(int argc, char* argv[]){
+    UserInterface::Log log("Algorithm");
+
+    // 1. Parsing data
+    log.printf("1. Parsing data");
+    if(argc < 3) return log.error("No number of frames, frames in flight specified",-1);
+    else if(argc > 3) log.warning("Extra inputs discarded");
+
+    ImageProc::ImageProc_Error error;
+    int Nframes = atoi(argv[1]);
+    int maxInFlight = atoi(argv[2]);
+    if( Nframes < 1 || Nframes > 2000 || maxInFlight < 1 ) return log.error("Number of frames must be in [1;2000], frames in flight positive", -1);
+    if( Nframes <= maxInFlight ) log.warning("The slots are not reused: use more frames than frames in flight");
+
+    // 2. Process the frames
+    log.printf("2. Process the frames");
+    SyntheticSource source(Nframes);
+    ImageProc::ImageProc_SpotsLocStage spotsLoc(128);
+    std::vector<const ImageProc::ImageProc_Stage *> stages;
+    stages.push_back(&spotsLoc);
+    std::vector<ImageProc::ImageProc_FrameResult> results;
+    if( error = ImageProc::processFrames(source, stages, results, false, 2, maxInFlight) ) return log.error("Error processing frames", error);
+
+    // 3. Check every result once the batch is done
+    log.printf("3. Check every result");
+    if( (int)results.size() != Nframes ) return log.error("Wrong number of results", -1);
+    for(int II = 0; II < Nframes; II++){
+        const ImageProc::ImageProc_FrameResult & result = results[II];
+        if( result.index != II || result.error || result.spots.size() != 1 ) return log.error("Wrong result", -1);
+        if( fabs(result.spots.x()[0] - SPOT_X(II)) > 1e-3 || fabs(result.spots.y()[0] - SPOT_Y(II)) > 1e-3 ){
+            log.printf("Frame #%i: spot at (%f;%f) instead of (%i;%i)", II, result.spots.x()[0], result.spots.y()[0], SPOT_X(II), SPOT_Y(II));
+            return log.error("Result overwritten", -1);
+        }
+    }
+
+    return log.success();
+}
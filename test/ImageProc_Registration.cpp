@@ -0,0 +1,52 @@
+/***************************************************************************//**
+ * @file	ImageProc_Registration.cpp
+ * @brief	Test file to measure the shift between images by phase correlation
+ *
+ * @author	Thibaud Talon
+ * @date	18/10/2026
+ *
+ * @param [in] reference
+ *	Reference image file
+ * @param [in] filenames
+ *	Image files to register against the reference
+ *******************************************************************************/
+
+#include "UserInterface.hpp"
+#include "ImageProc.hpp"
+#include "ImageRegistration.hpp"
+
+int main(int argc, char* argv[]){
+    UserInterface::Log log("Algorithm");
+
+    // 1. Parsing data
+    log.printf("1. Parsing data");
+    if(argc < 3) return log.error("No reference, image filenames specified",-1);
+
+    UserInterface::UserInterface_Error error1;
+    ImageProc::ImageProc_Error error2;
+    cv::Mat reference;
+    std::vector<cv::Mat> frames(argc-2);
+
+    // 2. Load images
+    log.printf("2. Load images");
+    if( error1 = UserInterface::loadImage(argv[1], reference) ) return log.error("Error loading reference", error1);
+    for(int II = 2; II < argc; II++){
+        if( error1 = UserInterface::loadImage(argv[II], frames[II-2]) ) return log.error("Error loading image", error1);
+    }
+
+    // 3. Cache the reference
+    log.printf("3. Cache the reference");
+    ImageProc::ImageProc_Registration registration;
+    if( error2 = registration.setReference(reference) ) return log.error("Error setting reference", error2);
+
+    // 4. Register the images
+    log.printf("4. Register the images");
+    std::vector<cv::Point2f> shifts;
+    std::vector<float> responses;
+    if( error2 = registration.registerFrames(frames, shifts, responses) ) return log.error("Error registering images", error2);
+    for(size_t II = 0; II < shifts.size(); II++){
+        log.printf("%s: shift = (%f;%f) response = %f", argv[II+2], shifts[II].x, shifts[II].y, responses[II]);
+    }
+
+    return log.success();
+}
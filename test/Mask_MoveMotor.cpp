@@ -22,7 +22,7 @@ int main(int argc, char* argv[]){
     // 1. Parsing data
     log.printf("1. Parsing inputs");
     if(argc < 4) return log.error("No steps and speed specified",-1);
-    else if(argc > 4) log.printf("WARNING: Extra inputs discarded");
+    else if(argc > 4) log.warning("Extra inputs discarded");
 
     Mask_Error error;
 
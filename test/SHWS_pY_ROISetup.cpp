@@ -24,7 +24,7 @@ int main(int argc, char* argv[]){
     // 1. Parsing data
     log.printf("1. Parsing inputs");
     if(argc < 5) return log.error("No offsetX (px), offsetY (px), width(px) and height (px) specified",-1);
-    else if(argc > 5) log.printf("WARNING: Extra inputs discarded");
+    else if(argc > 5) log.warning("Extra inputs discarded");
 
     SHWSCamera_Error error;
 
@@ -18,7 +18,7 @@ int main(int argc, char* argv[]){
     // 1. Parsing data
     log.printf("1. Parsing inputs");
     if(argc < 2) return log.error("No exposure (us) specified",-1);
-    else if(argc > 2) log.printf("WARNING: Extra inputs discarded");
+    else if(argc > 2) log.warning("Extra inputs discarded");
 
     ImagingCamera_Error error;
 
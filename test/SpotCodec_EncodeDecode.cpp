@@ -0,0 +1,54 @@
+/***************************************************************************//**
+ * @file	SpotCodec_EncodeDecode.cpp
+ * @brief	Test file to compress a spot image without loss and decompress it
+ *
+ * @author	Thibaud Talon
+ * @date	18/10/2026
+ *
+ * @param [in] filename
+ *	Input image file (8-bit or 16-bit, converted to grayscale)
+ *******************************************************************************/
+
+#include <time.h>
+#include <opencv2/imgproc/imgproc.hpp>
+#include "UserInterface.hpp"
+#include "SpotCodec.hpp"
+
+int main(int argc, char* argv[]){
+    UserInterface::Log log("Algorithm");
+
+    // 1. Parsing data
+    log.printf("1. Parsing data");
+    if(argc < 2) return log.error("No filename specified",-1);
+    else if(argc > 2) log.warning("Extra inputs discarded");
+
+    SpotCodec::SpotCodec_Error error;
+
+    // 2. Load image
+    log.printf("2. Load image");
+    cv::Mat img = cv::imread(argv[1], CV_LOAD_IMAGE_ANYDEPTH | CV_LOAD_IMAGE_GRAYSCALE);
+    if( img.empty() ) return log.error("Error loading image", UserInterface::ERR_LOADIMG_LOAD);
+    log.printf("width = %i, height = %i, depth = %i bits", img.cols, img.rows, (int)img.elemSize()*8);
+
+    // 3. Encode
+    log.printf("3. Encode");
+    struct timespec t0, t1, t2;
+    std::vector<uchar> data;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    if( error = SpotCodec::encode(img, data) ) return log.error("Error encoding image", error);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+
+    // 4. Decode
+    log.printf("4. Decode");
+    cv::Mat decoded;
+    if( error = SpotCodec::decode(&data[0], data.size(), decoded) ) return log.error("Error decoding image", error);
+    clock_gettime(CLOCK_MONOTONIC, &t2);
+
+    // 5. Display the results
+    log.printf("5. Display the results");
+    if( cv::norm(img, decoded, cv::NORM_INF) > 0 ) return log.error("Images differ", -1);
+    log.printf("%i bytes -> %i bytes (ratio %f)", (int)(img.total()*img.elemSize()), (int)data.size(), (double)img.total()*img.elemSize()/data.size());
+    log.printf("Encoded in %f ms, decoded in %f ms", (t1.tv_sec - t0.tv_sec)*1e3 + (t1.tv_nsec - t0.tv_nsec)*1e-6, (t2.tv_sec - t1.tv_sec)*1e3 + (t2.tv_nsec - t1.tv_nsec)*1e-6);
+
+    return log.success();
+}
@@ -21,7 +21,7 @@ int main(int argc, char* argv[]){
     // 1. Parsing data
     log.printf("1. Parsing data");
     if(argc < 4) return log.error("No filenames (input CSV, output float CSV, output int CSV) specified",-1);
-    else if(argc > 4) log.printf("WARNING: Extra inputs discarded");
+    else if(argc > 4) log.warning("Extra inputs discarded");
 
     UserInterface::UserInterface_Error error;
 
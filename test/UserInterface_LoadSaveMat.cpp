@@ -0,0 +1,46 @@
+/***************************************************************************//**
+ * @file	UserInterface_LoadSaveMat.cpp
+ * @brief	Test file to convert a CSV file to a binary matrix file and load it back
+ *
+ * @author	Thibaud Talon
+ * @date	18/10/2026
+ *
+ * @param [in] filename
+ *	Input CSV file
+ * @param [in] filename
+ *	Output binary matrix file
+ *******************************************************************************/
+
+#include "UserInterface.hpp"
+
+int main(int argc, char* argv[]){
+    UserInterface::Log log("Algorithm");
+
+    // 1. Parsing data
+    log.printf("1. Parsing data");
+    if(argc < 3) return log.error("No filenames (input CSV, output binary matrix) specified",-1);
+    else if(argc > 3) log.warning("Extra inputs discarded");
+
+    UserInterface::UserInterface_Error error;
+
+    // 2. Load matrix from CSV
+    log.printf("2. Load matrix from CSV");
+    cv::Mat_<float> mat;
+    if( error = UserInterface::loadMatFromCSV(argv[1], mat) ) return log.error("Error loading matrix", error);
+
+    // 3. Save matrix as binary
+    log.printf("3. Save matrix as binary");
+    if( error = UserInterface::saveMat(mat, argv[2]) ) return log.error("Error saving matrix", error);
+
+    // 4. Load matrix from binary
+    log.printf("4. Load matrix from binary");
+    cv::Mat_<float> loaded;
+    if( error = UserInterface::loadMat(argv[2], loaded) ) return log.error("Error loading matrix", error);
+    log.printMat("Matrix:", loaded);
+
+    // 5. Compare
+    log.printf("5. Compare");
+    if( loaded.size() != mat.size() || cv::norm(loaded, mat, cv::NORM_INF) > 0 ) return log.error("Matrices differ", -1);
+
+    return log.success();
+}
@@ -0,0 +1,58 @@
+/***************************************************************************//**
+ * @file	Zernike_Decompose.cpp
+ * @brief	Test file to decompose a synthetic wavefront on the Zernike polynomials
+ *
+ * @author	Thibaud Talon
+ * @date	18/10/2026
+ *
+ * @param [in] size
+ *	Number of pixels across the pupil grid
+ * @param [in] order
+ *	Largest radial order
+ * @param [in] j
+ *	Noll index of the mode in the wavefront
+ *******************************************************************************/
+
+#include "UserInterface.hpp"
+#include "Zernike.hpp"
+
+int main(int argc, char* argv[]){
+    UserInterface::Log log("Algorithm");
+
+    // 1. Parsing data
+    log.printf("1. Parsing data");
+    if(argc < 4) return log.error("No size, order, Noll index specified",-1);
+    else if(argc > 4) log.warning("Extra inputs discarded");
+
+    Zernike::Zernike_Error error;
+    int j = atoi(argv[3]);
+
+    // 2. Build the basis
+    log.printf("2. Build the basis");
+    Zernike::Zernike_Basis basis;
+    error = basis.buildPupil(atoi(argv[1]), atoi(argv[2]));
+    if( error ) return log.error("Error building the basis", error);
+    if( j < 1 || j > basis.size() ) return log.error("Noll index out-of-bounds", -1);
+
+    // 3. Synthetic wavefront (unit amplitude on mode j)
+    log.printf("3. Synthetic wavefront");
+    cv::Mat_<float> coefficients = cv::Mat_<float>::zeros(basis.size(), 1), wavefront;
+    coefficients(j-1) = 1;
+    error = basis.reconstruct(coefficients, wavefront);
+    if( error ) return log.error("Error reconstructing the wavefront", error);
+
+    // 4. Decompose it
+    log.printf("4. Decompose the wavefront");
+    error = basis.decompose(wavefront, coefficients);
+    if( error ) return log.error("Error decomposing the wavefront", error);
+
+    // 5. Display the results
+    log.printf("5. Display the results");
+    for(int II = 0; II < basis.size(); II++){
+        int n, m;
+        Zernike::nollToNM(II+1, n, m);
+        log.printf("Z%i (n = %i, m = %i): %f", II+1, n, m, coefficients(II));
+    }
+
+    return log.success();
+}